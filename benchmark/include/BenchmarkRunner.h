@@ -0,0 +1,51 @@
+/*
+* BenchmarkRunner is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  BenchmarkRunner class. Times small pieces of work, prints ns/op and throughput and exports
+*  the results as JSON so runs from different commits and math paths can be compared.
+*/
+
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t    operations; //Operations timed in the fastest repetition
+    double      nsPerOp;    //Fastest repetition
+    double      opsPerSecond;
+    double      bytesPerSecond; //0 when the benchmark does not stream data
+};
+
+class BenchmarkRunner {
+    std::vector<BenchmarkResult> _results;
+    std::string                  _filter; //Only benchmarks whose name contains this run
+    double                       _minSeconds; //Time spent on each benchmark
+    int                          _repetitions; //Best of this many timed runs is reported
+    uint64_t                     _calibrate(std::function<void(uint64_t)>& work);
+public:
+    BenchmarkRunner(const std::string& filter, double minSeconds, int repetitions = 5);
+    //work(count) must perform count iterations of opsPerIteration operations each, bytesPerOp
+    //is the memory streamed per operation for throughput in bytes
+    void run(const std::string& name, uint64_t opsPerIteration, uint64_t bytesPerOp,
+             std::function<void(uint64_t)> work);
+    bool writeJson(const std::string& file, const std::string& mathPath);
+    std::vector<BenchmarkResult>& getResults();
+};
\ No newline at end of file
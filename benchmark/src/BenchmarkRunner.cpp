@@ -0,0 +1,93 @@
+#include "BenchmarkRunner.h"
+#include <chrono>
+#include <cstdio>
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+//Time a single calibration run should take before its iteration count is trusted
+const double CALIBRATION_SECONDS = 0.01;
+
+static double _secondsFor(std::function<void(uint64_t)>& work, uint64_t iterations) {
+    auto start = BenchmarkClock::now();
+    work(iterations);
+    return std::chrono::duration<double>(BenchmarkClock::now() - start).count();
+}
+
+BenchmarkRunner::BenchmarkRunner(const std::string& filter, double minSeconds, int repetitions) :
+    _filter(filter),
+    _minSeconds(minSeconds),
+    _repetitions(repetitions) {
+}
+
+uint64_t BenchmarkRunner::_calibrate(std::function<void(uint64_t)>& work) {
+    //Double the iteration count until a run is long enough for the clock to resolve it
+    uint64_t iterations = 1;
+    double seconds = _secondsFor(work, iterations);
+    while (seconds < CALIBRATION_SECONDS && iterations < (1ull << 40)) {
+        iterations *= 2;
+        seconds = _secondsFor(work, iterations);
+    }
+    //Size each repetition so all of them together take about the minimum time
+    double perIteration = seconds / static_cast<double>(iterations);
+    double target = _minSeconds / static_cast<double>(_repetitions);
+    uint64_t sized = static_cast<uint64_t>(target / perIteration);
+    return sized > iterations ? sized : iterations;
+}
+
+void BenchmarkRunner::run(const std::string& name, uint64_t opsPerIteration, uint64_t bytesPerOp,
+                          std::function<void(uint64_t)> work) {
+
+    if (!_filter.empty() && name.find(_filter) == std::string::npos) {
+        return;
+    }
+
+    uint64_t iterations = _calibrate(work);
+    double best = 0.0;
+    for (int i = 0; i < _repetitions; i++) {
+        double seconds = _secondsFor(work, iterations);
+        if (i == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.operations = iterations * opsPerIteration;
+    result.nsPerOp = best * 1.0e9 / static_cast<double>(result.operations);
+    result.opsPerSecond = static_cast<double>(result.operations) / best;
+    result.bytesPerSecond = result.opsPerSecond * static_cast<double>(bytesPerOp);
+    _results.push_back(result);
+
+    if (bytesPerOp > 0) {
+        printf("%-40s %12.3f ns/op %14.0f ops/s %10.1f MB/s\n", name.c_str(), result.nsPerOp,
+               result.opsPerSecond, result.bytesPerSecond / 1.0e6);
+    }
+    else {
+        printf("%-40s %12.3f ns/op %14.0f ops/s\n", name.c_str(), result.nsPerOp, result.opsPerSecond);
+    }
+}
+
+bool BenchmarkRunner::writeJson(const std::string& file, const std::string& mathPath) {
+
+    FILE* output = fopen(file.c_str(), "w");
+    if (output == nullptr) {
+        printf("Could not open %s for writing\n", file.c_str());
+        return false;
+    }
+
+    fprintf(output, "{\n  \"mathPath\": \"%s\",\n  \"benchmarks\": [\n", mathPath.c_str());
+    for (size_t i = 0; i < _results.size(); i++) {
+        BenchmarkResult& result = _results[i];
+        fprintf(output, "    {\"name\": \"%s\", \"operations\": %llu, \"nsPerOp\": %.6f, "
+                        "\"opsPerSecond\": %.3f, \"bytesPerSecond\": %.3f}%s\n",
+                result.name.c_str(), static_cast<unsigned long long>(result.operations), result.nsPerOp,
+                result.opsPerSecond, result.bytesPerSecond, i + 1 < _results.size() ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+    fclose(output);
+    return true;
+}
+
+std::vector<BenchmarkResult>& BenchmarkRunner::getResults() {
+    return _results;
+}
@@ -0,0 +1,326 @@
+#include "BenchmarkRunner.h"
+#include "Matrix.h"
+#include "BatchMath.h"
+#include "Quaternion.h"
+#include "GeometryMath.h"
+#include "Frustum.h"
+#include "OcclusionBuffer.h"
+#include "Noise.h"
+#include <algorithm>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//Inputs are drawn from pools this size so the compiler cannot fold the work into constants
+const size_t BENCHMARK_POOL_SIZE = 1024;
+const size_t BENCHMARK_POOL_MASK = BENCHMARK_POOL_SIZE - 1;
+//Array length used by the BatchMath benchmarks
+const size_t BENCHMARK_BATCH_SIZE = 4096;
+
+//Results are folded into this so none of the timed work is optimized away
+static volatile float benchmarkSink;
+
+static const char* _mathPath() {
+#if defined(MATH_SSE)
+    return "sse";
+#elif defined(MATH_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+static void _printUsage() {
+    printf("MathBenchmark [--filter name] [--time seconds] [--json file]\n");
+    printf("  --filter  only run benchmarks whose name contains this text\n");
+    printf("  --time    seconds spent on each benchmark, default 0.5\n");
+    printf("  --json    write the results to this file\n");
+}
+
+int main(int argc, char** argv) {
+
+    std::string filter;
+    std::string jsonFile;
+    double minSeconds = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            minSeconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonFile = argv[++i];
+        }
+        else {
+            _printUsage();
+            return 1;
+        }
+    }
+
+    printf("Math path: %s\n", _mathPath());
+
+    std::mt19937 generator(0x5eed);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<Matrix>     generalMatrices(BENCHMARK_POOL_SIZE);
+    std::vector<Matrix>     rigidMatrices(BENCHMARK_POOL_SIZE);
+    std::vector<Matrix>     affineMatrices(BENCHMARK_POOL_SIZE);
+    std::vector<Vector4>    vectors(BENCHMARK_POOL_SIZE);
+    std::vector<Quaternion> quaternions(BENCHMARK_POOL_SIZE);
+    std::vector<Sphere>     spheres;
+    std::vector<Triangle>   triangles;
+    std::vector<Cube>       cubes;
+
+    for (size_t i = 0; i < BENCHMARK_POOL_SIZE; i++) {
+        Matrix rotation = Matrix::rotationAroundX(angle(generator)) *
+                          Matrix::rotationAroundY(angle(generator)) *
+                          Matrix::rotationAroundZ(angle(generator));
+        Matrix translation = Matrix::translation(position(generator), position(generator), position(generator));
+        rigidMatrices[i] = translation * rotation;
+        affineMatrices[i] = rigidMatrices[i] * Matrix::scale(1.0f + unit(generator), 1.0f + unit(generator), 1.0f);
+        generalMatrices[i] = Matrix(affineMatrices[i].getFlatBuffer());
+        vectors[i] = Vector4(position(generator), position(generator), position(generator), 1.0f);
+        quaternions[i] = Quaternion(rotation);
+
+        Vector4 center(position(generator), position(generator), position(generator), 1.0f);
+        spheres.push_back(Sphere(1.0f + 10.0f * unit(generator), center));
+        triangles.push_back(Triangle(center + Vector4(position(generator), 0.0f, 0.0f),
+                                     center + Vector4(0.0f, position(generator), 0.0f),
+                                     center + Vector4(0.0f, 0.0f, position(generator))));
+        float dimension = 1.0f + 50.0f * unit(generator);
+        cubes.push_back(Cube(dimension, dimension, dimension, center + Vector4(position(generator) * 0.1f, 0.0f, 0.0f)));
+    }
+
+    std::vector<Vector4> batchIn(BENCHMARK_BATCH_SIZE);
+    std::vector<Vector4> batchOut(BENCHMARK_BATCH_SIZE);
+    std::vector<Matrix>  batchMatricesOut(BENCHMARK_BATCH_SIZE);
+    std::vector<Matrix>  batchMatricesIn(BENCHMARK_BATCH_SIZE);
+    for (size_t i = 0; i < BENCHMARK_BATCH_SIZE; i++) {
+        batchIn[i] = vectors[i & BENCHMARK_POOL_MASK];
+        batchMatricesIn[i] = generalMatrices[i & BENCHMARK_POOL_MASK];
+    }
+
+    //Camera sits at the origin so roughly an eighth of the pool lands inside the frustum
+    Frustum frustum(Matrix::cameraProjection(45.0f, 1.78f, 0.1f, 200.0f) * Matrix::cameraRotationAroundY(30.0f));
+    std::vector<float>    cullRadii(BENCHMARK_BATCH_SIZE);
+    std::vector<Vector4>  cullExtents(BENCHMARK_BATCH_SIZE);
+    std::vector<uint32_t> cullMasks(Frustum::maskWords(BENCHMARK_BATCH_SIZE));
+    for (size_t i = 0; i < BENCHMARK_BATCH_SIZE; i++) {
+        cullRadii[i] = 1.0f + 10.0f * unit(generator);
+        cullExtents[i] = Vector4(cullRadii[i], cullRadii[i] * unit(generator), cullRadii[i], 0.0f);
+    }
+
+    //Rolling ground in front of the same camera, about as dense as the island terrain
+    Matrix occlusionProjection = Matrix::cameraProjection(45.0f, 1.78f, 0.1f, 200.0f);
+    Matrix occlusionView = Matrix::translation(0.0f, -2.0f, 0.0f);
+    std::vector<Vector4> groundVertices;
+    std::vector<int>     groundIndices;
+    const int groundStride = 100;
+    for (int z = 0; z < groundStride; z++) {
+        for (int x = 0; x < groundStride; x++) {
+            float height = kNoise.turbulence(static_cast<float>(x) * 4.0f, static_cast<float>(z) * 4.0f, 6);
+            groundVertices.push_back(Vector4(static_cast<float>(x - groundStride / 2) * 0.5f, height,
+                                             -static_cast<float>(z) * 0.5f, 1.0f));
+        }
+    }
+    for (int z = 0; z + 1 < groundStride; z++) {
+        for (int x = 0; x + 1 < groundStride; x++) {
+            int corner = z * groundStride + x;
+            int quad[6] = { corner, corner + 1, corner + groundStride,
+                            corner + 1, corner + groundStride + 1, corner + groundStride };
+            groundIndices.insert(groundIndices.end(), quad, quad + 6);
+        }
+    }
+    OcclusionBuffer occlusionBuffer;
+    occlusionBuffer.clear(occlusionProjection, occlusionView);
+    occlusionBuffer.rasterize(Matrix(), groundVertices, groundIndices);
+    std::vector<Matrix> occludees(BENCHMARK_BATCH_SIZE);
+    for (size_t i = 0; i < BENCHMARK_BATCH_SIZE; i++) {
+        occludees[i] = Matrix::translation(position(generator) * 0.25f, -unit(generator), -50.0f * unit(generator)) *
+                       Matrix::scale(0.1f + unit(generator));
+    }
+
+    BenchmarkRunner runner(filter, minSeconds);
+
+    //Matrix
+    runner.run("matrix/multiply", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            Matrix product = generalMatrices[i & BENCHMARK_POOL_MASK] * generalMatrices[(i + 1) & BENCHMARK_POOL_MASK];
+            benchmarkSink = product.getFlatBuffer()[5];
+        }
+    });
+    runner.run("matrix/multiplyVector", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            Vector4 product = generalMatrices[i & BENCHMARK_POOL_MASK] * vectors[(i + 1) & BENCHMARK_POOL_MASK];
+            benchmarkSink = product.getx();
+        }
+    });
+    runner.run("matrix/transpose", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = generalMatrices[i & BENCHMARK_POOL_MASK].transpose().getFlatBuffer()[1];
+        }
+    });
+    runner.run("matrix/inverseGeneral", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = generalMatrices[i & BENCHMARK_POOL_MASK].inverse().getFlatBuffer()[3];
+        }
+    });
+    runner.run("matrix/inverseAffine", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = affineMatrices[i & BENCHMARK_POOL_MASK].inverse().getFlatBuffer()[3];
+        }
+    });
+    runner.run("matrix/inverseRigid", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = rigidMatrices[i & BENCHMARK_POOL_MASK].inverse().getFlatBuffer()[3];
+        }
+    });
+    runner.run("matrix/normalMatrix", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = rigidMatrices[i & BENCHMARK_POOL_MASK].normalMatrix().getFlatBuffer()[12];
+        }
+    });
+
+    //BatchMath, one operation is one element of the array
+    runner.run("batch/transformPoints", BENCHMARK_BATCH_SIZE, 2 * sizeof(Vector4), [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            BatchMath::transformPoints(rigidMatrices[i & BENCHMARK_POOL_MASK], batchIn.data(), batchOut.data(), BENCHMARK_BATCH_SIZE);
+            benchmarkSink = batchOut[i & BENCHMARK_POOL_MASK].getx();
+        }
+    });
+    runner.run("batch/multiply", BENCHMARK_BATCH_SIZE, 2 * sizeof(Matrix), [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            BatchMath::multiply(rigidMatrices[i & BENCHMARK_POOL_MASK], batchMatricesIn.data(), batchMatricesOut.data(), BENCHMARK_BATCH_SIZE);
+            benchmarkSink = batchMatricesOut[i & BENCHMARK_POOL_MASK].getFlatBuffer()[0];
+        }
+    });
+
+    //Vector4
+    runner.run("vector/dotProduct", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = vectors[i & BENCHMARK_POOL_MASK].dotProduct(vectors[(i + 1) & BENCHMARK_POOL_MASK]);
+        }
+    });
+    runner.run("vector/crossProduct", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = vectors[i & BENCHMARK_POOL_MASK].crossProduct(vectors[(i + 1) & BENCHMARK_POOL_MASK]).getx();
+        }
+    });
+    runner.run("vector/normalize", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            Vector4 vector = vectors[i & BENCHMARK_POOL_MASK];
+            vector.normalize();
+            benchmarkSink = vector.getx();
+        }
+    });
+    runner.run("vector/add", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = (vectors[i & BENCHMARK_POOL_MASK] + vectors[(i + 1) & BENCHMARK_POOL_MASK]).getx();
+        }
+    });
+
+    //Quaternion
+    runner.run("quaternion/slerp", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = Quaternion::slerp(quaternions[i & BENCHMARK_POOL_MASK],
+                                              quaternions[(i + 1) & BENCHMARK_POOL_MASK], 0.3f).getw();
+        }
+    });
+    runner.run("quaternion/nlerp", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = Quaternion::nlerp(quaternions[i & BENCHMARK_POOL_MASK],
+                                              quaternions[(i + 1) & BENCHMARK_POOL_MASK], 0.3f).getw();
+        }
+    });
+
+    //GeometryMath
+    runner.run("geometry/sphereTriangle", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = GeometryMath::sphereTriangleDetection(spheres[i & BENCHMARK_POOL_MASK],
+                                                                  triangles[(i + 1) & BENCHMARK_POOL_MASK]) ? 1.0f : 0.0f;
+        }
+    });
+    runner.run("geometry/triangleCube", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = GeometryMath::triangleCubeDetection(&triangles[i & BENCHMARK_POOL_MASK],
+                                                                &cubes[(i + 1) & BENCHMARK_POOL_MASK]) ? 1.0f : 0.0f;
+        }
+    });
+    runner.run("geometry/sphereCube", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = GeometryMath::sphereCubeDetection(&spheres[i & BENCHMARK_POOL_MASK],
+                                                              &cubes[(i + 1) & BENCHMARK_POOL_MASK]) ? 1.0f : 0.0f;
+        }
+    });
+    runner.run("geometry/sphereSphere", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = GeometryMath::sphereSphereDetection(spheres[i & BENCHMARK_POOL_MASK],
+                                                                spheres[(i + 1) & BENCHMARK_POOL_MASK]) ? 1.0f : 0.0f;
+        }
+    });
+
+    //Frustum
+    runner.run("frustum/spheres", BENCHMARK_BATCH_SIZE, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            frustum.testSpheres(batchIn.data(), cullRadii.data(), BENCHMARK_BATCH_SIZE, cullMasks.data());
+            benchmarkSink = static_cast<float>(cullMasks[i & (cullMasks.size() - 1)]);
+        }
+    });
+    runner.run("frustum/aabbs", BENCHMARK_BATCH_SIZE, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            frustum.testAABBs(batchIn.data(), cullExtents.data(), BENCHMARK_BATCH_SIZE, cullMasks.data());
+            benchmarkSink = static_cast<float>(cullMasks[i & (cullMasks.size() - 1)]);
+        }
+    });
+    runner.run("frustum/obbs", BENCHMARK_BATCH_SIZE, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            frustum.testOBBs(batchMatricesIn.data(), BENCHMARK_BATCH_SIZE, cullMasks.data());
+            benchmarkSink = static_cast<float>(cullMasks[i & (cullMasks.size() - 1)]);
+        }
+    });
+    runner.run("frustum/sphereSingle", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            benchmarkSink = frustum.sphereVisible(vectors[i & BENCHMARK_POOL_MASK], cullRadii[i & BENCHMARK_POOL_MASK]) ? 1.0f : 0.0f;
+        }
+    });
+
+    //OcclusionBuffer
+    runner.run("occlusion/rasterize", groundIndices.size() / 3, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            occlusionBuffer.clear(occlusionProjection, occlusionView);
+            occlusionBuffer.rasterize(Matrix(), groundVertices, groundIndices);
+            benchmarkSink = occlusionBuffer.getDepth()[i % (OCCLUSION_WIDTH * OCCLUSION_HEIGHT)];
+        }
+    });
+    runner.run("occlusion/obbs", BENCHMARK_BATCH_SIZE, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            std::fill(cullMasks.begin(), cullMasks.end(), 0xFFFFFFFFu);
+            occlusionBuffer.testOBBs(occludees.data(), BENCHMARK_BATCH_SIZE, cullMasks.data());
+            benchmarkSink = static_cast<float>(cullMasks[i & (cullMasks.size() - 1)]);
+        }
+    });
+
+    //ValueNoise2D
+    runner.run("noise/noise", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            Vector4& sample = vectors[i & BENCHMARK_POOL_MASK];
+            benchmarkSink = kNoise.noise(sample.getx() + 100.0f, sample.gety() + 100.0f);
+        }
+    });
+    runner.run("noise/turbulence", 1, 0, [&](uint64_t count) {
+        for (uint64_t i = 0; i < count; i++) {
+            Vector4& sample = vectors[i & BENCHMARK_POOL_MASK];
+            benchmarkSink = kNoise.turbulence(sample.getx() + 100.0f, sample.gety() + 100.0f, 6);
+        }
+    });
+
+    if (!jsonFile.empty() && !runner.writeJson(jsonFile, _mathPath())) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*
+* BatchMath is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  static BatchMath class. Array level versions of the Matrix and Vector4 transforms.  The matrix
+*  is loaded once for the whole array, large outputs are written with streaming stores and
+*  arrays past BATCH_THREAD_COUNT elements are split across worker threads.  Results match
+*  the per element Matrix operators bit for bit.
+*/
+
+#pragma once
+#include "Matrix.h"
+#include <vector>
+
+const size_t BATCH_THREAD_COUNT = 65536; //Element count where splitting the work across threads pays off
+const size_t BATCH_STREAM_COUNT = 16384; //Element count where outputs bypass the cache with streaming stores
+
+class BatchMath {
+
+public:
+    //Vector transforms, out[i] = matrix * in[i].  in and out may be the same array.
+    static void transform(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count); //Uses each vector's w
+    static void transformPoints(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count); //Treats w as 1
+    static void transformDirections(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count); //Treats w as 0
+    static void transform(const Matrix& matrix, std::vector<Vector4>& in, std::vector<Vector4>& out);
+    static void transformPoints(const Matrix& matrix, std::vector<Vector4>& in, std::vector<Vector4>& out);
+    static void transformDirections(const Matrix& matrix, std::vector<Vector4>& in, std::vector<Vector4>& out);
+
+    //Matrix products
+    static void multiply(const Matrix* a, const Matrix* b, Matrix* out, size_t count); //out[i] = a[i] * b[i]
+    static void multiply(const Matrix& a, const Matrix* b, Matrix* out, size_t count); //out[i] = a * b[i]
+    static void multiply(const Matrix* a, const Matrix& b, Matrix* out, size_t count); //out[i] = a[i] * b
+};
\ No newline at end of file
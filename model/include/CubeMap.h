@@ -29,6 +29,9 @@ class CubeMap {
 protected:
     unsigned int _cubemap; //Cube texture reference
     unsigned int _cubeFrameBuffer; //Cube frame buffer used for render to cube texture
+    unsigned int _faceFrameBuffers[6]; //One frame buffer per face so faces can be drawn on their own
+    bool         _isDepth; //Depth or color cube texture
+    void         _allocateFaces(); //Specifies the six face images at the current size
     //Width and height are used to change viewport when rendering
     unsigned int _width; //Width of texture 
     unsigned int _height; //Height of texture
@@ -40,5 +43,7 @@ public:
     unsigned int getHeight();
     unsigned int getCubeFrameBufferContext();
     unsigned int getCubeMapContext();
+    unsigned int getFaceFrameBufferContext(int face);
+    void         resize(unsigned int width, unsigned int height); //Reallocates every face, contents are lost
 };
 
@@ -34,11 +34,15 @@ protected:
     CubeMap _cubeTextureMap; //Contains 6 size for point light shadow rendering
     bool    _isDepth; //Depth or color buffer cube map renderer
     std::vector<Matrix> _transforms;
+    std::vector<Frustum> _faceFrustums; //One frustum per cube face built from _transforms
 public:
     CubeMapRenderer(GLuint width, GLuint height, bool isDepth);
     ~CubeMapRenderer();
 
     void preCubeFaceRender(std::vector<Model*> modelList, MVP* mvp);
+    void buildFaceTransforms(MVP* mvp); //Face transforms and frustums without touching the frame buffer
+    void bindCubeFace(int face); //Binds and clears a single face for rendering
     void postCubeFaceRender();
     GLuint getCubeMapTexture();
+    int getFaceMask(Model* model); //Bit i is set when the model is inside cube face i
 };
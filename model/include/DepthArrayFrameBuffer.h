@@ -0,0 +1,44 @@
+/*
+* DepthArrayFrameBuffer is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  DepthArrayFrameBuffer class. Depth only 2d array texture with one frame buffer per layer
+   so each layer can be rendered on its own and all of them sampled through one sampler
+*/
+
+#pragma once
+#include "GLIncludes.h"
+#include <iostream>
+#include <vector>
+
+class DepthArrayFrameBuffer {
+
+    std::vector<GLuint> _frameBufferContexts; //One frame buffer per layer
+    GLuint              _fbTextureContext;
+    GLuint              _width;
+    GLuint              _height;
+    GLuint              _layers;
+
+public:
+    DepthArrayFrameBuffer(unsigned int width, unsigned int height, unsigned int layers);
+    ~DepthArrayFrameBuffer();
+    GLuint getFrameBufferContext(unsigned int layer);
+    GLuint getTextureContext();
+    GLuint getWidth();
+    GLuint getHeight();
+    GLuint getLayers();
+};
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*
+* DrawList is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  DrawList class. Collects the draws of a pass, orders them with a radix sort on 64 bit keys and
+*  submits every run of draws sharing program, vao and material with one multi draw indirect call.
+*  Key bits from the top are pass, shader, material, vao and depth so state changes are grouped
+*  first and draws sharing all state go front to back.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include <vector>
+#include <cstdint>
+
+class Model;
+class StaticShader;
+class Material;
+
+enum class DrawPass {
+    Opaque = 0,
+    Transparent
+};
+
+struct DrawCommand {
+    StaticShader*   shader; //Shader that binds the program, per model uniforms and material
+    Model*          model; //Model supplying the per model uniforms
+    GLuint          vao; //Vertex array the indices index into
+    const Material* material; //Textures and uniforms the draw needs, shared by draws with the same textures
+    GLuint          first; //First index of the draw in the vao's index buffer
+    GLint           baseVertex; //Added to every index, start of the model's vertices in the shared buffers
+    GLsizei         count; //Number of indices
+};
+
+class DrawList {
+
+    struct SortEntry {
+        uint64_t key;
+        uint32_t command;
+    };
+
+    std::vector<DrawCommand> _commands; //Commands in the order they were added
+    std::vector<SortEntry>   _entries; //Keys with the command they belong to, sorted by submit
+    std::vector<SortEntry>   _scratch; //Ping pong buffer for the radix passes
+
+public:
+    DrawList();
+    ~DrawList();
+    static uint64_t makeKey(DrawPass pass, GLuint shader, uint32_t material, GLuint vao, float depth);
+    void            add(uint64_t key, const DrawCommand& command);
+    void            append(const DrawList& drawList); //Adds every draw of another list, used to merge per thread lists
+    void            sort(); //Least significant byte first radix sort, passes where every key shares the byte are skipped
+    void            submit(); //Sorts, issues every draw and clears the list
+    void            clear();
+    size_t          size();
+    const DrawCommand& getCommand(size_t sortedIndex); //Command at a position of the sorted order
+};
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*
+* DrawRecorder is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  DrawRecorder class. Keeps a pool of recording threads that cull models and queue their draws
+*  into one DrawList per thread without touching GL.  The GL thread records alongside the
+*  workers and then gathers every list into the one it sorts and submits.
+*/
+#pragma once
+#include "DrawList.h"
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+class World;
+
+const size_t RECORD_BATCH_SIZE = 16; //Indices a thread takes at a time, small enough to even out costly models
+
+class DrawRecorder {
+
+    using RecordWork = std::function<void(size_t, DrawList*)>;
+
+    std::vector<std::thread> _workers; //Recording threads, they sleep between frames
+    std::vector<DrawList>    _lists; //One list per worker, the last one belongs to the calling thread
+    std::mutex               _lock; //Guards the job state below
+    std::condition_variable  _start; //Wakes the workers when a job is posted
+    std::condition_variable  _done; //Wakes the calling thread when the last worker finishes
+    RecordWork               _work; //Records the draws of one index into the given list
+    World*                   _world; //World current on the thread that posted the job, the workers make it theirs
+    size_t                   _count; //Number of indices in the current job
+    std::atomic<size_t>      _next; //Next index nobody has taken yet
+    size_t                   _busy; //Workers still recording the current job
+    uint64_t                 _generation; //Bumped for every job so workers know a new one is posted
+    bool                     _quit;
+    void                     _workerLoop(size_t worker);
+    void                     _recordBatches(DrawList* drawList); //Takes batches until the job runs out
+public:
+    DrawRecorder(unsigned int threadCount = 0); //0 uses one less than the hardware threads
+    ~DrawRecorder();
+    void   record(size_t count, RecordWork work); //Runs work for [0, count) across the pool and waits
+    void   gather(DrawList* drawList); //Moves every thread's draws into drawList
+    size_t getThreadCount(); //Workers plus the calling thread
+};
\ No newline at end of file
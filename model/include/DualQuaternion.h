@@ -0,0 +1,51 @@
+/*
+* DualQuaternion is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  DualQuaternion class. Rigid transform stored as a real rotation quaternion and a dual part
+*  holding half the translation times the rotation.  Blends rotation and translation together
+*  without the shrinking that comes from blending matrices, which is what skinning needs.
+*/
+
+#pragma once
+#include "Quaternion.h"
+
+class DualQuaternion {
+    Quaternion _real; //Rotation
+    Quaternion _dual; //Half the translation quaternion times the rotation
+public:
+    DualQuaternion(); //Identity transform
+    DualQuaternion(const Quaternion& real, const Quaternion& dual);
+    DualQuaternion(const Quaternion& rotation, const Vector4& translation); //Rotates then translates
+    DualQuaternion(const Matrix& rigid); //Matrix must only rotate and translate
+
+    Quaternion&     getReal();
+    Quaternion&     getDual();
+    Quaternion      getRotation() const;
+    Vector4         getTranslation() const;
+
+    DualQuaternion  operator * (const DualQuaternion& other) const; //Composition, a * b applies b then a
+    DualQuaternion  operator * (float scale) const;
+    DualQuaternion  operator + (const DualQuaternion& other) const;
+    void            normalize();
+    DualQuaternion  conjugate() const; //Inverse of a unit dual quaternion
+    Vector4         transform(const Vector4& point) const; //Rotates and translates a point
+    Matrix          toMatrix() const; //Tagged as rigid
+
+    //Dual quaternion linear blend, takes the shortest path between the two rotations
+    static DualQuaternion nlerp(const DualQuaternion& a, const DualQuaternion& b, float t);
+};
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include <string>
 #include "GLIncludes.h"
 #include "FontShader.h"
+#include "StreamBuffer.h"
 
 const std::string FONT_LOCATION = "../assets/textures/font/";
 
@@ -83,6 +84,12 @@ struct FontInfo
     charInfo chars[256];
 };
 
+struct FontVertex
+{
+    float x, y, z; // Screen space position.
+    float u, v;    // Glyph texture coordinate.
+};
+
 void parseFontFile(std::string& filename, FontInfo& out);
 
 class FontRenderer
@@ -98,11 +105,10 @@ private:
     const int bufferSize = 65536;
     FontInfo fontInfo;
     FontShader fontShader;
+    StreamBuffer streamBuffer; // Glyph quads rebuilt every draw
 
     GLuint fontTex;
     GLuint vao;
-    GLuint texCoordsVbo;
-    GLuint vbo;
     GLuint shader;
 
 };
\ No newline at end of file
@@ -30,5 +30,6 @@ public:
     ForwardRenderer(); 
     ~ForwardRenderer();
     void forwardLighting(std::vector<Model*>& modelList, ViewManager* viewManager, ShadowRenderer* shadowRenderer,
-        std::vector<Light*>& lights, PointShadowMap* pointShadowMap);
+        std::vector<Light*>& lights, PointShadowMap* pointShadowMap,
+        const OcclusionBuffer* occlusionBuffer); //Instances hidden by the occlusion buffer's occluders are skipped, null culls against the frustum only
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+* Frustum is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  Frustum class. Six planes pulled out of a view projection matrix, normals point inward.
+*  Batched tests take four objects per iteration and write one visibility bit per object so
+*  callers can cull whole arrays at once.  Tests are conservative, an object is only culled
+*  when it is completely outside of one plane.
+*/
+
+#pragma once
+#include "Matrix.h"
+#include <cstdint>
+
+enum class FrustumPlane {
+    Left = 0,
+    Right,
+    Bottom,
+    Top,
+    Near,
+    Far
+};
+
+const int FRUSTUM_PLANES = 6;
+
+class Frustum {
+    MATH_ALIGN float _planes[FRUSTUM_PLANES][4]; //Normal x, y, z and distance of each plane
+    MATH_ALIGN float _planeSplats[FRUSTUM_PLANES][4][4]; //Each plane coefficient repeated across 4 lanes
+    void             _normalize();
+public:
+    Frustum(); //Clip space cube, everything between -1 and 1 is visible
+    Frustum(const Matrix& viewProjection); //Projection * view gives a world space frustum
+    const float* getPlane(FrustumPlane plane) const;
+
+    //Single object tests
+    bool sphereVisible(const Vector4& center, float radius) const;
+    bool aabbVisible(const Vector4& center, const Vector4& halfExtent) const;
+    bool obbVisible(const Matrix& transform) const; //transform maps the -1 to 1 cube onto the box
+
+    //Batched tests, bit i % 32 of visibleMasks[i / 32] is set when object i is visible
+    void testSpheres(const Vector4* centers, const float* radii, size_t count, uint32_t* visibleMasks) const;
+    void testAABBs(const Vector4* centers, const Vector4* halfExtents, size_t count, uint32_t* visibleMasks) const;
+    void testOBBs(const Matrix* transforms, size_t count, uint32_t* visibleMasks) const;
+
+    static size_t maskWords(size_t count); //Number of uint32_t masks needed for count objects
+};
\ No newline at end of file
@@ -0,0 +1,38 @@
+/*
+* GLStateCache is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+*  GLStateCache class. Drops gl state changes that would leave the state as it already is.  Renderers
+*  set their state defensively before every draw so most binds repeat what is bound already.  Like
+*  NullGL it sits in gl3w's function table so no call site changes, it keeps the entries it replaces
+*  and only forwards a call when the shadowed value differs.  Shadowed state is the program, vertex
+*  array, active texture unit and the texture bound to each unit and target, the draw and read
+*  framebuffers, the viewport, blend and depth functions and every enable such as blend, depth test
+*  and face culling.  Everything starts unknown so the first set of each always reaches the driver.
+*/
+#pragma once
+#include "GLIncludes.h"
+
+const bool GL_STATE_FILTERING = true; //false sends every state change to the driver
+
+class GLStateCache {
+public:
+    static void   install(); //Wraps the current gl3w entries, call after gl3wInit or NullGL::install
+    static size_t getFilteredCalls(); //Calls dropped since the last reset
+    static void   resetFilteredCalls();
+};
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+* GeometryArena is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  GeometryArena class. Shared vertex and index buffers that static models are suballocated from.
+*  Storage comes in blocks and each block has one vao per vertex format, a full one for shading and
+*  a position only one for shadows, so draws of different models only change state when they live
+*  in different blocks.  Blocks never move once created so vaos built on them stay valid, so the
+*  first block is small and each new one doubles in size rather than reserving the most up front.  The arena
+*  also owns the per frame indirect commands and per draw constants multi draws are issued from.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include "Vector3.h"
+#include "SnormNormal.h"
+#include "Tex2.h"
+#include "StreamBuffer.h"
+#include <vector>
+
+const size_t ARENA_FIRST_VERTICES   = 1 << 16; //Vertices the first block holds unless the first model needs more
+const size_t ARENA_FIRST_INDICES    = 1 << 17; //Indices the first block holds unless the first model needs more
+const size_t ARENA_BLOCK_VERTICES   = 1 << 21; //Each block doubles the last one's vertices up to this unless a model needs more
+const size_t ARENA_BLOCK_INDICES    = 1 << 22; //Each block doubles the last one's indices up to this unless a model needs more
+const size_t ARENA_DRAW_INDICES     = 1 << 14; //Draws per multi draw submit before the draw index buffer grows
+const GLuint DRAW_INDEX_LOCATION    = 4; //Per draw attribute, the base instance turns it into the draw's index
+const GLuint DRAW_CONSTANTS_BINDING = 3; //Shader storage binding of the per draw model matrices
+
+struct GeometryAllocation {
+    int    block; //Block the ranges live in, -1 when nothing was allocated
+    GLint  baseVertex; //Added to every index of the model
+    GLuint firstIndex; //First index of the model in the block's index buffer
+    GLuint vertexCount;
+    GLuint indexCount;
+};
+
+//Layout glMultiDrawElementsIndirect reads
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+
+class GeometryArena {
+
+    struct GeometryRange {
+        size_t first;
+        size_t count;
+    };
+
+    struct Block {
+        GLuint                     positionBuffer; //3 floats per vertex
+        GLuint                     normalBuffer; //10:10:10:2 snorm per vertex
+        GLuint                     textureBuffer; //2 floats per vertex
+        GLuint                     indexBuffer;
+        GLuint                     vao; //Position, normal and texture coordinate format
+        GLuint                     shadowVao; //Position only format
+        size_t                     vertexCapacity;
+        size_t                     indexCapacity;
+        std::vector<GeometryRange> freeVertices; //Unused ranges sorted by first
+        std::vector<GeometryRange> freeIndices; //Unused ranges sorted by first
+    };
+
+    std::vector<Block>  _blocks;
+    std::vector<GLuint> _drawIndexVaos; //Every vao the draw index attribute is attached to
+    GLuint              _drawIndexBuffer; //0, 1, 2... read once per draw through the base instance
+    size_t              _drawIndexCapacity;
+    StreamBuffer*       _commandBuffer; //Indirect commands written every submit
+    StreamBuffer*       _drawConstants; //Model matrix of every draw written every submit
+    GLint               _storageAlignment; //Offset alignment of shader storage ranges
+
+    bool                _allocateRange(std::vector<GeometryRange>& freeRanges, size_t count, size_t& first); //First fit
+    void                _releaseRange(std::vector<GeometryRange>& freeRanges, size_t first, size_t count); //Merges neighbors
+    void                _createBlock(size_t vertices, size_t indices);
+    void                _bindFormat(Block& block, bool shadow); //Points the bound vao at a block's streams
+    void                _attachDrawIndex(GLuint vao);
+public:
+    GeometryArena();
+    ~GeometryArena();
+    GeometryAllocation  allocate(const std::vector<Vector3>& positions, const std::vector<SnormNormal>& normals,
+                                 const std::vector<Tex2>& textures, const std::vector<int>& indices);
+    void                free(GeometryAllocation& allocation);
+    GLuint              getVAOContext(int block);
+    GLuint              getShadowVAOContext(int block);
+    GLuint              getPositionContext(int block);
+    GLuint              getNormalContext(int block);
+    GLuint              getTextureContext(int block);
+    GLuint              createPrivateVAO(int block); //Full format vao of a block that the caller can add attributes to
+    void                destroyPrivateVAO(GLuint vao);
+    void                reserveDrawIndices(size_t count); //Makes room for count draws in one submit
+    StreamBuffer*       getCommandBuffer();
+    StreamBuffer*       getDrawConstantBuffer();
+    GLint               getStorageAlignment();
+};
\ No newline at end of file
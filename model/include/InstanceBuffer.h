@@ -0,0 +1,75 @@
+/*
+* InstanceBuffer is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  InstanceBuffer class. Gpu storage for instanced drawing.  Every instance's row major 4x4 transform
+*  lives in one buffer that the vertex shader reads through a buffer texture, and a per instance
+*  vertex attribute holds the index of each instance that survived culling.  The transforms grow on
+*  demand and only the ones that changed since the last upload are sent.  The visible indices are
+*  rebuilt every frame so they are appended to a stream buffer and drawn with a base instance.
+*  When the gpu culls the instances it compacts the visible indices into a separate buffer and
+*  counts them straight into indirect draw commands so they never come back to the cpu.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include "Matrix.h"
+#include "StreamBuffer.h"
+#include <vector>
+
+const size_t INSTANCE_TRANSFORM_FLOATS = 16;
+const GLuint INSTANCE_INDEX_LOCATION   = 3; //First attribute location after vertex, normal and texture coordinate
+
+//Layout glDrawArraysIndirect reads from the indirect buffer
+struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint first;
+    GLuint baseInstance;
+};
+
+class InstanceBuffer {
+
+    GLuint             _transformBufferContext; //Buffer holding 16 floats per instance
+    GLuint             _transformTextureContext; //Buffer texture view of the transforms for texelFetch
+    StreamBuffer*      _visibleIndices; //Instanced attribute with the index of each visible instance
+    GLuint             _vaoContext; //Vao the visible index attribute is attached to
+    GLuint             _location; //Attribute location of the visible index
+    GLuint             _attachedContext; //Stream buffer the attribute currently points at
+    size_t             _transformCapacity; //Number of transforms the buffer has room for
+    GLuint             _culledBufferContext; //Visible indices compacted by the gpu cull
+    GLuint             _commandBufferContext; //Indirect draws whose instance counts the gpu cull fills in
+    size_t             _culledCapacity; //Number of indices the culled buffer has room for
+    size_t             _dirtyBegin; //First transform changed since the last upload
+    size_t             _dirtyEnd; //One past the last transform changed since the last upload
+    std::vector<float> _staging; //Flattened copy of the range being uploaded
+
+    void               _create();
+    void               _pointAttribute(GLuint bufferContext); //Aims the visible index attribute at a buffer
+public:
+    InstanceBuffer();
+    ~InstanceBuffer();
+    void               attach(GLuint vaoContext, GLuint location); //Adds the visible index attribute to a vao
+    void               markDirty(size_t first, size_t count); //Flags a range of transforms for the next upload
+    void               uploadTransforms(const std::vector<Matrix>& transforms);
+    GLuint             uploadVisible(const std::vector<GLuint>& visible); //Returns the base instance to draw with
+    void               prepareCulled(size_t instances,
+                                     const std::vector<DrawArraysIndirectCommand>& commands); //Resets the gpu cull outputs
+    GLuint             getTransformTexture();
+    GLuint             getTransformBuffer();
+    GLuint             getCulledBuffer();
+    GLuint             getCommandBuffer();
+};
\ No newline at end of file
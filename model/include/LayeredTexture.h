@@ -30,5 +30,5 @@ class LayeredTexture {
 public:
     LayeredTexture(std::vector<std::string> textureNames); //if true then it is a special cube map
     ~LayeredTexture();
-    std::vector<Texture*> getTextures();
+    std::vector<Texture*>& getTextures();
 };
\ No newline at end of file
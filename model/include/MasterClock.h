@@ -16,43 +16,50 @@
 */
 
 /**
-*  MasterClock class. A singleton responsible for updating certain parties
-*  who subscribe to various clock feeds.  A clock feed could be a 60 Hz screen
-*  refresh update that MasterClock would trigger an event every 16.7 milliSeconds.
+*  MasterClock class. Responsible for updating certain parties who subscribe to
+*  various clock feeds.  A clock feed could be a 60 Hz screen refresh update that
+*  MasterClock would trigger an event every 16.7 milliSeconds.  Each World owns
+*  one and instance() returns the clock of the calling thread's current World.
 */
 #pragma once
 #include <vector>
 #include <functional>
 #include <chrono>
 #include <thread>
+#include <atomic>
+class World;
 
 const int DEFAULT_FRAME_TIME = 16; //frame time in milliseconds which is 60 frames per second
 const int KINEMATICS_TIME = 5; //kinematics time in milliseconds
 
 class MasterClock{
-    //Make constructor/destructor private so it can't be instantiated
-    MasterClock();
-    static MasterClock*                   _clock;
     std::vector<std::function<void(int)>> _frameRateFuncs; //Clock feed subscriber's function pointers
     std::vector<std::function<void(int)>> _animationRateFuncs; //Clock feed subscriber's function pointers
     std::vector<std::function<void(int)>> _kinematicsRateFuncs; //Clock feed subscriber's function pointers
-    void                                  _physicsProcess();
-    void                                  _fpsProcess();
-    void                                  _animationProcess();
+    void                                  _physicsProcess(World* world);
+    void                                  _fpsProcess(World* world);
+    void                                  _animationProcess(World* world);
     std::thread*                          _physicsThread;
     std::thread*                          _fpsThread;
     std::thread*                          _animationThread;
     unsigned int                          _milliSecondCounter;
     int                                   _frameTime;
     int                                   _animationTime;
+    std::atomic<bool>                     _running; //Clock threads exit once this is cleared
+    int                                   _kinematicsStepCounter; //Leftover milliseconds of manual steps per feed
+    int                                   _animationStepCounter;
+    int                                   _frameStepCounter;
 
 public:
 
+    MasterClock();
     ~MasterClock();
-    static MasterClock* instance();
+    static MasterClock* instance(); //Clock of the calling thread's current World
     void setFrameRate(int framesPerSecond); //Gives programmer adjustable framerate
     void subscribeFrameRate(std::function<void(int)> func); //Frame rate update
     void subscribeAnimationRate(std::function<void(int)> func); //Frame rate update
     void subscribeKinematicsRate(std::function<void(int)> func); //Physics clock time update
-    void run(); //Kicks off the master clock thread that will asynchronously updates subscribers with clock events
+    void run(World* world); //Kicks off the clock threads that asynchronously update subscribers, each with world current
+    void stop(); //Stops and joins the clock threads
+    void step(int milliSeconds); //Synchronously advances all feeds without the clock threads, for worlds not run in real time
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+* Material is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  Material class. Everything a draw needs bound besides its geometry, built once when a
+*  model's textures load: the shader variant, the textures with the unit each is bound to and
+*  the uniform values the variant needs.  Binding is one call with no lookups or branching on
+*  texture names, and materials built from the same textures share an id for draw sorting.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include <vector>
+#include <cstdint>
+
+enum class MaterialVariant {
+    Textured = 0, //Single diffuse texture in textureMap
+    Layered, //Up to four textures blended by an alpha map
+    Terrain //Diffuse texture plus the dirt, grass, rocks and snow layers of the procedural island
+};
+
+enum class MaterialSampler {
+    TextureMap = 0,
+    Tex0,
+    Tex1,
+    Tex2,
+    Tex3,
+    AlphaTex0
+};
+const int MATERIAL_SAMPLER_COUNT = 6;
+
+struct MaterialTexture {
+    MaterialSampler sampler; //Sampler uniform the texture is read through
+    GLuint          unit; //Texture unit the texture is bound to
+    GLuint          context; //Gl texture
+};
+
+struct MaterialUniforms {
+    GLint           layered; //isLayeredTexture switch
+};
+
+class Material {
+
+    uint32_t                     _id; //Index in the material broker, equal ids bind the same state
+    MaterialVariant              _variant;
+    MaterialUniforms             _uniforms;
+    std::vector<MaterialTexture> _textures; //Bound in order so a later texture can replace an earlier one on a unit
+    bool                         _transparent; //Drawn by the forward pass after deferred lighting instead
+
+public:
+    Material(uint32_t id, MaterialVariant variant, std::vector<MaterialTexture> textures, bool transparent);
+    ~Material();
+    uint32_t                     getId() const;
+    MaterialVariant              getVariant() const;
+    bool                         isTransparent() const;
+    const std::vector<MaterialTexture>& getTextures() const;
+    void                         bind(const GLint* samplerLocations, GLint layeredSwitchLocation) const; //Locations indexed by MaterialSampler
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+/*
+* MaterialBroker is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  The MaterialBroker class builds and owns the materials of a world.  Materials are made
+*  from texture handles while models load and identical materials are shared, so a material's
+*  id can be used to sort draws and skip redundant binds.
+*/
+
+#pragma once
+#include "Material.h"
+#include "TextureBroker.h"
+#include <map>
+
+class MaterialBroker {
+    TextureBroker*                           _textureBroker; //Resolves the handles materials are built from
+    std::vector<Material*>                   _materials; //Indexed by material id
+    std::map<std::vector<GLuint>, Material*> _materialKeys; //Variant and textures of every material, load time only
+    Material*                                _getMaterial(MaterialVariant variant, std::vector<MaterialTexture> textures, bool transparent);
+public:
+    MaterialBroker(TextureBroker* textureBroker);
+    static MaterialBroker*                   instance();
+    ~MaterialBroker();
+    Material*                                getTexturedMaterial(TextureHandle texture);
+    Material*                                getLayeredMaterial(LayeredTextureHandle layeredTexture);
+    Material*                                getTerrainMaterial(TextureHandle texture, const std::vector<TextureHandle>& layers); //dirt, grass, rocks, snow
+    Material*                                getMaterial(uint32_t id);
+    size_t                                   getMaterialCount();
+};
\ No newline at end of file
@@ -21,11 +21,20 @@
 
 #pragma once
 #include "Vector4.h"
+#include "SIMD.h"
 #include <math.h>
 
 const float PI = 3.14159265f;
 const float PI_OVER_180 = PI / 180.0f;
 
+//Structure of a matrix's values, ordered so a product has the larger type of its two factors
+enum class MatrixType {
+    Orthonormal = 0, //Pure rotation, no translation or scale
+    Rigid,           //Rotation and translation
+    Affine,          //Any 3x3 transform plus translation with a 0 0 0 1 bottom row
+    General          //Anything else such as perspective projections
+};
+
 class Matrix {
 
 
@@ -74,21 +83,31 @@ class Matrix {
     //| 0 0 0 1 |  
 
 
-    float _matrix[16];
+    MATH_ALIGN float _matrix[16];
+    MatrixType       _type; //Picks the inverse path, writing through getFlatBuffer must keep the type true
+
+    Matrix        _inverseGeneral(); //Full 4x4 cofactor expansion
 
 public:
-    Matrix();
-    Matrix(float *mat);
-    Matrix(double *mat);
+    Matrix(); //Identity matrix tagged as orthonormal
+    Matrix(float *mat, MatrixType type = MatrixType::General);
+    Matrix(double *mat, MatrixType type = MatrixType::General);
 
     Matrix        transpose(); //Returns transpose of matrix
-    Matrix        inverse(); //Returns inverse of matrix
-    Matrix        operator * (Matrix mat);
-    Vector4       operator * (Vector4 vec);
+    Matrix        inverse(); //Returns inverse of matrix using the fastest path the type allows
+    Matrix        inverseAffine(); //Inverts the 3x3 and translation, bottom row must be 0 0 0 1
+    Matrix        inverseRigid(); //Transposes the rotation and negates the translation
+    Matrix        inverseOrthonormal(); //Transposes the rotation
+    Matrix        normalMatrix(); //Inverse transpose used to transform normals
+    MatrixType    getType() const;
+    void          setType(MatrixType type);
+    Matrix        operator * (const Matrix& mat);
+    Vector4       operator * (const Vector4& vec);
     Matrix        operator * (double scale);
     Matrix        operator * (float scale);
     Matrix        operator + (Matrix mat);
     float*        getFlatBuffer();
+    const float*  getFlatBuffer() const;
     void          display();
 
     static Matrix rotationAroundX(float degrees); //Build rotation matrix around the x axis
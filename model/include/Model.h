@@ -33,11 +33,15 @@
 #include "FbxLoader.h"
 #include "MasterClock.h"
 #include "TextureBroker.h"
+#include "MaterialBroker.h"
 #include "Geometry.h"
 #include "VAO.h"
 #include "MVP.h"
 #include "RenderBuffers.h"
 #include "ForwardShader.h"
+#include "Frustum.h"
+#include "InstanceBuffer.h"
+#include "OcclusionBuffer.h"
 
 class SimpleContext;
 
@@ -52,6 +56,13 @@ enum class GeometryType {
 };
 using TextureMetaData = std::vector<std::pair<std::string, int>>;
 
+struct StrideTexture {
+    bool                 layered; //Stride samples a layered texture instead of a single one
+    TextureHandle        texture;
+    LayeredTextureHandle layeredTexture;
+    Material*            material; //Binds everything the stride samples
+};
+
 class Model : public UpdateInterface {
     
 public:
@@ -74,18 +85,33 @@ public:
     size_t                      getArrayCount();
     void                        addTexture(std::string textureName, int stride);
     void                        addLayeredTexture(std::vector<std::string> textureNames, int stride);
-    Texture*                    getTexture(std::string textureName);
-    LayeredTexture*             getLayeredTexture(std::string textureName);
+    void                        addTerrainTexture(std::string textureName, std::vector<std::string> layerNames, int stride); //Layers are dirt, grass, rocks and snow
     TextureMetaData&            getTextureStrides();
+    bool                        isLayeredStride(int stride);
+    Texture*                    getStrideTexture(int stride); //nullptr for layered strides
+    LayeredTexture*             getStrideLayeredTexture(int stride); //nullptr for single texture strides
+    Material*                   getStrideMaterial(int stride);
     GeometryType                getGeometryType();
     Geometry*                   getGeometry();
     void                        addGeometryTriangle(Triangle triangle);
     void                        addGeometrySphere(Sphere sphere);
     void                        setPosition(Vector4 position);
     void                        setVelocity(Vector4 velocity);
-    void                        setInstances(std::vector<Vector4> offsets); //is this model used for instancing
+    void                        setInstances(std::vector<Vector4> offsets); //Instances the model at each world space offset
+    void                        setInstanceTransforms(std::vector<Matrix> transforms); //Instances the model with a world transform per copy
+    void                        setInstanceTransform(size_t index, Matrix transform); //Only this instance is resent to the gpu
     bool                        getIsInstancedModel();
-    float*                      getInstanceOffsets();
+    std::vector<Matrix>&        getInstanceTransforms();
+    InstanceBuffer*             getInstanceBuffer();
+    size_t                      getInstanceCount();
+    void                        getWorldBounds(Vector4& center, Vector4& halfExtent); //World space box around a single copy of the model
+    Matrix                      getBoundsTransform(); //Maps the [-1, 1] cube onto a single copy's world space box
+    bool                        isVisible(const Frustum& frustum); //Tests the box around the model and all of its instances
+    void                        setOccluder(bool occluder); //Occluders are drawn into the occlusion buffer and never culled by it
+    bool                        isOccluder();
+    size_t                      getTransformSignature(); //Hash of the model and its model matrix, changes whenever it moves
+    void                        recordDraws(DrawList* drawList,
+                                            const OcclusionBuffer* occlusionBuffer = nullptr); //Culls and queues the g buffer draws without gl calls
 
 protected:
     StateVector                 _state; //Kinematics
@@ -98,14 +124,26 @@ protected:
     FbxLoader*                  _fbxLoader; //Used to load fbx data and parse it into engine format
     ModelClass                  _classId; //Used to identify which class is being used
     MasterClock*                _clock; //Used to coordinate time with the world
-    static TextureBroker*       _textureManager; //Static texture manager for texture reuse purposes, all models have access
+    TextureBroker*              _textureManager; //Texture manager of the model's world for texture reuse purposes
+    MaterialBroker*             _materialManager; //Material cache of the model's world
     std::string                 _textureName; //Keeps track of which texture to grab from static texture manager
     TextureMetaData             _textureStrides; //Keeps track of which set of vertices use a certain texture within the large vertex set
+    std::vector<StrideTexture>  _strideTextures; //Broker handles resolved when each stride's texture is added
     GeometryType                _geometryType; //Indicates whether the collision geometry is sphere or triangle based
     Geometry                    _geometry; //Geometry object that contains all collision information for a model
     bool                        _isInstanced;
-    float                       _offsets[900]; //300 x, y and z offsets
-    int                         _instances;
+    std::vector<Matrix>         _instanceTransforms; //World transform applied after the model matrix for each instance
+    InstanceBuffer              _instanceBuffer; //Gpu copy of the instance transforms
+    Vector4                     _boundsCenter; //Center of the model space box around the vertices
+    Vector4                     _boundsHalfExtent; //Half widths of the model space box around the vertices
+    Vector4                     _instanceBoundsCenter; //Center of the world space box around every instance
+    Vector4                     _instanceBoundsHalfExtent; //Half widths of the world space box around every instance
+    Matrix                      _instanceBoundsModel; //Model matrix the instance box was built with
+    bool                        _instanceBoundsDirty; //Instance transforms changed since the instance box was built
+    bool                        _isOccluder; //Large model that hides what is behind it, such as terrain
+
+    void                        _computeBounds();
+    void                        _computeInstanceBounds(Matrix& model);
 
     std::string                 _getModelName(std::string name);
     void                        _updateKeyboard(int key, int x, int y); //Do stuff based on keyboard upate
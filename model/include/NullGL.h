@@ -0,0 +1,57 @@
+/*
+* NullGL is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+*  NullGL class. Recording gl backend for headless benchmarks.  gl3w already sends every gl call
+*  through its table of function pointers so installing this backend just points the entries the
+*  engine uses at stubs.  The stubs create names, keep buffer contents for mapping and reading back,
+*  shadow the bound state so changes can be told apart from redundant sets, and check the calls for
+*  misuse such as binding names that were never generated or drawing without a program.  Nothing is
+*  rasterized so a frame costs only the engine's own cpu time.  Each framebuffer bind starts a new
+*  pass so the cost of every pass is reported separately.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include <vector>
+
+const int NULL_GL_MAX_REPORTED_ERRORS = 32; //Misuse messages printed before only counting them
+
+struct NullGLStats {
+    size_t calls; //Every gl entry point called
+    size_t drawCalls; //Draws, multi draws and compute dispatches
+    size_t stateChanges; //Binds and sets that changed the shadowed state
+    size_t redundantChanges; //Binds and sets that left the shadowed state as it was
+    size_t uploadedBytes; //Bytes sent with buffer data, sub data and mapped ranges
+    size_t errors; //Calls that failed validation
+    double cpuMilliseconds; //Wall time spent on the calling thread
+};
+
+struct NullGLPass {
+    GLuint      framebuffer; //Draw framebuffer bound when the pass started
+    NullGLStats stats; //Summed over every measured frame
+};
+
+class NullGL {
+public:
+    static void install(); //Points gl3w's entry points at the recording backend
+    static bool isInstalled();
+    static void beginFrame();
+    static void endFrame(); //Closes the frame's last pass and adds the frame to the totals
+    static void resetTotals(); //Drops warm up frames so caches being built do not skew the averages
+    static void printReport(); //Averages per frame and per pass over the measured frames
+};
\ No newline at end of file
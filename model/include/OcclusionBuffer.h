@@ -0,0 +1,58 @@
+/*
+* OcclusionBuffer is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  OcclusionBuffer class. Low resolution depth buffer rasterized on the cpu from a few large
+*  occluders such as terrain.  Pixels hold the reciprocal of clip w so depth interpolates
+*  linearly across a triangle and the nearest occluder keeps the largest value.  Tests are
+*  conservative: occluders only write pixels they cover completely, with the farthest depth
+*  inside the pixel, and a box is only occluded when every pixel it touches holds an occluder
+*  nearer than the box's nearest corner.
+*/
+
+#pragma once
+#include "Matrix.h"
+#include "Vector4.h"
+#include <vector>
+#include <cstdint>
+
+const int   OCCLUSION_WIDTH      = 320;
+const int   OCCLUSION_HEIGHT     = 180;
+const float OCCLUSION_GUARD_BAND = 8.0f; //Occluder vertices further off screen than this in clip space units are skipped to keep edge math precise
+
+class OcclusionBuffer {
+
+    std::vector<float>   _depth; //Reciprocal clip w per pixel with rows from the bottom of the screen, 0 is empty
+    std::vector<Vector4> _projected; //Scratch pixel x, y and reciprocal w of an occluder's vertices, w is 0 when unusable
+    Matrix               _viewProjection; //Camera the buffer was cleared with
+    float                _nearPlane; //The gpu clips anything nearer so it can not hide anything here either
+    bool                 _hasOccluders; //Something was rasterized since the last clear
+
+    void                 _rasterizeTriangle(const float* a, const float* b, const float* c);
+    bool                 _rectOccluded(float minX, float maxX, float minY, float maxY, float nearest) const; //Screen rectangle in pixels against the box's nearest reciprocal w
+
+public:
+    OcclusionBuffer();
+    ~OcclusionBuffer();
+    void                 clear(const Matrix& projection, const Matrix& view); //Empties the buffer for a perspective camera
+    void                 rasterize(const Matrix& model, const std::vector<Vector4>& vertices,
+                                   const std::vector<int>& indices); //Empty indices draws consecutive vertex triples
+    bool                 isOccluded(const Matrix& transform) const; //transform maps the -1 to 1 cube onto the box
+    void                 testOBBs(const Matrix* transforms, size_t count, uint32_t* visibleMasks) const; //Clears the bits of occluded boxes in a Frustum mask
+    bool                 hasOccluders() const;
+    const float*         getDepth() const;
+};
\ No newline at end of file
@@ -17,7 +17,9 @@
 
 /**
 *  PointShadowRenderer class. Uses a cube map texture class from point lights in the scene
-*  to generate shadows.
+*  to generate shadows.  Each face is culled and drawn on its own and only redrawn when the
+*  models inside of its frustum changed, and the face size follows the light's screen coverage.
+*  Only one point light casts shadows, the first one rendered.
 */
 
 #pragma once
@@ -28,14 +30,26 @@
 #include "Model.h"
 #include "ShadowAnimatedPointShader.h"
 #include "CubeMapRenderer.h"
+class ViewManager;
+
+const GLuint POINT_SHADOW_MIN_RESOLUTION = 256; //Smallest face size for lights far away from the camera
+const float  POINT_SHADOW_SHRINK_MARGIN  = 0.75f; //Coverage must drop this far below a smaller size before shrinking
 
 class PointShadowMap : public CubeMapRenderer {
 
     ShadowPointShader          _pointShadowShader;//Shader that generates point light cube map shadows
     ShadowAnimatedPointShader  _pointAnimatedShadowShader;//Animated Shader that generates point light cube map shadows
+    GLuint                     _maxResolution; //Face size used when the camera is inside of the light's range
+    Light*                     _cachedLight; //The one shadow casting point light the faces are drawn for
+    Vector4                    _cachedLightPosition; //Light position the cached faces were drawn from
+    bool                       _faceValid[6]; //Face holds a usable depth image
+    size_t                     _faceSignatures[6]; //Hash of the models and transforms drawn into each face
+    std::vector<Model*>        _faceModels[6]; //Models culled into each face this frame
+    GLuint                     _selectResolution(Light* light, ViewManager* viewManager);
 public:
-    PointShadowMap(GLuint width, GLuint height);
+    PointShadowMap(GLuint maxResolution);
     ~PointShadowMap();
 
-    void render(std::vector<Model*> modelList, Light* light);
+    void render(std::vector<Model*>& modelList, Light* light, ViewManager* viewManager);
+    void invalidateCache(); //Forces all six faces to be redrawn
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+* Quaternion is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  Quaternion class. Unit quaternion rotations stored as x, y, z and w where w is the scalar
+*  part.  Composes in the same order as Matrix so a * b rotates by b and then by a.
+*/
+
+#pragma once
+#include "Matrix.h"
+
+class Quaternion {
+    MATH_ALIGN float _quat[4];
+public:
+    Quaternion(); //Identity rotation
+    Quaternion(float x, float y, float z, float w);
+    Quaternion(const Quaternion& other);
+    Quaternion(const Matrix& rotation); //Upper 3x3 must be a rotation without scale
+
+    float*       getFlatBuffer();
+    const float* getFlatBuffer() const;
+    float        getx() const;
+    float        gety() const;
+    float        getz() const;
+    float        getw() const;
+
+    Quaternion   operator * (const Quaternion& other) const; //Composition
+    Quaternion   operator * (float scale) const;
+    Quaternion   operator + (const Quaternion& other) const;
+    Quaternion   operator - () const;
+    Quaternion&  operator = (const Quaternion& other);
+    float        dotProduct(const Quaternion& other) const;
+    float        getMagnitude() const;
+    void         normalize();
+    Quaternion   conjugate() const; //Inverse of a unit quaternion
+    Vector4      rotate(const Vector4& vec) const; //Rotates x, y and z and keeps w
+    Matrix       toMatrix() const; //Tagged as orthonormal
+
+    static Quaternion fromAxisAngle(Vector4 axis, float degrees); //Same handedness as Matrix::rotationAround
+    static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t); //Normalized linear blend
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t); //Constant angular velocity blend
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+* ResourcePool is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  ResourcePool class. Dense array of resources addressed by generational handles.  A handle
+*  is a slot index plus the generation the slot had when the resource was added, so a handle
+*  kept after its resource is removed resolves to nullptr instead of whatever reuses the slot.
+*  Resolving a handle is an index and a compare, no string hashing or tree walks.  The pool never
+*  deletes anything, remove hands the resource back to the owner to free.
+*/
+#pragma once
+#include <vector>
+#include <cstdint>
+
+const uint32_t INVALID_RESOURCE_INDEX = 0xFFFFFFFF;
+
+template<typename T>
+struct ResourceHandle {
+    uint32_t index = INVALID_RESOURCE_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_RESOURCE_INDEX; }
+    bool operator == (const ResourceHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator != (const ResourceHandle& other) const { return !(*this == other); }
+};
+
+template<typename T>
+class ResourcePool {
+
+    struct Slot {
+        T*       resource; //nullptr while the slot is free
+        uint32_t generation; //Bumped every time the slot's resource is removed
+    };
+
+    std::vector<Slot>     _slots;
+    std::vector<uint32_t> _freeSlots; //Slots that can be reused by the next add
+
+public:
+    ResourceHandle<T> add(T* resource) {
+        ResourceHandle<T> handle;
+        if (_freeSlots.empty()) {
+            handle.index = static_cast<uint32_t>(_slots.size());
+            _slots.push_back(Slot{ resource, 0 });
+        }
+        else {
+            handle.index = _freeSlots.back();
+            _freeSlots.pop_back();
+            _slots[handle.index].resource = resource;
+        }
+        handle.generation = _slots[handle.index].generation;
+        return handle;
+    }
+
+    T* get(ResourceHandle<T> handle) const {
+        if (handle.index >= _slots.size() || _slots[handle.index].generation != handle.generation) {
+            return nullptr;
+        }
+        return _slots[handle.index].resource;
+    }
+
+    T* remove(ResourceHandle<T> handle) { //Returns the resource so the caller can free it
+        T* resource = get(handle);
+        if (resource != nullptr) {
+            _slots[handle.index].resource = nullptr;
+            _slots[handle.index].generation++;
+            _freeSlots.push_back(handle.index);
+        }
+        return resource;
+    }
+
+    size_t size() const {
+        return _slots.size() - _freeSlots.size();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,36 @@
+/*
+* SIMD is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  SIMD. Picks the vector instruction set used by the Matrix and Vector4 math.  SSE on
+*  x86/x64, NEON on 64 bit ARM and plain scalar code everywhere else or when MATH_SCALAR
+*  is defined.  Every vector path adds its products in the same order as the scalar code
+*  so results are bit for bit identical across all three.
+*/
+
+#pragma once
+
+#if !defined(MATH_SCALAR) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATH_SSE
+#include <emmintrin.h>
+#elif !defined(MATH_SCALAR) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MATH_NEON
+#include <arm_neon.h>
+#endif
+
+//Storage alignment needed for aligned vector loads and stores
+#define MATH_ALIGN alignas(16)
\ No newline at end of file
@@ -20,7 +20,7 @@
 */
 
 #pragma once
-#include "Physics.h"
+#include "World.h"
 #include <vector>
 
 class ViewManager;
@@ -33,12 +33,15 @@ class SSAO;
 class EnvironmentMap;
 class Water;
 class FontRenderer;
+class UniformBlocks;
+class LightClusters;
+class DrawRecorder;
 
 class SceneManager {
     ViewManager*        _viewManager; //manages the view/camera matrix from the user's perspective
     std::vector<Model*> _modelList; //Contains models active in scene
     std::vector<Light*> _lightList; //Contains all lights in a scene
-    Physics             _physics; //Manages physical interactions between models
+    World               _world; //Owns the clock, physics and texture cache of the scene, moving spheres use the loose oct tree
     DeferredRenderer*   _deferredRenderer; //Manages deferred shading g buffers
     ForwardRenderer*    _forwardRenderer; //Manages forward shading transparent objects
     ShadowRenderer*     _shadowRenderer;   //Manages shadow rendering
@@ -48,9 +51,13 @@ class SceneManager {
     EnvironmentMap*     _environmentMap;
     Water*              _water;
     FontRenderer*       _fontRenderer; // Manages text rendering
+    UniformBlocks*      _uniformBlocks; //Frame, view and light constants shared by every shader
+    LightClusters*      _lightClusters; //Point lights binned into view frustum clusters
+    DrawRecorder*       _drawRecorder; //Threads that record the g buffer draws without gl calls
 
     void _preDraw(); //Prior to drawing objects call this function
     void _postDraw(); //Post of drawing objects call this function
+    void _drawOccluders(); //Rasterizes the visible occluders into the world's occlusion buffer
 public:
     SceneManager(int* argc, char** argv, unsigned int viewportWidth, unsigned int viewportHeight,
         float nearPlaneDistance, float farPlaneDistance);
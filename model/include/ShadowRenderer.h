@@ -16,7 +16,14 @@
 */
 
 /**
-*  ShadowRenderer class. Generates depth texture for shadow processing
+*  ShadowRenderer class. Cascaded shadow maps for the directional sun light.  The camera frustum
+*  up to SHADOW_DISTANCE is split into SHADOW_CASCADES slices and each slice gets an orthographic
+*  light volume fitted around its bounding sphere.  The sphere's size does not change as the
+*  camera turns and its center is snapped to whole shadow texels, so shadow edges do not swim.
+*  The nearest cascade is fully redrawn every frame.  Static geometry of the farther cascades is
+*  cached and only redrawn when the sun has turned, the camera has left the cached area or a
+*  static model was added, removed or moved, the cache is then copied in and only animated models
+*  are drawn on top.
 */
 
 #pragma once
@@ -25,24 +32,43 @@
 #include "Model.h"
 #include "AnimatedModel.h"
 #include <vector>
-#include "DepthFrameBuffer.h"
+#include "DepthArrayFrameBuffer.h"
 class Model;
 class ViewManager;
 
+const int   SHADOW_CASCADES       = 3;
+const float SHADOW_DISTANCE       = 100.0f; //View depth past which nothing receives sun shadows
+const float SHADOW_SPLIT_LAMBDA   = 0.8f;   //Blend between logarithmic (1) and uniform (0) splits
+const float SHADOW_CASTER_DEPTH   = 50.0f;  //Extra depth toward the sun for casters outside a cascade
+const float SHADOW_CACHE_MARGIN   = 0.25f;  //Extra radius cached cascades are rendered with
+const float SHADOW_CACHE_ANGLE    = 0.9998f; //Cosine of the sun rotation that invalidates the cache
+
 class ShadowRenderer {
 
-    ShadowStaticShader   _staticShadowShader;   //Shader that generates static geometry shadows
-    ShadowAnimatedShader _animatedShadowShader; //Shader that generates animated geometry shadows
-    DepthFrameBuffer     _staticShadowFBO;      //Depth frame buffer object for static objects that do not change
-    DepthFrameBuffer     _animatedShadowFBO;    //Depth frame buffer object for animated objects that change
-    DepthFrameBuffer     _mapShadowFBO;         //Low resolution shadow mapping for the entire map
-    bool                 _staticRendered;       //boolean to only get static object shadows at startupqsssssq
+    ShadowStaticShader    _staticShadowShader;   //Shader that generates static geometry shadows
+    ShadowAnimatedShader  _animatedShadowShader; //Shader that generates animated geometry shadows
+    DepthArrayFrameBuffer _cascadeFBO;           //One layer per cascade sampled by the lighting passes
+    DepthArrayFrameBuffer _staticCacheFBO;       //Static geometry of the cached cascades
+    MVP                   _cascadeMVPs[SHADOW_CASCADES]; //Light view and projection each cascade was drawn with
+    float                 _cascadeCenters[SHADOW_CASCADES][3]; //Light space center each cascade was fitted around
+    float                 _cascadeRadii[SHADOW_CASCADES]; //Radius each cascade was fitted around
+    float                 _splits[SHADOW_CASCADES]; //View depth where each cascade ends
+    bool                  _cacheValid[SHADOW_CASCADES];
+    Vector4               _cachedLightDirection; //Sun direction the static cache was drawn with
+    size_t                _cachedStaticSignature; //Hash of the static models and transforms the static cache was drawn with
+
+    void                  _fitCascade(int cascade, float splitNear, float splitFar, ViewManager* viewManager,
+                                      Matrix& lightRotation, float margin, float center[3], float& radius);
+    void                  _setCascadeMVP(int cascade, Matrix& lightRotation, float center[3], float radius);
+    void                  _renderModels(std::vector<Model*>& modelList, ModelClass modelClass, MVP& cascadeMVP);
+    void                  _bindLayer(DepthArrayFrameBuffer& frameBuffer, int layer, bool clear);
 
 public:
-    ShadowRenderer(GLuint width, GLuint height);
+    ShadowRenderer(GLuint resolution);
     ~ShadowRenderer();
-    void generateShadowBuffer(std::vector<Model*> modelList, std::vector<Light*>& lights);
-    GLuint getStaticDepthTexture();
-    GLuint getAnimatedDepthTexture();
-    GLuint getMapDepthTexture();
-};
+    void generateShadowBuffer(std::vector<Model*> modelList, std::vector<Light*>& lights, ViewManager* viewManager);
+    void invalidateStaticCache(); //Forces the cached cascades to redraw static geometry
+    GLuint getCascadeTexture();
+    Matrix getCascadeMatrix(int cascade); //World space to the cascade's light clip space
+    float getCascadeSplit(int cascade);
+};
\ No newline at end of file
@@ -40,6 +40,9 @@ struct TimeEvent {
         pfnCallback(pfnCallback) {}
 };
 
+const int HEADLESS_DEFAULT_FRAMES = 600; //Measured frames when -headless is given without a count
+const int HEADLESS_WARMUP_FRAMES  = 30; //Frames drawn before measuring so shadow and culling caches are built
+
 static bool operator<(TimeEvent left, TimeEvent right) {
     return left.time > right.time;
 }
@@ -55,6 +58,7 @@ public:
     void                subscribeToReleaseKeyboard(std::function<void(int, int, int)> func); //Use this call to connect functions up to key release updates
 	void                subscribeToMouse(std::function<void(double, double)> func); //Use this call to connect functions up to mouse updates
     void                subscribeToDraw(std::function<void()> func); //Use this call to connect functions up to draw updates
+    static bool         isHeadless(); //Drawing through the NullGL recording backend without a window
 
 private:
 
@@ -66,11 +70,14 @@ private:
     static std::mutex   _renderLock;     //Prevents write/write collisions with renderNow on a frame tick trigger
     static GLFWwindow*  _window;         //Glfw window
     static bool         _quit;           //Notifies render loop that game is over
+    static int          _headlessFrames; //Frames to measure without a window, 0 opens a window as usual
 
     //All keyboard input from glfw will be notified here
     static void         _keyboardUpdate(GLFWwindow* window, int key, int scancode, int action, int mods);
     //One frame draw update call
     static void         _drawUpdate();
+    //Draws a fixed number of frames through the recording backend and prints the measurements
+    static void         _drawHeadless();
     //All mouse movement input will be notified here
     static void         _mouseUpdate(GLFWwindow* window, double x, double y);
     //Simple context synchronizes frame rate using the MasterClock tuning capability
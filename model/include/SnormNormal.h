@@ -0,0 +1,37 @@
+/*
+* SnormNormal is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  SnormNormal class.  Unit normal packed as 10:10:10:2 signed normalized integers in four
+*  bytes, the layout GL reads as GL_INT_2_10_10_10_REV with normalization on.
+*/
+
+#pragma once
+#include "Vector4.h"
+#include <vector>
+#include <cstdint>
+
+class SnormNormal {
+    uint32_t _bits;
+public:
+    SnormNormal();
+    SnormNormal(const Vector4& normal); //Clamps x, y and z to [-1, 1] and stores w as 0
+    uint32_t getBits() const;
+    Vector4  toVector4() const; //w is 0
+
+    static void pack(const std::vector<Vector4>& in, std::vector<SnormNormal>& out);
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+* StreamBuffer is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  StreamBuffer class. Ring buffer for geometry rebuilt every frame such as text, debug lines,
+*  particles and per frame instance data.  Writes are appended to one region of the ring and
+*  the caller draws from the returned byte offset.  With ARB_buffer_storage the ring is three
+*  regions of one persistently mapped buffer and a fence guards each region so the cpu only waits
+*  if it laps the gpu.  Without it, or on Mesa, the buffer is orphaned whenever it fills up and
+*  ranges are mapped unsynchronized, which never touches storage the gpu may still be reading.
+*/
+#pragma once
+#include "GLIncludes.h"
+
+const int STREAM_BUFFER_REGIONS = 3; //Frames the cpu can run ahead of the gpu
+
+class StreamBuffer {
+
+    GLenum         _target; //Binding point used while mapping and orphaning
+    GLuint         _bufferContext;
+    size_t         _regionSize; //Bytes in each region of the ring
+    int            _region; //Region currently being written
+    size_t         _offset; //Write cursor relative to the start of the current region
+    bool           _persistent; //Persistent mapping with fences instead of orphaning
+    unsigned char* _persistentData; //Pointer to the whole persistently mapped buffer
+    bool           _mapped; //A range is mapped and waiting for unmap when orphaning
+    GLsync         _fences[STREAM_BUFFER_REGIONS]; //Signaled once the gpu is done with each region
+
+    void           _create();
+    void           _destroy();
+    void           _nextRegion(); //Fences the current region and waits for the next one to be free
+    void           _grow(size_t size); //Reallocates with regions large enough to hold size bytes
+public:
+    StreamBuffer(GLenum target, size_t regionSize);
+    ~StreamBuffer();
+    void*          map(size_t size, size_t alignment, size_t& offset); //Returns write pointer, offset is from the buffer start
+    void           unmap();
+    size_t         write(const void* data, size_t size, size_t alignment); //Copies data in and returns its offset
+    GLuint         getContext(); //Changes if the buffer had to grow so rebind after every map
+    bool           isPersistent();
+    static bool    supportsPersistentMapping();
+};
\ No newline at end of file
@@ -16,26 +16,39 @@
 */
 
 /**
-*  The TextureBroker class is a singleton that manages all textures in a scene
+*  The TextureBroker class manages all textures in a scene.  Each World owns one
+*  and instance() returns the broker of the calling thread's current World.
+*  Textures are looked up by name only while assets load, the returned handles
+*  index straight into a dense pool for everything done per frame.
 */
 
 #pragma once
 #include "Texture.h"
 #include "LayeredTexture.h"
-#include <map>
+#include "ResourcePool.h"
+#include <unordered_map>
 #include <vector>
 
+using TextureHandle        = ResourceHandle<Texture>;
+using LayeredTextureHandle = ResourceHandle<LayeredTexture>;
+
 class TextureBroker{
-    std::map<std::string, Texture*> _textures;
-    std::map<std::string, LayeredTexture*> _layeredTextures;
-    TextureBroker();
-    static TextureBroker*           _broker;
+    ResourcePool<Texture>                                 _textures;
+    ResourcePool<LayeredTexture>                          _layeredTextures;
+    std::unordered_map<std::string, TextureHandle>        _textureNames; //Load time name lookups
+    std::unordered_map<std::string, LayeredTextureHandle> _layeredTextureNames; //Keyed by the Layered sum string
 public:
+    TextureBroker();
     static TextureBroker*           instance();
     ~TextureBroker();
-    void                            addTexture(std::string textureName);
-    void                            addLayeredTexture(std::vector<std::string> textureNames);
-    void                            addCubeTexture(std::string textureName);
-    Texture*                        getTexture(std::string textureName);
-    LayeredTexture*                 getLayeredTexture(std::string textureName);
+    TextureHandle                   addTexture(std::string textureName);
+    LayeredTextureHandle            addLayeredTexture(std::vector<std::string> textureNames);
+    TextureHandle                   addCubeTexture(std::string textureName);
+    TextureHandle                   findTexture(const std::string& textureName); //Invalid handle if never added
+    LayeredTextureHandle            findLayeredTexture(const std::string& textureName);
+    Texture*                        getTexture(TextureHandle handle);
+    LayeredTexture*                 getLayeredTexture(LayeredTextureHandle handle);
+    Texture*                        getTexture(const std::string& textureName); //Name lookup for asset loading only
+    size_t                          getTextureCount();
+    static std::string              getLayeredName(const std::vector<std::string>& textureNames);
 };
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include "Tex2.h"
 #include "RenderBuffers.h"
 #include "Animation.h"
+#include "GeometryArena.h"
 
 enum class ModelClass; //Forward declaration of enumerated type while not including Model class
 
@@ -40,9 +41,16 @@ class VAO {
     GLuint  _vaoShadowContext;
     GLuint  _indexContext;
     GLuint  _weightContext;
+    GeometryArena*     _arena; //Arena the geometry was suballocated from
+    GeometryAllocation _allocation; //Ranges of the model in the arena
+    bool               _privateVAO; //The vao context was detached from the arena's shared vao
 public:
     VAO();
     ~VAO();
+    VAO(const VAO&) = delete; //The destructor frees the arena ranges and private vao, only one VAO may own them
+    VAO& operator=(const VAO&) = delete;
+    VAO(VAO&&) = delete;
+    VAO& operator=(VAO&&) = delete;
     GLuint  getVAOContext();
     GLuint  getVAOShadowContext();
     GLuint  getVertexContext();
@@ -54,4 +62,7 @@ public:
     void    setTextureContext(GLuint context);
     void    setNormalDebugContext(GLuint context);
     void    createVAO(RenderBuffers* renderBuffers, ModelClass classId, Animation* = nullptr);
+    GLuint  detachVAOContext(); //Gives the model its own vao over the shared buffers for per model attributes
+    GLint   getBaseVertex(); //Offset of the model's vertices in the shared buffers
+    GLuint  getFirstIndex(); //Offset of the model's indices in the shared index buffer
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+/*
+* Vector3 is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  Vector3 class.  Packed x, y and z for storage where Vector4's w is always 1 or 0.  Expand
+*  to Vector4 to do math on it.
+*/
+
+#pragma once
+#include "Vector4.h"
+#include <vector>
+
+class Vector3 {
+    float _vec[3];
+public:
+    Vector3();
+    Vector3(float x, float y, float z);
+    Vector3(const Vector4& vec); //Drops w
+    float*       getFlatBuffer();
+    const float* getFlatBuffer() const;
+    float        getx() const;
+    float        gety() const;
+    float        getz() const;
+    Vector4      toVector4(float w = 1.0f) const;
+
+    static void  pack(const std::vector<Vector4>& in, std::vector<Vector3>& out);
+};
\ No newline at end of file
@@ -21,15 +21,17 @@
 
 #pragma once
 #include <iostream>
+#include "SIMD.h"
 
 class Vector4 {
-    float _vec[4];
+    MATH_ALIGN float _vec[4];
 public:
 
     Vector4();
     Vector4(float x, float y, float z, float w = 1.0f);
     Vector4(const Vector4& other);
     float*  getFlatBuffer();
+    const float* getFlatBuffer() const;
     void    display();
     Vector4 operator / (float scale);
     Vector4 operator * (float scale);
@@ -39,8 +41,8 @@ public:
     Vector4 operator - ();
     bool    operator == (Vector4 other);
     bool    operator != (Vector4 other);
-    Vector4 crossProduct(Vector4 other);
-    float   dotProduct(Vector4 other);
+    Vector4 crossProduct(const Vector4& other);
+    float   dotProduct(const Vector4& other);
     float   getx();
     float   gety();
     float   getz();
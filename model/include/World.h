@@ -0,0 +1,61 @@
+/*
+* World is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  World class. Owns the clock, physics and resource caches of one simulation so several
+*  simulations can run side by side in a process.  Like a GL context a world is made
+*  current on a thread, and MasterClock::instance() and TextureBroker::instance() return the
+*  calling thread's current world's objects.  Threads without a current world share a
+*  default world which gives the old process wide behavior.
+*/
+
+#pragma once
+#include "MasterClock.h"
+#include "TextureBroker.h"
+#include "MaterialBroker.h"
+#include "Physics.h"
+#include "DrawList.h"
+#include "GeometryArena.h"
+#include "OcclusionBuffer.h"
+
+class World {
+
+    MasterClock                 _clock; //Time feeds for kinematics, animation and frame updates
+    TextureBroker               _textureBroker; //Texture cache shared by everything in this world
+    MaterialBroker              _materialBroker; //Materials built from the texture cache
+    Physics                     _physics; //Manages physical interactions between models
+    DrawList                    _drawList; //Opaque draws queued by models during a frame
+    GeometryArena               _geometryArena; //Shared vertex and index buffers of every static model
+    OcclusionBuffer             _occlusionBuffer; //Cpu depth of this frame's occluders from the camera
+    static thread_local World*  _currentWorld; //World bound to the calling thread
+
+public:
+    World(bool looseDynamic = false); //looseDynamic stores moving spheres in a loose oct tree
+    ~World();
+    static World*               current(); //World bound to the calling thread or the default world
+    void                        makeCurrent(); //Binds this world to the calling thread
+    MasterClock*                getClock();
+    TextureBroker*              getTextureBroker();
+    MaterialBroker*             getMaterialBroker();
+    Physics*                    getPhysics();
+    DrawList*                   getDrawList();
+    GeometryArena*              getGeometryArena();
+    OcclusionBuffer*            getOcclusionBuffer();
+    void                        run(); //Runs the world in real time on the clock threads
+    void                        step(int milliSeconds); //Advances the world on the calling thread as fast as it can go
+    void                        stop(); //Stops the clock threads started by run
+};
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "BatchMath.h"
+#include <thread>
+
+//Runs work over [0, count), split into one contiguous range per hardware thread when the array is large
+template<typename Work>
+static void _parallelRanges(size_t count, Work work) {
+
+    size_t threadCount = std::thread::hardware_concurrency();
+    if (count < BATCH_THREAD_COUNT || threadCount < 2) {
+        work(0, count);
+        return;
+    }
+
+    size_t rangeSize = (count + threadCount - 1) / threadCount;
+    std::vector<std::thread> workers;
+    for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+        workers.push_back(std::thread(work, begin, begin + rangeSize < count ? begin + rangeSize : count));
+    }
+    //The calling thread takes the first range instead of waiting idle
+    work(0, rangeSize);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+//wMode < 0 uses each vector's own w, otherwise w is replaced with wMode
+static void _transformRange(const float* matrix, const Vector4* in, Vector4* out,
+                            size_t begin, size_t end, int wMode, bool stream) {
+
+#if defined(MATH_SSE)
+    //Columns are loaded once for the whole range, same add order as Matrix::operator *
+    __m128 col0 = _mm_load_ps(&matrix[0]);
+    __m128 col1 = _mm_load_ps(&matrix[4]);
+    __m128 col2 = _mm_load_ps(&matrix[8]);
+    __m128 col3 = _mm_load_ps(&matrix[12]);
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+    __m128 fixedW = _mm_set1_ps(static_cast<float>(wMode));
+
+    for (size_t i = begin; i < end; ++i) {
+        __m128 vector = _mm_load_ps(in[i].getFlatBuffer());
+        __m128 w = wMode < 0 ? _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3)) : fixedW;
+
+        __m128 result = _mm_mul_ps(col0, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm_add_ps(result, _mm_mul_ps(col1, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(col2, _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2))));
+        result = _mm_add_ps(result, _mm_mul_ps(col3, w));
+
+        float* output = out[i].getFlatBuffer();
+        if (stream) {
+            _mm_stream_ps(output, result);
+        }
+        else {
+            _mm_store_ps(output, result);
+        }
+    }
+    if (stream) {
+        _mm_sfence();
+    }
+#elif defined(MATH_NEON)
+    (void)stream; //Only the sse path has non temporal stores
+    float32x4x4_t columns = vld4q_f32(matrix);
+
+    for (size_t i = begin; i < end; ++i) {
+        float32x4_t vector = vld1q_f32(in[i].getFlatBuffer());
+        float w = wMode < 0 ? vgetq_lane_f32(vector, 3) : static_cast<float>(wMode);
+
+        float32x4_t result = vmulq_laneq_f32(columns.val[0], vector, 0);
+        result = vaddq_f32(result, vmulq_laneq_f32(columns.val[1], vector, 1));
+        result = vaddq_f32(result, vmulq_laneq_f32(columns.val[2], vector, 2));
+        result = vaddq_f32(result, vmulq_n_f32(columns.val[3], w));
+
+        vst1q_f32(out[i].getFlatBuffer(), result);
+    }
+#else
+    (void)stream;
+    for (size_t i = begin; i < end; ++i) {
+        const float* vector = in[i].getFlatBuffer();
+        float w = wMode < 0 ? vector[3] : static_cast<float>(wMode);
+
+        float x = matrix[0] * vector[0] + matrix[1] * vector[1] + matrix[2] * vector[2] + matrix[3] * w;
+        float y = matrix[4] * vector[0] + matrix[5] * vector[1] + matrix[6] * vector[2] + matrix[7] * w;
+        float z = matrix[8] * vector[0] + matrix[9] * vector[1] + matrix[10] * vector[2] + matrix[11] * w;
+        float t = matrix[12] * vector[0] + matrix[13] * vector[1] + matrix[14] * vector[2] + matrix[15] * w;
+
+        out[i] = Vector4(x, y, z, t);
+    }
+#endif
+}
+
+//Left and right strides of 0 reuse the same matrix for every product
+static void _multiplyRange(const Matrix* a, size_t aStride, const Matrix* b, size_t bStride, Matrix* out,
+                           size_t begin, size_t end) {
+
+    for (size_t i = begin; i < end; ++i) {
+        const float* left = a[i * aStride].getFlatBuffer();
+        const float* right = b[i * bStride].getFlatBuffer();
+        MATH_ALIGN float result[16];
+
+#if defined(MATH_SSE)
+        __m128 row0 = _mm_load_ps(&right[0]);
+        __m128 row1 = _mm_load_ps(&right[4]);
+        __m128 row2 = _mm_load_ps(&right[8]);
+        __m128 row3 = _mm_load_ps(&right[12]);
+
+        for (int j = 0; j < 16; j += 4) {
+            __m128 row = _mm_mul_ps(_mm_set1_ps(left[j]), row0);
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(left[j + 1]), row1));
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(left[j + 2]), row2));
+            row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(left[j + 3]), row3));
+            _mm_store_ps(&result[j], row);
+        }
+#elif defined(MATH_NEON)
+        float32x4_t row0 = vld1q_f32(&right[0]);
+        float32x4_t row1 = vld1q_f32(&right[4]);
+        float32x4_t row2 = vld1q_f32(&right[8]);
+        float32x4_t row3 = vld1q_f32(&right[12]);
+
+        for (int j = 0; j < 16; j += 4) {
+            float32x4_t row = vmulq_n_f32(row0, left[j]);
+            row = vaddq_f32(row, vmulq_n_f32(row1, left[j + 1]));
+            row = vaddq_f32(row, vmulq_n_f32(row2, left[j + 2]));
+            row = vaddq_f32(row, vmulq_n_f32(row3, left[j + 3]));
+            vst1q_f32(&result[j], row);
+        }
+#else
+        for (int j = 0; j < 16; j += 4) {
+            for (int k = 0; k < 4; ++k) {
+                result[j + k] = left[j] * right[k] + left[j + 1] * right[4 + k] +
+                                left[j + 2] * right[8 + k] + left[j + 3] * right[12 + k];
+            }
+        }
+#endif
+        MatrixType leftType = a[i * aStride].getType();
+        MatrixType rightType = b[i * bStride].getType();
+        out[i] = Matrix(result, leftType > rightType ? leftType : rightType);
+    }
+}
+
+static void _transform(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count, int wMode) {
+
+    const float* matrixBuffer = matrix.getFlatBuffer();
+    //Streaming stores only pay off when the output is too big to still be in cache once it gets read
+    bool stream = count >= BATCH_STREAM_COUNT;
+    _parallelRanges(count, [=](size_t begin, size_t end) {
+        _transformRange(matrixBuffer, in, out, begin, end, wMode, stream);
+    });
+}
+
+void BatchMath::transform(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count) {
+    _transform(matrix, in, out, count, -1);
+}
+
+void BatchMath::transformPoints(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count) {
+    _transform(matrix, in, out, count, 1);
+}
+
+void BatchMath::transformDirections(const Matrix& matrix, const Vector4* in, Vector4* out, size_t count) {
+    _transform(matrix, in, out, count, 0);
+}
+
+void BatchMath::transform(const Matrix& matrix, std::vector<Vector4>& in, std::vector<Vector4>& out) {
+    out.resize(in.size());
+    _transform(matrix, in.data(), out.data(), in.size(), -1);
+}
+
+void BatchMath::transformPoints(const Matrix& matrix, std::vector<Vector4>& in, std::vector<Vector4>& out) {
+    out.resize(in.size());
+    _transform(matrix, in.data(), out.data(), in.size(), 1);
+}
+
+void BatchMath::transformDirections(const Matrix& matrix, std::vector<Vector4>& in, std::vector<Vector4>& out) {
+    out.resize(in.size());
+    _transform(matrix, in.data(), out.data(), in.size(), 0);
+}
+
+void BatchMath::multiply(const Matrix* a, const Matrix* b, Matrix* out, size_t count) {
+    _parallelRanges(count, [=](size_t begin, size_t end) {
+        _multiplyRange(a, 1, b, 1, out, begin, end);
+    });
+}
+
+void BatchMath::multiply(const Matrix& a, const Matrix* b, Matrix* out, size_t count) {
+    const Matrix* left = &a;
+    _parallelRanges(count, [=](size_t begin, size_t end) {
+        _multiplyRange(left, 0, b, 1, out, begin, end);
+    });
+}
+
+void BatchMath::multiply(const Matrix* a, const Matrix& b, Matrix* out, size_t count) {
+    const Matrix* right = &b;
+    _parallelRanges(count, [=](size_t begin, size_t end) {
+        _multiplyRange(a, 1, right, 0, out, begin, end);
+    });
+}
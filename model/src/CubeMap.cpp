@@ -3,25 +3,15 @@
 
 CubeMap::CubeMap(unsigned int width, unsigned int height, bool isDepth) :
     _width(width),
-    _height(height) {
+    _height(height),
+    _isDepth(isDepth) {
 
     //Generate texture context
     glGenTextures(1, &_cubemap);
 
     //Bind the texture and create 6 sides of a texture cube
     glBindTexture(GL_TEXTURE_CUBE_MAP, _cubemap);
-    for (unsigned int i = 0; i < 6; ++i) {
-
-        //A depth or color buffer can be rendered to for a generic cube map
-        if (isDepth) {
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, _width, _height,
-                0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-        }
-        else {
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, _width, _height,
-                0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
-        }
-    }
+    _allocateFaces();
 
     //Texture params
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -64,10 +54,51 @@ CubeMap::CubeMap(unsigned int width, unsigned int height, bool isDepth) :
         //glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    //Single face frame buffers let a renderer redraw only the faces that changed
+    glGenFramebuffers(6, _faceFrameBuffers);
+    for (unsigned int i = 0; i < 6; ++i) {
+        glBindFramebuffer(GL_FRAMEBUFFER, _faceFrameBuffers[i]);
+        if (isDepth) {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, _cubemap, 0);
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+        else {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, _cubemap, 0);
+        }
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+void CubeMap::_allocateFaces() {
+
+    for (unsigned int i = 0; i < 6; ++i) {
+
+        //A depth or color buffer can be rendered to for a generic cube map
+        if (_isDepth) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, _width, _height,
+                0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+        }
+        else {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, _width, _height,
+                0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        }
+    }
+}
+
+void CubeMap::resize(unsigned int width, unsigned int height) {
+
+    _width = width;
+    _height = height;
+
+    //Respecifying the images keeps the texture name so the frame buffer attachments stay valid
+    glBindTexture(GL_TEXTURE_CUBE_MAP, _cubemap);
+    _allocateFaces();
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+}
+
 CubeMap::~CubeMap() {
 
 }
@@ -86,3 +117,7 @@ unsigned int CubeMap::getCubeFrameBufferContext() {
 unsigned int CubeMap::getCubeMapContext() {
     return _cubemap;
 }
+
+unsigned int CubeMap::getFaceFrameBufferContext(int face) {
+    return _faceFrameBuffers[face];
+}
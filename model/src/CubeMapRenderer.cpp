@@ -33,6 +33,11 @@ void CubeMapRenderer::preCubeFaceRender(std::vector<Model*> modelList, MVP* mvp)
         glDrawBuffers(1, buffers);
     }
 
+    buildFaceTransforms(mvp);
+}
+
+void CubeMapRenderer::buildFaceTransforms(MVP* mvp) {
+
     _transforms.clear();
     float* model = mvp->getModelMatrix().getFlatBuffer();
     Matrix position = Matrix::cameraTranslation(model[3], model[7], model[11]);
@@ -54,6 +59,41 @@ void CubeMapRenderer::preCubeFaceRender(std::vector<Model*> modelList, MVP* mvp)
     //Looking in -z direction
     //Need to rotate 180 degrees around z axis to align cube map texture correctly
     _transforms.push_back(proj * Matrix::rotationAroundZ(180.0f) * position);
+
+    _faceFrustums.clear();
+    for (Matrix& transform : _transforms) {
+        _faceFrustums.push_back(Frustum(transform));
+    }
+}
+
+int CubeMapRenderer::getFaceMask(Model* model) {
+    int faceMask = 0;
+    for (size_t face = 0; face < _faceFrustums.size(); face++) {
+        if (model->isVisible(_faceFrustums[face])) {
+            faceMask |= 1 << face;
+        }
+    }
+    return faceMask;
+}
+
+void CubeMapRenderer::bindCubeFace(int face) {
+
+    //Need to change viewport to the resolution of the shadow texture
+    glViewport(0, 0, _cubeTextureMap.getWidth(), _cubeTextureMap.getHeight());
+
+    //Bind only this face so the other five keep their contents
+    glBindFramebuffer(GL_FRAMEBUFFER, _cubeTextureMap.getFaceFrameBufferContext(face));
+
+    if (_isDepth) {
+        GLenum buffers[] = { GL_NONE };
+        glClear(GL_DEPTH_BUFFER_BIT);
+        glDrawBuffers(1, buffers);
+    }
+    else {
+        GLenum buffers[] = { GL_COLOR_ATTACHMENT0 };
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDrawBuffers(1, buffers);
+    }
 }
 
 void CubeMapRenderer::postCubeFaceRender() {
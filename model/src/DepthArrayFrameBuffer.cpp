@@ -0,0 +1,70 @@
+#include "DepthArrayFrameBuffer.h"
+
+DepthArrayFrameBuffer::DepthArrayFrameBuffer(unsigned int width, unsigned int height, unsigned int layers) :
+    _frameBufferContexts(layers),
+    _width(width), _height(height), _layers(layers) {
+
+    //Create the frame buffer texture context
+    glGenTextures(1, &_fbTextureContext);
+
+    //Bind current texture context
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _fbTextureContext);
+
+    //Immutable 32 bit depth storage for every layer, the frame buffers populate the data
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32, _width, _height, _layers);
+
+    //texture filter parameters
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    //remove texture context
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    //Generate a context for each layer's frame buffer
+    glGenFramebuffers(_layers, _frameBufferContexts.data());
+
+    for (GLuint layer = 0; layer < _layers; layer++) {
+
+        //Bind the frame buffer context to complete operations on it
+        glBindFramebuffer(GL_FRAMEBUFFER, _frameBufferContexts[layer]);
+
+        //Attach a single layer of the array as the depth buffer
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, _fbTextureContext, 0, layer);
+
+        //Tells opengl that the frame buffer will not have a color buffer
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+
+        //check the frame buffer's health
+        GLuint status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            std::cout << "Frame buffer cannot be generated! Status: " << status << std::endl;
+        }
+    }
+
+    //remove framebuffer context
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+DepthArrayFrameBuffer::~DepthArrayFrameBuffer() {
+    glDeleteFramebuffers(_layers, _frameBufferContexts.data());
+    glDeleteTextures(1, &_fbTextureContext);
+}
+
+GLuint DepthArrayFrameBuffer::getFrameBufferContext(unsigned int layer) {
+    return _frameBufferContexts[layer];
+}
+GLuint DepthArrayFrameBuffer::getTextureContext() {
+    return _fbTextureContext;
+}
+GLuint DepthArrayFrameBuffer::getWidth() {
+    return _width;
+}
+GLuint DepthArrayFrameBuffer::getHeight() {
+    return _height;
+}
+GLuint DepthArrayFrameBuffer::getLayers() {
+    return _layers;
+}
@@ -0,0 +1,194 @@
+#include "DrawList.h"
+#include "StaticShader.h"
+#include "Model.h"
+#include "World.h"
+#include <string.h>
+
+//Bit widths of each key field, most significant first
+const int      KEY_PASS_BITS     = 4;
+const int      KEY_SHADER_BITS   = 12;
+const int      KEY_MATERIAL_BITS = 16;
+const int      KEY_VAO_BITS      = 12;
+const int      KEY_DEPTH_BITS    = 20;
+const int      RADIX_BITS        = 8;
+const int      RADIX_BUCKETS     = 1 << RADIX_BITS;
+const int      RADIX_PASSES      = 64 / RADIX_BITS;
+
+DrawList::DrawList() {
+
+}
+
+DrawList::~DrawList() {
+
+}
+
+uint64_t DrawList::makeKey(DrawPass pass, GLuint shader, uint32_t material, GLuint vao, float depth) {
+
+    //Bits of a non negative float sort the same way as its value so the top bits of the
+    //distance quantize depth without knowing the far plane
+    uint32_t depthBits = 0;
+    if (depth > 0.0f) {
+        memcpy(&depthBits, &depth, sizeof(float));
+        depthBits >>= 31 - KEY_DEPTH_BITS;
+    }
+
+    uint64_t key = static_cast<uint64_t>(pass) & ((1 << KEY_PASS_BITS) - 1);
+    key = (key << KEY_SHADER_BITS) | (shader & ((1 << KEY_SHADER_BITS) - 1));
+    key = (key << KEY_MATERIAL_BITS) | (material & ((1 << KEY_MATERIAL_BITS) - 1));
+    key = (key << KEY_VAO_BITS) | (vao & ((1 << KEY_VAO_BITS) - 1));
+    key = (key << KEY_DEPTH_BITS) | (depthBits & ((1 << KEY_DEPTH_BITS) - 1));
+    return key;
+}
+
+void DrawList::add(uint64_t key, const DrawCommand& command) {
+    SortEntry entry = { key, static_cast<uint32_t>(_commands.size()) };
+    _entries.push_back(entry);
+    _commands.push_back(command);
+}
+
+void DrawList::append(const DrawList& drawList) {
+
+    uint32_t base = static_cast<uint32_t>(_commands.size());
+    _commands.insert(_commands.end(), drawList._commands.begin(), drawList._commands.end());
+    for (const SortEntry& entry : drawList._entries) {
+        SortEntry merged = { entry.key, entry.command + base };
+        _entries.push_back(merged);
+    }
+}
+
+void DrawList::sort() {
+
+    size_t count = _entries.size();
+    if (count < 2) {
+        return;
+    }
+
+    //One sweep builds the histograms of every byte
+    uint32_t histograms[RADIX_PASSES][RADIX_BUCKETS];
+    memset(histograms, 0, sizeof(histograms));
+    for (SortEntry& entry : _entries) {
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    _scratch.resize(count);
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+
+        uint32_t* histogram = histograms[pass];
+        int shift = pass * RADIX_BITS;
+
+        //Every key has the same byte so this pass would not move anything
+        if (histogram[(_entries[0].key >> shift) & (RADIX_BUCKETS - 1)] == count) {
+            continue;
+        }
+
+        uint32_t offsets[RADIX_BUCKETS];
+        uint32_t sum = 0;
+        for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+            offsets[bucket] = sum;
+            sum += histogram[bucket];
+        }
+        for (SortEntry& entry : _entries) {
+            _scratch[offsets[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+        }
+        _entries.swap(_scratch);
+    }
+}
+
+void DrawList::submit() {
+
+    sort();
+
+    size_t count = _entries.size();
+    if (count == 0) {
+        return;
+    }
+
+    GeometryArena* arena = World::current()->getGeometryArena();
+    arena->reserveDrawIndices(count);
+
+    //Every draw's model matrix and indirect command go out in one range each, the base instance
+    //of a command is the draw's index so the vertex shader finds its matrix through the draw index attribute
+    StreamBuffer* drawConstants = arena->getDrawConstantBuffer();
+    StreamBuffer* commandBuffer = arena->getCommandBuffer();
+    size_t constantsSize = count * 16 * sizeof(float);
+    size_t constantsOffset = 0;
+    size_t commandsOffset = 0;
+    float* matrices = static_cast<float*>(drawConstants->map(constantsSize, arena->getStorageAlignment(), constantsOffset));
+    DrawElementsIndirectCommand* indirectCommands = static_cast<DrawElementsIndirectCommand*>(
+        commandBuffer->map(count * sizeof(DrawElementsIndirectCommand), sizeof(GLuint), commandsOffset));
+
+    for (size_t i = 0; i < count; i++) {
+        DrawCommand& command = _commands[_entries[i].command];
+        memcpy(matrices + i * 16, command.model->getMVP()->getModelBuffer(), 16 * sizeof(float));
+
+        DrawElementsIndirectCommand& indirect = indirectCommands[i];
+        indirect.count = static_cast<GLuint>(command.count);
+        indirect.instanceCount = 1;
+        indirect.firstIndex = command.first;
+        indirect.baseVertex = command.baseVertex;
+        indirect.baseInstance = static_cast<GLuint>(i);
+    }
+    drawConstants->unmap();
+    commandBuffer->unmap();
+
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, DRAW_CONSTANTS_BINDING, drawConstants->getContext(), constantsOffset, constantsSize);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer->getContext());
+
+    StaticShader*   shader = nullptr;
+    GLuint          vao = 0;
+    const Material* material = nullptr;
+
+    size_t first = 0;
+    while (first < count) {
+        DrawCommand& command = _commands[_entries[first].command];
+
+        //Draws are sorted by state so everything sharing it follows in one run
+        size_t last = first + 1;
+        while (last < count) {
+            DrawCommand& next = _commands[_entries[last].command];
+            if (next.shader != command.shader || next.vao != command.vao || next.material != command.material) {
+                break;
+            }
+            last++;
+        }
+
+        //A new program loses the uniforms set for the previous one
+        if (command.shader != shader) {
+            shader = command.shader;
+            shader->bindProgram();
+            material = nullptr;
+        }
+        if (command.vao != vao) {
+            vao = command.vao;
+            glBindVertexArray(vao);
+        }
+        if (command.material != material) {
+            material = command.material;
+            shader->bindMaterial(material);
+        }
+
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                    reinterpret_cast<void*>(commandsOffset + first * sizeof(DrawElementsIndirectCommand)),
+                                    static_cast<GLsizei>(last - first), 0);
+        first = last;
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    shader->unbind();
+    clear();
+}
+
+void DrawList::clear() {
+    _commands.clear();
+    _entries.clear();
+}
+
+size_t DrawList::size() {
+    return _entries.size();
+}
+
+const DrawCommand& DrawList::getCommand(size_t sortedIndex) {
+    return _commands[_entries[sortedIndex].command];
+}
@@ -0,0 +1,100 @@
+#include "DrawRecorder.h"
+#include "World.h"
+
+DrawRecorder::DrawRecorder(unsigned int threadCount) :
+    _world(nullptr),
+    _count(0),
+    _next(0),
+    _busy(0),
+    _generation(0),
+    _quit(false) {
+
+    //The calling thread records too so leave it a core
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    //Lists are sized before any worker starts so their addresses never change
+    _lists.resize(threadCount + 1);
+    for (unsigned int worker = 0; worker < threadCount; worker++) {
+        _workers.push_back(std::thread(&DrawRecorder::_workerLoop, this, static_cast<size_t>(worker)));
+    }
+}
+
+DrawRecorder::~DrawRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _quit = true;
+    }
+    _start.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+void DrawRecorder::_recordBatches(DrawList* drawList) {
+
+    size_t first = _next.fetch_add(RECORD_BATCH_SIZE);
+    while (first < _count) {
+        size_t last = first + RECORD_BATCH_SIZE < _count ? first + RECORD_BATCH_SIZE : _count;
+        for (size_t index = first; index < last; index++) {
+            _work(index, drawList);
+        }
+        first = _next.fetch_add(RECORD_BATCH_SIZE);
+    }
+}
+
+void DrawRecorder::_workerLoop(size_t worker) {
+
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _start.wait(lock, [&]() { return _quit || _generation != generation; });
+            if (_quit) {
+                return;
+            }
+            generation = _generation;
+            _world->makeCurrent();
+        }
+
+        _recordBatches(&_lists[worker]);
+
+        std::lock_guard<std::mutex> lock(_lock);
+        if (--_busy == 0) {
+            _done.notify_one();
+        }
+    }
+}
+
+void DrawRecorder::record(size_t count, RecordWork work) {
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _work = work;
+        _world = World::current();
+        _count = count;
+        _next = 0;
+        _busy = _workers.size();
+        _generation++;
+    }
+    _start.notify_all();
+
+    //Instead of waiting idle the calling thread takes batches too
+    _recordBatches(&_lists.back());
+
+    std::unique_lock<std::mutex> lock(_lock);
+    _done.wait(lock, [&]() { return _busy == 0; });
+}
+
+void DrawRecorder::gather(DrawList* drawList) {
+    for (DrawList& list : _lists) {
+        drawList->append(list);
+        list.clear();
+    }
+}
+
+size_t DrawRecorder::getThreadCount() {
+    return _lists.size();
+}
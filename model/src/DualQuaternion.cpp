@@ -0,0 +1,93 @@
+#include "DualQuaternion.h"
+
+DualQuaternion::DualQuaternion() :
+    _real(),
+    _dual(0.0f, 0.0f, 0.0f, 0.0f) {
+}
+
+DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) :
+    _real(real),
+    _dual(dual) {
+}
+
+DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vector4& translation) :
+    _real(rotation) {
+
+    const float* t = translation.getFlatBuffer();
+    _dual = Quaternion(t[0], t[1], t[2], 0.0f) * rotation * 0.5f;
+}
+
+DualQuaternion::DualQuaternion(const Matrix& rigid) {
+    const float* m = rigid.getFlatBuffer();
+    *this = DualQuaternion(Quaternion(rigid), Vector4(m[3], m[7], m[11], 0.0f));
+}
+
+Quaternion& DualQuaternion::getReal() {
+    return _real;
+}
+
+Quaternion& DualQuaternion::getDual() {
+    return _dual;
+}
+
+Quaternion DualQuaternion::getRotation() const {
+    return _real;
+}
+
+Vector4 DualQuaternion::getTranslation() const {
+    Quaternion translation = _dual * _real.conjugate() * 2.0f;
+    return Vector4(translation.getx(), translation.gety(), translation.getz(), 1.0f);
+}
+
+DualQuaternion DualQuaternion::operator * (const DualQuaternion& other) const {
+    return DualQuaternion(_real * other._real, _real * other._dual + _dual * other._real);
+}
+
+DualQuaternion DualQuaternion::operator * (float scale) const {
+    return DualQuaternion(_real * scale, _dual * scale);
+}
+
+DualQuaternion DualQuaternion::operator + (const DualQuaternion& other) const {
+    return DualQuaternion(_real + other._real, _dual + other._dual);
+}
+
+void DualQuaternion::normalize() {
+    float magnitude = _real.getMagnitude();
+    if (magnitude == 0.0f) {
+        return;
+    }
+    _real = _real * (1.0f / magnitude);
+    _dual = _dual * (1.0f / magnitude);
+}
+
+DualQuaternion DualQuaternion::conjugate() const {
+    return DualQuaternion(_real.conjugate(), _dual.conjugate());
+}
+
+Vector4 DualQuaternion::transform(const Vector4& point) const {
+    Vector4 rotated = _real.rotate(point);
+    Vector4 translation = getTranslation();
+    return Vector4(rotated.getx() + translation.getx(),
+                   rotated.gety() + translation.gety(),
+                   rotated.getz() + translation.getz(),
+                   rotated.getw());
+}
+
+Matrix DualQuaternion::toMatrix() const {
+    Matrix matrix = _real.toMatrix();
+    Vector4 translation = getTranslation();
+    float* m = matrix.getFlatBuffer();
+    m[3] = translation.getx();
+    m[7] = translation.gety();
+    m[11] = translation.getz();
+    matrix.setType(MatrixType::Rigid);
+    return matrix;
+}
+
+DualQuaternion DualQuaternion::nlerp(const DualQuaternion& a, const DualQuaternion& b, float t) {
+    //Flip b when the rotations are in opposite hemispheres so the blend takes the short way around
+    float weightB = a._real.dotProduct(b._real) < 0.0f ? -t : t;
+    DualQuaternion result = a * (1.0f - t) + b * weightB;
+    result.normalize();
+    return result;
+}
@@ -17,7 +17,7 @@ void EnvironmentMap::render(std::vector<Model*> modelList, MVP* mvp) {
     preCubeFaceRender(modelList, mvp);
 
     for (Model* model : modelList) {
-        if (model->getClassType() == ModelClass::ModelType) {
+        if (model->getClassType() == ModelClass::ModelType && getFaceMask(model) != 0) {
             _environmentShader.runShader(model, _transforms);
         }
     }
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <limits>
 #include "RenderBuffers.h"
+#include "BatchMath.h"
 
 FbxLoader::FbxLoader(std::string name) {
     _fbxManager = FbxManager::Create();
@@ -275,34 +276,21 @@ void FbxLoader::_buildGeometryData(Model* model, std::vector<Vector4>& vertices,
     Matrix translation = Matrix::translation(static_cast<float>(TBuff[0]), static_cast<float>(TBuff[1]), static_cast<float>(TBuff[2]));
     Matrix scale = Matrix::scale(static_cast<float>(SBuff[0]), static_cast<float>(SBuff[1]), static_cast<float>(SBuff[2]));
 
-    int triCount = 0;
     Matrix transformation = translation * rotation * scale;
 
     if(model->getGeometryType() == GeometryType::Triangle){
-        size_t totalTriangles = indices.size() / 3; //Each index represents one vertex and a triangle is 3 vertices
-        //Read each triangle vertex indices and store them in triangle array
-        for (int i = 0; i < totalTriangles; i++) {
-
-            Vector4 A(vertices[indices[triCount]].getx(),
-                vertices[indices[triCount]].gety(),
-                vertices[indices[triCount]].getz(),
-                1.0);
-            triCount++;
-
-            Vector4 B(vertices[indices[triCount]].getx(),
-                vertices[indices[triCount]].gety(),
-                vertices[indices[triCount]].getz(),
-                1.0);
-            triCount++;
+        size_t totalVertices = (indices.size() / 3) * 3; //Each index represents one vertex and a triangle is 3 vertices
 
-            Vector4 C(vertices[indices[triCount]].getx(),
-                vertices[indices[triCount]].gety(),
-                vertices[indices[triCount]].getz(),
-                1.0);
-            triCount++;
+        //Read each triangle vertex indices and transform them all in one pass
+        std::vector<Vector4> positions(totalVertices);
+        for (size_t i = 0; i < totalVertices; i++) {
+            positions[i] = vertices[indices[i]];
+        }
+        BatchMath::transformPoints(transformation, positions, positions);
 
+        for (size_t i = 0; i < totalVertices; i += 3) {
             //Add triangle to geometry object stored in model class
-            model->addGeometryTriangle(Triangle(transformation * A, transformation * B, transformation * C));
+            model->addGeometryTriangle(Triangle(positions[i], positions[i + 1], positions[i + 2]));
         }
     }
     else if(model->getGeometryType() == GeometryType::Sphere){
@@ -647,59 +635,26 @@ void FbxLoader::_buildTriangles(Model* model, std::vector<Vector4>& vertices, st
     Matrix translation = Matrix::translation(static_cast<float>(TBuff[0]), static_cast<float>(TBuff[1]), static_cast<float>(TBuff[2]));
     Matrix scale = Matrix::scale(static_cast<float>(SBuff[0]), static_cast<float>(SBuff[1]), static_cast<float>(SBuff[2]));
 
-    int triCount = 0;
     Matrix transformation = translation * rotation * scale;
 
-    size_t totalTriangles = indices.size() / 3; //Each index represents one vertex and a triangle is 3 vertices
-    //Read each triangle vertex indices and store them in triangle array
-    for (int i = 0; i < totalTriangles; i++) {
-        Vector4 A(vertices[indices[triCount]].getx(),
-            vertices[indices[triCount]].gety(),
-            vertices[indices[triCount]].getz(),
-            1.0);
-        renderBuffers->addVertex(transformation * A); //Scale then rotate vertex
-
-        Vector4 AN(normals[indices[triCount]].getx(),
-            normals[indices[triCount]].gety(),
-            normals[indices[triCount]].getz(),
-            1.0);
-        renderBuffers->addNormal(rotation * AN); //Scale then rotate normal
-        renderBuffers->addTexture(textures[triCount]);
-        renderBuffers->addDebugNormal(transformation * A);
-        renderBuffers->addDebugNormal((transformation * A) + (rotation * AN));
-        triCount++;
-
-        Vector4 B(vertices[indices[triCount]].getx(),
-            vertices[indices[triCount]].gety(),
-            vertices[indices[triCount]].getz(),
-            1.0);
-        renderBuffers->addVertex(transformation * B); //Scale then rotate vertex
-
-        Vector4 BN(normals[indices[triCount]].getx(),
-            normals[indices[triCount]].gety(),
-            normals[indices[triCount]].getz(),
-            1.0);
-        renderBuffers->addNormal(rotation * BN); //Scale then rotate normal
-        renderBuffers->addTexture(textures[triCount]);
-        renderBuffers->addDebugNormal(transformation * B);
-        renderBuffers->addDebugNormal((transformation * B) + (rotation * BN));
-        triCount++;
-
-        Vector4 C(vertices[indices[triCount]].getx(),
-            vertices[indices[triCount]].gety(),
-            vertices[indices[triCount]].getz(),
-            1.0);
-        renderBuffers->addVertex(transformation * C); //Scale then rotate vertex
-
-        Vector4 CN(normals[indices[triCount]].getx(),
-            normals[indices[triCount]].gety(),
-            normals[indices[triCount]].getz(),
-            1.0);
-        renderBuffers->addNormal(rotation * CN); //Scale then rotate normal
-        renderBuffers->addTexture(textures[triCount]);
-        renderBuffers->addDebugNormal(transformation * C);
-        renderBuffers->addDebugNormal((transformation * C) + (rotation * CN));
-        triCount++;
+    size_t totalVertices = (indices.size() / 3) * 3; //Each index represents one vertex and a triangle is 3 vertices
+
+    //Gather the indexed vertices and normals so each array is transformed in one pass
+    std::vector<Vector4> positions(totalVertices);
+    std::vector<Vector4> directions(totalVertices);
+    for (size_t i = 0; i < totalVertices; i++) {
+        positions[i] = vertices[indices[i]];
+        directions[i] = normals[indices[i]];
+    }
+    BatchMath::transformPoints(transformation, positions, positions); //Scale then rotate vertex
+    BatchMath::transformPoints(rotation, directions, directions); //Scale then rotate normal
+
+    for (size_t i = 0; i < totalVertices; i++) {
+        renderBuffers->addVertex(positions[i]);
+        renderBuffers->addNormal(directions[i]);
+        renderBuffers->addTexture(textures[i]);
+        renderBuffers->addDebugNormal(positions[i]);
+        renderBuffers->addDebugNormal(positions[i] + directions[i]);
     }
 }
 
@@ -7,7 +7,6 @@
 #include <cassert>
 #include <vector>
 #include "font.h"
-#include "TextureBroker.h"
 
 struct vec2
 {
@@ -121,37 +120,27 @@ extern const int screenPixelHeight;
 const float ratio = static_cast<float>(screenPixelHeight) / screenPixelWidth;
 
 FontRenderer::FontRenderer(std::string fileName)
-    : fontShader("font")
+    : fontShader("font"),
+      streamBuffer(GL_ARRAY_BUFFER, bufferSize * sizeof(FontVertex))
 {
     string fullPath = FONT_LOCATION + fileName;
     parseFontFile(fullPath, fontInfo);
 
-    TextureBroker* pTb = TextureBroker::instance();
-    pTb->addTexture("../assets/textures/font/ubuntu_mono_regular_0.png");
-    
-    // create vertex buffer
+    // create vertex array, the attributes are pointed at the stream buffer every draw
     glGenVertexArrays(1, &vao);
     glBindVertexArray(vao);
-
-    glGenBuffers(1, &vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, 3 * bufferSize * sizeof(float), NULL, GL_DYNAMIC_DRAW);
-
-    glGenBuffers(1, &texCoordsVbo);
-    glBindBuffer(GL_ARRAY_BUFFER, texCoordsVbo);
-    glBufferData(GL_ARRAY_BUFFER, 2 * bufferSize * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-    glBindBuffer(GL_ARRAY_BUFFER, texCoordsVbo);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
     glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void FontRenderer::DrawFont(float x, float y, std::string s, uint64_t timeDelta)
 {
+    if (s.empty())
+    {
+        return;
+    }
+
     float cursorAdvance = 0;
     float scale = 300;
 
@@ -159,11 +148,14 @@ void FontRenderer::DrawFont(float x, float y, std::string s, uint64_t timeDelta)
     x -= 1;
     y += 1;
 
-    static vec3 vb[65536];
-    static vec2 tcb[65536];
-
-    vec3* pvb = vb;
-    vec2* ptcb = tcb;
+    // glyphs are written straight into this frame's region of the ring
+    size_t offset = 0;
+    FontVertex* pvb = static_cast<FontVertex*>(streamBuffer.map(6 * s.size() * sizeof(FontVertex), sizeof(FontVertex), offset));
+    if (pvb == nullptr)
+    {
+        streamBuffer.unmap();
+        return;
+    }
 
     for (int i = 0; i < s.size(); i++)
     {
@@ -197,8 +189,6 @@ void FontRenderer::DrawFont(float x, float y, std::string s, uint64_t timeDelta)
         cursorPosition[4].y += sin(cursorPosition[0].x * 10)/ 15;
         cursorPosition[5].y += sin(cursorPosition[0].x * 10)/ 15;
 
-
-
         // generate text coordinates
         vec2 bottomLeft = { fontInfo.chars[asciiVal].x / 256.0f, 1.0f - (fontInfo.chars[asciiVal].y + fontInfo.chars[asciiVal].height) / 256.0f };
         vec2 topRight = { (fontInfo.chars[asciiVal].x + fontInfo.chars[asciiVal].width) / 256.0f, 1.0f - fontInfo.chars[asciiVal].y / 256.0f };
@@ -208,45 +198,26 @@ void FontRenderer::DrawFont(float x, float y, std::string s, uint64_t timeDelta)
         vec2 texCoords[] = { bottomLeft, topLeft, topRight, topRight, bottomRight, bottomLeft };
 
         // copy quad
-        memcpy_s(pvb, sizeof(cursorPosition), cursorPosition, sizeof(cursorPosition));
-
-        memcpy_s(ptcb, sizeof(texCoords), texCoords, sizeof(texCoords));
-        size_t increment = sizeof(cursorPosition);
+        for (int vertex = 0; vertex < 6; vertex++)
+        {
+            pvb[vertex] = { cursorPosition[vertex].x, cursorPosition[vertex].y, cursorPosition[vertex].z,
+                            texCoords[vertex].x, texCoords[vertex].y };
+        }
         pvb += 6;
-        ptcb += 6;
 
         cursorAdvance += advance - xoffset;
     }
+    streamBuffer.unmap();
 
+    // the buffer can be reallocated when it grows so point the attributes at it every draw,
+    // the offset is a whole number of vertices and is passed as the first vertex instead
     glBindVertexArray(vao);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glCheck();
-
-    float* pData = (float*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-    glCheck();
-
-    if (pData)
-    {
-        memcpy_s(pData, 18 * sizeof(float) * s.size(), vb, 18 * sizeof(float) * s.size());
-        glUnmapBuffer(GL_ARRAY_BUFFER);
-        glCheck();
-    }
-
-    glBindBuffer(GL_ARRAY_BUFFER, texCoordsVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, streamBuffer.getContext());
     glCheck();
-    pData = (float*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-    if (pData)
-    {
-        memcpy_s(pData, 12 * sizeof(float) * s.size(), tcb, 12 * sizeof(float) * s.size());
-        glUnmapBuffer(GL_ARRAY_BUFFER);
-    }
-
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(FontVertex), NULL);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(FontVertex), reinterpret_cast<void*>(3 * sizeof(float)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glCheck();
 
-    fontShader.runShader(vao, s);
+    fontShader.runShader(vao, static_cast<GLint>(offset / sizeof(FontVertex)), 6 * static_cast<GLsizei>(s.size()));
 }
-
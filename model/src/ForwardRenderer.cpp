@@ -1,5 +1,6 @@
 #include "ForwardRenderer.h"
 #include "Model.h"
+#include "ViewManager.h"
 
 ForwardRenderer::ForwardRenderer() :
     _forwardShader("forwardShader"),
@@ -12,15 +13,20 @@ ForwardRenderer::~ForwardRenderer() {
 }
 
 void ForwardRenderer::forwardLighting(std::vector<Model*>& modelList, ViewManager* viewManager, ShadowRenderer* shadowRenderer,
-    std::vector<Light*>& lights, PointShadowMap* pointShadowMap) {
+    std::vector<Light*>& lights, PointShadowMap* pointShadowMap, const OcclusionBuffer* occlusionBuffer) {
 
+    Frustum frustum(viewManager->getProjection() * viewManager->getView());
     for (auto model : modelList) {
 
+        if (!model->isVisible(frustum)) {
+            continue;
+        }
+
         if (!model->getIsInstancedModel()) {
             _forwardShader.runShader(model, viewManager, shadowRenderer, lights, pointShadowMap);
         }
         else {
-            _instancedForwardShader.runShader(model, viewManager, shadowRenderer, lights, pointShadowMap);
+            _instancedForwardShader.runShader(model, viewManager, shadowRenderer, lights, pointShadowMap, occlusionBuffer);
         }
     }
 }
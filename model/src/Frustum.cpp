@@ -0,0 +1,257 @@
+#include "Frustum.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(MATH_SSE)
+typedef __m128 Lanes;
+typedef __m128 LaneMask;
+
+static inline Lanes _load(const float* values) { return _mm_load_ps(values); }
+static inline Lanes _loadUnaligned(const float* values) { return _mm_loadu_ps(values); }
+static inline Lanes _add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+static inline Lanes _mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+static inline Lanes _abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+static inline Lanes _negate(Lanes a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+static inline LaneMask _noLanes() { return _mm_setzero_ps(); }
+static inline LaneMask _lessThan(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+static inline LaneMask _or(LaneMask a, LaneMask b) { return _mm_or_ps(a, b); }
+static inline uint32_t _bits(LaneMask mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+static inline void _transpose(Lanes& r0, Lanes& r1, Lanes& r2, Lanes& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+#elif defined(MATH_NEON)
+typedef float32x4_t Lanes;
+typedef uint32x4_t  LaneMask;
+
+static inline Lanes _load(const float* values) { return vld1q_f32(values); }
+static inline Lanes _loadUnaligned(const float* values) { return vld1q_f32(values); }
+static inline Lanes _add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+static inline Lanes _mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+static inline Lanes _abs(Lanes a) { return vabsq_f32(a); }
+static inline Lanes _negate(Lanes a) { return vnegq_f32(a); }
+static inline LaneMask _noLanes() { return vdupq_n_u32(0); }
+static inline LaneMask _lessThan(Lanes a, Lanes b) { return vcltq_f32(a, b); }
+static inline LaneMask _or(LaneMask a, LaneMask b) { return vorrq_u32(a, b); }
+static inline uint32_t _bits(LaneMask mask) {
+    const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(mask, vld1q_u32(laneBits)));
+}
+static inline void _transpose(Lanes& r0, Lanes& r1, Lanes& r2, Lanes& r3) {
+    float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    float32x4x2_t t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
+
+Frustum::Frustum() : Frustum(Matrix()) {
+}
+
+Frustum::Frustum(const Matrix& viewProjection) {
+
+    //Gribb/Hartmann, a point is inside when -w <= x, y, z <= w in clip space so each plane
+    //is the last row of the matrix plus or minus one of the other rows
+    const float* m = viewProjection.getFlatBuffer();
+    for (int i = 0; i < 4; i++) {
+        _planes[static_cast<int>(FrustumPlane::Left)][i] = m[12 + i] + m[i];
+        _planes[static_cast<int>(FrustumPlane::Right)][i] = m[12 + i] - m[i];
+        _planes[static_cast<int>(FrustumPlane::Bottom)][i] = m[12 + i] + m[4 + i];
+        _planes[static_cast<int>(FrustumPlane::Top)][i] = m[12 + i] - m[4 + i];
+        _planes[static_cast<int>(FrustumPlane::Near)][i] = m[12 + i] + m[8 + i];
+        _planes[static_cast<int>(FrustumPlane::Far)][i] = m[12 + i] - m[8 + i];
+    }
+    _normalize();
+}
+
+void Frustum::_normalize() {
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+        float* p = _planes[plane];
+        float length = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (length > 0.0f) {
+            p[0] /= length;
+            p[1] /= length;
+            p[2] /= length;
+            p[3] /= length;
+        }
+        for (int i = 0; i < 4; i++) {
+            for (int lane = 0; lane < 4; lane++) {
+                _planeSplats[plane][i][lane] = p[i];
+            }
+        }
+    }
+}
+
+const float* Frustum::getPlane(FrustumPlane plane) const {
+    return _planes[static_cast<int>(plane)];
+}
+
+bool Frustum::sphereVisible(const Vector4& center, float radius) const {
+    const float* c = center.getFlatBuffer();
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+        const float* p = _planes[plane];
+        if (p[0] * c[0] + p[1] * c[1] + p[2] * c[2] + p[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::aabbVisible(const Vector4& center, const Vector4& halfExtent) const {
+    const float* c = center.getFlatBuffer();
+    const float* e = halfExtent.getFlatBuffer();
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+        const float* p = _planes[plane];
+        //Box's reach towards the plane normal
+        float radius = fabsf(p[0]) * e[0] + fabsf(p[1]) * e[1] + fabsf(p[2]) * e[2];
+        if (p[0] * c[0] + p[1] * c[1] + p[2] * c[2] + p[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::obbVisible(const Matrix& transform) const {
+    //Columns of the upper 3x3 are the box's half axes and the last column is its center
+    const float* m = transform.getFlatBuffer();
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+        const float* p = _planes[plane];
+        float radius = fabsf(p[0] * m[0] + p[1] * m[4] + p[2] * m[8]) +
+                       fabsf(p[0] * m[1] + p[1] * m[5] + p[2] * m[9]) +
+                       fabsf(p[0] * m[2] + p[1] * m[6] + p[2] * m[10]);
+        if (p[0] * m[3] + p[1] * m[7] + p[2] * m[11] + p[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Frustum::maskWords(size_t count) {
+    return (count + 31) / 32;
+}
+
+void Frustum::testSpheres(const Vector4* centers, const float* radii, size_t count, uint32_t* visibleMasks) const {
+
+    memset(visibleMasks, 0, maskWords(count) * sizeof(uint32_t));
+    size_t i = 0;
+
+#if defined(MATH_SSE) || defined(MATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        Lanes x = _load(centers[i].getFlatBuffer());
+        Lanes y = _load(centers[i + 1].getFlatBuffer());
+        Lanes z = _load(centers[i + 2].getFlatBuffer());
+        Lanes w = _load(centers[i + 3].getFlatBuffer());
+        _transpose(x, y, z, w);
+        Lanes negativeRadius = _negate(_loadUnaligned(&radii[i]));
+
+        LaneMask outside = _noLanes();
+        for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+            const float(*splat)[4] = _planeSplats[plane];
+            Lanes distance = _add(_add(_add(_mul(_load(splat[0]), x), _mul(_load(splat[1]), y)),
+                                       _mul(_load(splat[2]), z)), _load(splat[3]));
+            outside = _or(outside, _lessThan(distance, negativeRadius));
+            if (_bits(outside) == 0xF) {
+                break;
+            }
+        }
+        visibleMasks[i / 32] |= (~_bits(outside) & 0xF) << (i % 32);
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (sphereVisible(centers[i], radii[i])) {
+            visibleMasks[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+void Frustum::testAABBs(const Vector4* centers, const Vector4* halfExtents, size_t count, uint32_t* visibleMasks) const {
+
+    memset(visibleMasks, 0, maskWords(count) * sizeof(uint32_t));
+    size_t i = 0;
+
+#if defined(MATH_SSE) || defined(MATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        Lanes x = _load(centers[i].getFlatBuffer());
+        Lanes y = _load(centers[i + 1].getFlatBuffer());
+        Lanes z = _load(centers[i + 2].getFlatBuffer());
+        Lanes w = _load(centers[i + 3].getFlatBuffer());
+        _transpose(x, y, z, w);
+        Lanes ex = _load(halfExtents[i].getFlatBuffer());
+        Lanes ey = _load(halfExtents[i + 1].getFlatBuffer());
+        Lanes ez = _load(halfExtents[i + 2].getFlatBuffer());
+        Lanes ew = _load(halfExtents[i + 3].getFlatBuffer());
+        _transpose(ex, ey, ez, ew);
+
+        LaneMask outside = _noLanes();
+        for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+            const float(*splat)[4] = _planeSplats[plane];
+            Lanes nx = _load(splat[0]);
+            Lanes ny = _load(splat[1]);
+            Lanes nz = _load(splat[2]);
+            Lanes radius = _add(_add(_mul(_abs(nx), ex), _mul(_abs(ny), ey)), _mul(_abs(nz), ez));
+            Lanes distance = _add(_add(_add(_mul(nx, x), _mul(ny, y)), _mul(nz, z)), _load(splat[3]));
+            outside = _or(outside, _lessThan(distance, _negate(radius)));
+            //All four already culled
+            if (_bits(outside) == 0xF) {
+                break;
+            }
+        }
+        visibleMasks[i / 32] |= (~_bits(outside) & 0xF) << (i % 32);
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (aabbVisible(centers[i], halfExtents[i])) {
+            visibleMasks[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+void Frustum::testOBBs(const Matrix* transforms, size_t count, uint32_t* visibleMasks) const {
+
+    memset(visibleMasks, 0, maskWords(count) * sizeof(uint32_t));
+    size_t i = 0;
+
+#if defined(MATH_SSE) || defined(MATH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        //Transposing each matrix row across the four boxes gives one lane per box
+        Lanes axis[3][3];
+        Lanes center[3];
+        for (int row = 0; row < 3; row++) {
+            Lanes a = _load(&transforms[i].getFlatBuffer()[row * 4]);
+            Lanes b = _load(&transforms[i + 1].getFlatBuffer()[row * 4]);
+            Lanes c = _load(&transforms[i + 2].getFlatBuffer()[row * 4]);
+            Lanes d = _load(&transforms[i + 3].getFlatBuffer()[row * 4]);
+            _transpose(a, b, c, d);
+            axis[0][row] = a;
+            axis[1][row] = b;
+            axis[2][row] = c;
+            center[row] = d;
+        }
+
+        LaneMask outside = _noLanes();
+        for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+            const float(*splat)[4] = _planeSplats[plane];
+            Lanes nx = _load(splat[0]);
+            Lanes ny = _load(splat[1]);
+            Lanes nz = _load(splat[2]);
+            Lanes radius = _abs(_add(_add(_mul(nx, axis[0][0]), _mul(ny, axis[0][1])), _mul(nz, axis[0][2])));
+            radius = _add(radius, _abs(_add(_add(_mul(nx, axis[1][0]), _mul(ny, axis[1][1])), _mul(nz, axis[1][2]))));
+            radius = _add(radius, _abs(_add(_add(_mul(nx, axis[2][0]), _mul(ny, axis[2][1])), _mul(nz, axis[2][2]))));
+            Lanes distance = _add(_add(_add(_mul(nx, center[0]), _mul(ny, center[1])), _mul(nz, center[2])), _load(splat[3]));
+            outside = _or(outside, _lessThan(distance, _negate(radius)));
+            //All four already culled
+            if (_bits(outside) == 0xF) {
+                break;
+            }
+        }
+        visibleMasks[i / 32] |= (~_bits(outside) & 0xF) << (i % 32);
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (obbVisible(transforms[i])) {
+            visibleMasks[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
@@ -0,0 +1,232 @@
+#include "GLStateCache.h"
+#include <unordered_map>
+#include <map>
+#include <cstring>
+
+const GLuint UNKNOWN_BINDING = 0xFFFFFFFF; //Nothing has been set through the cache yet
+
+static struct {
+    //Entries that were in the table before the cache was installed
+    PFNGLUSEPROGRAMPROC         useProgram;
+    PFNGLBINDVERTEXARRAYPROC    bindVertexArray;
+    PFNGLDELETEVERTEXARRAYSPROC deleteVertexArrays;
+    PFNGLACTIVETEXTUREPROC      activeTexture;
+    PFNGLBINDTEXTUREPROC        bindTexture;
+    PFNGLDELETETEXTURESPROC     deleteTextures;
+    PFNGLBINDFRAMEBUFFERPROC    bindFramebuffer;
+    PFNGLDELETEFRAMEBUFFERSPROC deleteFramebuffers;
+    PFNGLVIEWPORTPROC           viewport;
+    PFNGLENABLEPROC             enable;
+    PFNGLDISABLEPROC            disable;
+    PFNGLBLENDFUNCPROC          blendFunc;
+    PFNGLDEPTHFUNCPROC          depthFunc;
+
+    //Shadowed state
+    GLuint                                      program;
+    GLuint                                      vertexArray;
+    GLuint                                      activeUnit;
+    std::map<std::pair<GLuint, GLenum>, GLuint> textures; //Per unit and target, missing entries are unknown
+    GLuint                                      drawFramebuffer;
+    GLuint                                      readFramebuffer;
+    GLint                                       viewportRect[4];
+    bool                                        viewportKnown;
+    std::unordered_map<GLenum, bool>            capabilities; //Missing entries are unknown
+    GLenum                                      blendFactors[2];
+    GLenum                                      depthCompare;
+    size_t                                      filtered;
+} cacheState;
+
+static void APIENTRY cachedUseProgram(GLuint program) {
+    if (cacheState.program == program) {
+        cacheState.filtered++;
+        return;
+    }
+    cacheState.program = program;
+    cacheState.useProgram(program);
+}
+
+static void APIENTRY cachedBindVertexArray(GLuint array) {
+    if (cacheState.vertexArray == array) {
+        cacheState.filtered++;
+        return;
+    }
+    cacheState.vertexArray = array;
+    cacheState.bindVertexArray(array);
+}
+
+static void APIENTRY cachedDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    cacheState.deleteVertexArrays(n, arrays);
+    //Deleting the bound vertex array binds zero
+    for (GLsizei i = 0; i < n; i++) {
+        if (cacheState.vertexArray == arrays[i]) {
+            cacheState.vertexArray = 0;
+        }
+    }
+}
+
+static void APIENTRY cachedActiveTexture(GLenum texture) {
+    GLuint unit = texture - GL_TEXTURE0;
+    if (cacheState.activeUnit == unit) {
+        cacheState.filtered++;
+        return;
+    }
+    cacheState.activeUnit = unit;
+    cacheState.activeTexture(texture);
+}
+
+static void APIENTRY cachedBindTexture(GLenum target, GLuint texture) {
+    if (cacheState.activeUnit != UNKNOWN_BINDING) {
+        auto bound = cacheState.textures.find(std::make_pair(cacheState.activeUnit, target));
+        if (bound != cacheState.textures.end() && bound->second == texture) {
+            cacheState.filtered++;
+            return;
+        }
+        cacheState.textures[std::make_pair(cacheState.activeUnit, target)] = texture;
+    }
+    cacheState.bindTexture(target, texture);
+}
+
+static void APIENTRY cachedDeleteTextures(GLsizei n, const GLuint* textures) {
+    cacheState.deleteTextures(n, textures);
+    //Deleted textures are unbound from every unit and the name may be handed out again
+    for (GLsizei i = 0; i < n; i++) {
+        for (auto& bound : cacheState.textures) {
+            if (bound.second == textures[i]) {
+                bound.second = 0;
+            }
+        }
+    }
+}
+
+static void APIENTRY cachedBindFramebuffer(GLenum target, GLuint framebuffer) {
+    bool draw = target != GL_READ_FRAMEBUFFER;
+    bool read = target != GL_DRAW_FRAMEBUFFER;
+    if ((!draw || cacheState.drawFramebuffer == framebuffer) && (!read || cacheState.readFramebuffer == framebuffer)) {
+        cacheState.filtered++;
+        return;
+    }
+    if (draw) {
+        cacheState.drawFramebuffer = framebuffer;
+    }
+    if (read) {
+        cacheState.readFramebuffer = framebuffer;
+    }
+    cacheState.bindFramebuffer(target, framebuffer);
+}
+
+static void APIENTRY cachedDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    cacheState.deleteFramebuffers(n, framebuffers);
+    //Deleting a bound framebuffer binds the default one in its place
+    for (GLsizei i = 0; i < n; i++) {
+        if (cacheState.drawFramebuffer == framebuffers[i]) {
+            cacheState.drawFramebuffer = 0;
+        }
+        if (cacheState.readFramebuffer == framebuffers[i]) {
+            cacheState.readFramebuffer = 0;
+        }
+    }
+}
+
+static void APIENTRY cachedViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    GLint rect[4] = { x, y, width, height };
+    if (cacheState.viewportKnown && memcmp(rect, cacheState.viewportRect, sizeof(rect)) == 0) {
+        cacheState.filtered++;
+        return;
+    }
+    memcpy(cacheState.viewportRect, rect, sizeof(rect));
+    cacheState.viewportKnown = true;
+    cacheState.viewport(x, y, width, height);
+}
+
+static bool capabilityUnchanged(GLenum cap, bool enabled) {
+    auto capability = cacheState.capabilities.find(cap);
+    if (capability != cacheState.capabilities.end() && capability->second == enabled) {
+        cacheState.filtered++;
+        return true;
+    }
+    cacheState.capabilities[cap] = enabled;
+    return false;
+}
+
+static void APIENTRY cachedEnable(GLenum cap) {
+    if (!capabilityUnchanged(cap, true)) {
+        cacheState.enable(cap);
+    }
+}
+
+static void APIENTRY cachedDisable(GLenum cap) {
+    if (!capabilityUnchanged(cap, false)) {
+        cacheState.disable(cap);
+    }
+}
+
+static void APIENTRY cachedBlendFunc(GLenum sfactor, GLenum dfactor) {
+    if (cacheState.blendFactors[0] == sfactor && cacheState.blendFactors[1] == dfactor) {
+        cacheState.filtered++;
+        return;
+    }
+    cacheState.blendFactors[0] = sfactor;
+    cacheState.blendFactors[1] = dfactor;
+    cacheState.blendFunc(sfactor, dfactor);
+}
+
+static void APIENTRY cachedDepthFunc(GLenum func) {
+    if (cacheState.depthCompare == func) {
+        cacheState.filtered++;
+        return;
+    }
+    cacheState.depthCompare = func;
+    cacheState.depthFunc(func);
+}
+
+void GLStateCache::install() {
+
+    cacheState.program = UNKNOWN_BINDING;
+    cacheState.vertexArray = UNKNOWN_BINDING;
+    cacheState.activeUnit = UNKNOWN_BINDING;
+    cacheState.textures.clear();
+    cacheState.drawFramebuffer = UNKNOWN_BINDING;
+    cacheState.readFramebuffer = UNKNOWN_BINDING;
+    cacheState.viewportKnown = false;
+    cacheState.capabilities.clear();
+    cacheState.blendFactors[0] = UNKNOWN_BINDING;
+    cacheState.blendFactors[1] = UNKNOWN_BINDING;
+    cacheState.depthCompare = UNKNOWN_BINDING;
+    cacheState.filtered = 0;
+
+    cacheState.useProgram = gl3wProcs.gl.UseProgram;
+    cacheState.bindVertexArray = gl3wProcs.gl.BindVertexArray;
+    cacheState.deleteVertexArrays = gl3wProcs.gl.DeleteVertexArrays;
+    cacheState.activeTexture = gl3wProcs.gl.ActiveTexture;
+    cacheState.bindTexture = gl3wProcs.gl.BindTexture;
+    cacheState.deleteTextures = gl3wProcs.gl.DeleteTextures;
+    cacheState.bindFramebuffer = gl3wProcs.gl.BindFramebuffer;
+    cacheState.deleteFramebuffers = gl3wProcs.gl.DeleteFramebuffers;
+    cacheState.viewport = gl3wProcs.gl.Viewport;
+    cacheState.enable = gl3wProcs.gl.Enable;
+    cacheState.disable = gl3wProcs.gl.Disable;
+    cacheState.blendFunc = gl3wProcs.gl.BlendFunc;
+    cacheState.depthFunc = gl3wProcs.gl.DepthFunc;
+
+    gl3wProcs.gl.UseProgram = cachedUseProgram;
+    gl3wProcs.gl.BindVertexArray = cachedBindVertexArray;
+    gl3wProcs.gl.DeleteVertexArrays = cachedDeleteVertexArrays;
+    gl3wProcs.gl.ActiveTexture = cachedActiveTexture;
+    gl3wProcs.gl.BindTexture = cachedBindTexture;
+    gl3wProcs.gl.DeleteTextures = cachedDeleteTextures;
+    gl3wProcs.gl.BindFramebuffer = cachedBindFramebuffer;
+    gl3wProcs.gl.DeleteFramebuffers = cachedDeleteFramebuffers;
+    gl3wProcs.gl.Viewport = cachedViewport;
+    gl3wProcs.gl.Enable = cachedEnable;
+    gl3wProcs.gl.Disable = cachedDisable;
+    gl3wProcs.gl.BlendFunc = cachedBlendFunc;
+    gl3wProcs.gl.DepthFunc = cachedDepthFunc;
+}
+
+size_t GLStateCache::getFilteredCalls() {
+    return cacheState.filtered;
+}
+
+void GLStateCache::resetFilteredCalls() {
+    cacheState.filtered = 0;
+}
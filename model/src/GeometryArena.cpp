@@ -0,0 +1,297 @@
+#include "GeometryArena.h"
+#include <algorithm>
+
+GeometryArena::GeometryArena() :
+    _drawIndexBuffer(0),
+    _drawIndexCapacity(0),
+    _commandBuffer(nullptr),
+    _drawConstants(nullptr),
+    _storageAlignment(16) {
+
+    //Nothing touches gl until the first allocation, the arena can be built before the context
+}
+
+GeometryArena::~GeometryArena() {
+
+    for (Block& block : _blocks) {
+        glDeleteVertexArrays(1, &block.vao);
+        glDeleteVertexArrays(1, &block.shadowVao);
+        glDeleteBuffers(1, &block.positionBuffer);
+        glDeleteBuffers(1, &block.normalBuffer);
+        glDeleteBuffers(1, &block.textureBuffer);
+        glDeleteBuffers(1, &block.indexBuffer);
+    }
+    if (_drawIndexBuffer != 0) {
+        glDeleteBuffers(1, &_drawIndexBuffer);
+    }
+    delete _commandBuffer;
+    delete _drawConstants;
+}
+
+bool GeometryArena::_allocateRange(std::vector<GeometryRange>& freeRanges, size_t count, size_t& first) {
+
+    for (size_t i = 0; i < freeRanges.size(); i++) {
+        if (freeRanges[i].count >= count) {
+            first = freeRanges[i].first;
+            freeRanges[i].first += count;
+            freeRanges[i].count -= count;
+            if (freeRanges[i].count == 0) {
+                freeRanges.erase(freeRanges.begin() + i);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeometryArena::_releaseRange(std::vector<GeometryRange>& freeRanges, size_t first, size_t count) {
+
+    if (count == 0) {
+        return;
+    }
+
+    auto next = std::lower_bound(freeRanges.begin(), freeRanges.end(), first,
+        [](const GeometryRange& range, size_t value) { return range.first < value; });
+    GeometryRange range = { first, count };
+    next = freeRanges.insert(next, range);
+
+    //Merge with the following range and then the previous one
+    if (next + 1 != freeRanges.end() && next->first + next->count == (next + 1)->first) {
+        next->count += (next + 1)->count;
+        freeRanges.erase(next + 1);
+    }
+    if (next != freeRanges.begin() && (next - 1)->first + (next - 1)->count == next->first) {
+        (next - 1)->count += next->count;
+        freeRanges.erase(next);
+    }
+}
+
+void GeometryArena::_bindFormat(Block& block, bool shadow) {
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, block.indexBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, block.positionBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), 0);
+    glEnableVertexAttribArray(0);
+
+    if (!shadow) {
+        //Normalized packed integers come back as floats in [-1, 1], the shader's vec3 drops w
+        glBindBuffer(GL_ARRAY_BUFFER, block.normalBuffer);
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(SnormNormal), 0);
+        glEnableVertexAttribArray(1);
+
+        glBindBuffer(GL_ARRAY_BUFFER, block.textureBuffer);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Tex2), 0);
+        glEnableVertexAttribArray(2);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::_attachDrawIndex(GLuint vao) {
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _drawIndexBuffer);
+    //Integer attribute so the index is not converted to float, advanced once per instance
+    glVertexAttribIPointer(DRAW_INDEX_LOCATION, 1, GL_UNSIGNED_INT, sizeof(GLuint), 0);
+    glVertexAttribDivisor(DRAW_INDEX_LOCATION, 1);
+    glEnableVertexAttribArray(DRAW_INDEX_LOCATION);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::_createBlock(size_t vertices, size_t indices) {
+
+    reserveDrawIndices(ARENA_DRAW_INDICES);
+
+    Block block;
+    size_t vertexCapacity = ARENA_FIRST_VERTICES;
+    size_t indexCapacity = ARENA_FIRST_INDICES;
+    if (!_blocks.empty()) {
+        vertexCapacity = std::min(_blocks.back().vertexCapacity * 2, ARENA_BLOCK_VERTICES);
+        indexCapacity = std::min(_blocks.back().indexCapacity * 2, ARENA_BLOCK_INDICES);
+    }
+    block.vertexCapacity = std::max(vertices, vertexCapacity);
+    block.indexCapacity = std::max(indices, indexCapacity);
+    GeometryRange vertexRange = { 0, block.vertexCapacity };
+    GeometryRange indexRange = { 0, block.indexCapacity };
+    block.freeVertices.push_back(vertexRange);
+    block.freeIndices.push_back(indexRange);
+
+    glGenBuffers(1, &block.positionBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, block.positionBuffer);
+    glBufferData(GL_ARRAY_BUFFER, block.vertexCapacity * sizeof(Vector3), nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &block.normalBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, block.normalBuffer);
+    glBufferData(GL_ARRAY_BUFFER, block.vertexCapacity * sizeof(SnormNormal), nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &block.textureBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, block.textureBuffer);
+    glBufferData(GL_ARRAY_BUFFER, block.vertexCapacity * sizeof(Tex2), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, &block.indexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, block.indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, block.indexCapacity * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    glGenVertexArrays(1, &block.vao);
+    glBindVertexArray(block.vao);
+    _bindFormat(block, false);
+    glBindVertexArray(0);
+    _attachDrawIndex(block.vao);
+    _drawIndexVaos.push_back(block.vao);
+
+    glGenVertexArrays(1, &block.shadowVao);
+    glBindVertexArray(block.shadowVao);
+    _bindFormat(block, true);
+    glBindVertexArray(0);
+
+    _blocks.push_back(block);
+}
+
+GeometryAllocation GeometryArena::allocate(const std::vector<Vector3>& positions, const std::vector<SnormNormal>& normals,
+                                           const std::vector<Tex2>& textures, const std::vector<int>& indices) {
+
+    size_t vertexCount = positions.size();
+    size_t indexCount = indices.size();
+
+    //The element array binding is vao state, binding index buffers below must not touch the caller's vao
+    glBindVertexArray(0);
+
+    //First block with room for both ranges, otherwise a new block sized to fit
+    GeometryAllocation allocation = { -1, 0, 0, static_cast<GLuint>(vertexCount), static_cast<GLuint>(indexCount) };
+    size_t firstVertex = 0;
+    size_t firstIndex = 0;
+    for (size_t i = 0; i < _blocks.size() && allocation.block == -1; i++) {
+        if (_allocateRange(_blocks[i].freeVertices, vertexCount, firstVertex)) {
+            if (_allocateRange(_blocks[i].freeIndices, indexCount, firstIndex)) {
+                allocation.block = static_cast<int>(i);
+            }
+            else {
+                _releaseRange(_blocks[i].freeVertices, firstVertex, vertexCount);
+            }
+        }
+    }
+    if (allocation.block == -1) {
+        _createBlock(vertexCount, indexCount);
+        allocation.block = static_cast<int>(_blocks.size() - 1);
+        _allocateRange(_blocks.back().freeVertices, vertexCount, firstVertex);
+        _allocateRange(_blocks.back().freeIndices, indexCount, firstIndex);
+    }
+    allocation.baseVertex = static_cast<GLint>(firstVertex);
+    allocation.firstIndex = static_cast<GLuint>(firstIndex);
+
+    //Streams a model does not supply are left as they are, its shader does not read them
+    Block& block = _blocks[allocation.block];
+    glBindBuffer(GL_ARRAY_BUFFER, block.positionBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, firstVertex * sizeof(Vector3), vertexCount * sizeof(Vector3), positions.data());
+    glBindBuffer(GL_ARRAY_BUFFER, block.normalBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, firstVertex * sizeof(SnormNormal),
+                    std::min(normals.size(), vertexCount) * sizeof(SnormNormal), normals.data());
+    glBindBuffer(GL_ARRAY_BUFFER, block.textureBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, firstVertex * sizeof(Tex2),
+                    std::min(textures.size(), vertexCount) * sizeof(Tex2), textures.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    //Indices stay relative to the model, the base vertex of each draw offsets them
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, block.indexBuffer);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, firstIndex * sizeof(GLuint), indexCount * sizeof(GLuint), indices.data());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return allocation;
+}
+
+void GeometryArena::free(GeometryAllocation& allocation) {
+
+    if (allocation.block == -1) {
+        return;
+    }
+    Block& block = _blocks[allocation.block];
+    _releaseRange(block.freeVertices, allocation.baseVertex, allocation.vertexCount);
+    _releaseRange(block.freeIndices, allocation.firstIndex, allocation.indexCount);
+    allocation.block = -1;
+}
+
+GLuint GeometryArena::getVAOContext(int block) {
+    return _blocks[block].vao;
+}
+
+GLuint GeometryArena::getShadowVAOContext(int block) {
+    return _blocks[block].shadowVao;
+}
+
+GLuint GeometryArena::getPositionContext(int block) {
+    return _blocks[block].positionBuffer;
+}
+
+GLuint GeometryArena::getNormalContext(int block) {
+    return _blocks[block].normalBuffer;
+}
+
+GLuint GeometryArena::getTextureContext(int block) {
+    return _blocks[block].textureBuffer;
+}
+
+GLuint GeometryArena::createPrivateVAO(int block) {
+
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    _bindFormat(_blocks[block], false);
+    glBindVertexArray(0);
+    _attachDrawIndex(vao);
+    _drawIndexVaos.push_back(vao);
+    return vao;
+}
+
+void GeometryArena::destroyPrivateVAO(GLuint vao) {
+    _drawIndexVaos.erase(std::remove(_drawIndexVaos.begin(), _drawIndexVaos.end(), vao), _drawIndexVaos.end());
+    glDeleteVertexArrays(1, &vao);
+}
+
+void GeometryArena::reserveDrawIndices(size_t count) {
+
+    if (_commandBuffer == nullptr) {
+        _commandBuffer = new StreamBuffer(GL_DRAW_INDIRECT_BUFFER, ARENA_DRAW_INDICES * sizeof(DrawElementsIndirectCommand));
+        _drawConstants = new StreamBuffer(GL_SHADER_STORAGE_BUFFER, ARENA_DRAW_INDICES * 16 * sizeof(float));
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &_storageAlignment);
+        _storageAlignment = std::max(_storageAlignment, 16);
+    }
+
+    if (count <= _drawIndexCapacity) {
+        return;
+    }
+    while (_drawIndexCapacity < count) {
+        _drawIndexCapacity = std::max(_drawIndexCapacity * 2, ARENA_DRAW_INDICES);
+    }
+
+    std::vector<GLuint> drawIndices(_drawIndexCapacity);
+    for (size_t i = 0; i < _drawIndexCapacity; i++) {
+        drawIndices[i] = static_cast<GLuint>(i);
+    }
+    if (_drawIndexBuffer != 0) {
+        glDeleteBuffers(1, &_drawIndexBuffer);
+    }
+    glGenBuffers(1, &_drawIndexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _drawIndexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, drawIndices.size() * sizeof(GLuint), drawIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    //Vaos keep pointing at the old buffer until they are told about the new one
+    for (GLuint vao : _drawIndexVaos) {
+        _attachDrawIndex(vao);
+    }
+}
+
+StreamBuffer* GeometryArena::getCommandBuffer() {
+    return _commandBuffer;
+}
+
+StreamBuffer* GeometryArena::getDrawConstantBuffer() {
+    return _drawConstants;
+}
+
+GLint GeometryArena::getStorageAlignment() {
+    return _storageAlignment;
+}
@@ -0,0 +1,185 @@
+#include "InstanceBuffer.h"
+#include <algorithm>
+
+InstanceBuffer::InstanceBuffer() :
+    _transformBufferContext(0),
+    _transformTextureContext(0),
+    _visibleIndices(nullptr),
+    _vaoContext(0),
+    _location(0),
+    _attachedContext(0),
+    _transformCapacity(0),
+    _culledBufferContext(0),
+    _commandBufferContext(0),
+    _culledCapacity(0),
+    _dirtyBegin(0),
+    _dirtyEnd(0) {
+
+}
+
+InstanceBuffer::~InstanceBuffer() {
+    if (_transformBufferContext != 0) {
+        glDeleteTextures(1, &_transformTextureContext);
+        glDeleteBuffers(1, &_transformBufferContext);
+        delete _visibleIndices;
+    }
+    if (_culledBufferContext != 0) {
+        glDeleteBuffers(1, &_culledBufferContext);
+        glDeleteBuffers(1, &_commandBufferContext);
+    }
+}
+
+void InstanceBuffer::_create() {
+    //Buffers are created on first use so models that are never instanced do not hold gl objects
+    glGenBuffers(1, &_transformBufferContext);
+    _visibleIndices = new StreamBuffer(GL_ARRAY_BUFFER, 1024 * sizeof(GLuint));
+    glGenTextures(1, &_transformTextureContext);
+}
+
+void InstanceBuffer::attach(GLuint vaoContext, GLuint location) {
+
+    if (_transformBufferContext == 0) {
+        _create();
+    }
+
+    _vaoContext = vaoContext;
+    _location = location;
+
+    glBindVertexArray(vaoContext);
+    glEnableVertexAttribArray(location);
+    //Advance once per instance instead of once per vertex
+    glVertexAttribDivisor(location, 1);
+    glBindVertexArray(0);
+    _pointAttribute(_visibleIndices->getContext());
+}
+
+void InstanceBuffer::_pointAttribute(GLuint bufferContext) {
+
+    _attachedContext = bufferContext;
+
+    glBindVertexArray(_vaoContext);
+    glBindBuffer(GL_ARRAY_BUFFER, _attachedContext);
+    //Integer attribute so the index is not converted to float
+    glVertexAttribIPointer(_location, 1, GL_UNSIGNED_INT, sizeof(GLuint), 0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::markDirty(size_t first, size_t count) {
+    if (_dirtyBegin == _dirtyEnd) {
+        _dirtyBegin = first;
+        _dirtyEnd = first + count;
+    }
+    else {
+        _dirtyBegin = std::min(_dirtyBegin, first);
+        _dirtyEnd = std::max(_dirtyEnd, first + count);
+    }
+}
+
+void InstanceBuffer::uploadTransforms(const std::vector<Matrix>& transforms) {
+
+    if (_transformBufferContext == 0) {
+        _create();
+    }
+
+    size_t first = _dirtyBegin;
+    size_t last = std::min(_dirtyEnd, transforms.size());
+
+    glBindBuffer(GL_TEXTURE_BUFFER, _transformBufferContext);
+
+    //Grow to the next power of two and resend everything, the buffer texture has to be
+    //pointed at the new storage as well
+    if (transforms.size() > _transformCapacity) {
+        _transformCapacity = std::max<size_t>(_transformCapacity, 64);
+        while (_transformCapacity < transforms.size()) {
+            _transformCapacity *= 2;
+        }
+        glBufferData(GL_TEXTURE_BUFFER,
+                     _transformCapacity * INSTANCE_TRANSFORM_FLOATS * sizeof(float),
+                     nullptr,
+                     GL_DYNAMIC_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, _transformTextureContext);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _transformBufferContext);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        first = 0;
+        last = transforms.size();
+    }
+
+    if (first < last) {
+        //Matrix carries its type tag so the floats are copied out instead of sending the array
+        _staging.resize((last - first) * INSTANCE_TRANSFORM_FLOATS);
+        for (size_t i = first; i < last; i++) {
+            const float* values = transforms[i].getFlatBuffer();
+            std::copy(values, values + INSTANCE_TRANSFORM_FLOATS, &_staging[(i - first) * INSTANCE_TRANSFORM_FLOATS]);
+        }
+        glBufferSubData(GL_TEXTURE_BUFFER,
+                        first * INSTANCE_TRANSFORM_FLOATS * sizeof(float),
+                        _staging.size() * sizeof(float),
+                        _staging.data());
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    _dirtyBegin = 0;
+    _dirtyEnd = 0;
+}
+
+GLuint InstanceBuffer::uploadVisible(const std::vector<GLuint>& visible) {
+
+    if (_transformBufferContext == 0) {
+        _create();
+    }
+
+    //Appending never overwrites indices an earlier draw may still be reading
+    size_t offset = _visibleIndices->write(visible.data(), visible.size() * sizeof(GLuint), sizeof(GLuint));
+
+    //Growing the stream buffer replaces it so the attribute has to follow
+    if (_vaoContext != 0 && _attachedContext != _visibleIndices->getContext()) {
+        _pointAttribute(_visibleIndices->getContext());
+    }
+    return static_cast<GLuint>(offset / sizeof(GLuint));
+}
+
+void InstanceBuffer::prepareCulled(size_t instances, const std::vector<DrawArraysIndirectCommand>& commands) {
+
+    if (_culledBufferContext == 0) {
+        glGenBuffers(1, &_culledBufferContext);
+        glGenBuffers(1, &_commandBufferContext);
+    }
+
+    //Room for every instance since the cull can not know how many survive ahead of time
+    if (instances > _culledCapacity) {
+        _culledCapacity = std::max<size_t>(_culledCapacity, 64);
+        while (_culledCapacity < instances) {
+            _culledCapacity *= 2;
+        }
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _culledBufferContext);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, _culledCapacity * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    //Instance counts start at zero and are counted up by the cull, gl orders this after last frame's draws
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _commandBufferContext);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawArraysIndirectCommand),
+                 commands.data(), GL_DYNAMIC_COPY);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    if (_vaoContext != 0 && _attachedContext != _culledBufferContext) {
+        _pointAttribute(_culledBufferContext);
+    }
+}
+
+GLuint InstanceBuffer::getTransformTexture() {
+    return _transformTextureContext;
+}
+
+GLuint InstanceBuffer::getTransformBuffer() {
+    return _transformBufferContext;
+}
+
+GLuint InstanceBuffer::getCulledBuffer() {
+    return _culledBufferContext;
+}
+
+GLuint InstanceBuffer::getCommandBuffer() {
+    return _commandBufferContext;
+}
@@ -11,6 +11,6 @@ LayeredTexture::~LayeredTexture() {
 
 }
 
-std::vector<Texture*> LayeredTexture::getTextures() {
+std::vector<Texture*>& LayeredTexture::getTextures() {
     return _textures;
 }
@@ -1,35 +1,84 @@
 #include "MasterClock.h"
+#include "World.h"
 #include <ctime>
 #include <iostream>
-MasterClock* MasterClock::_clock = nullptr;
 
-MasterClock::MasterClock() : _frameTime(DEFAULT_FRAME_TIME),
-    _animationTime(DEFAULT_FRAME_TIME){
+MasterClock::MasterClock() : _physicsThread(nullptr),
+    _fpsThread(nullptr),
+    _animationThread(nullptr),
+    _frameTime(DEFAULT_FRAME_TIME),
+    _animationTime(DEFAULT_FRAME_TIME),
+    _running(false),
+    _kinematicsStepCounter(0),
+    _animationStepCounter(0),
+    _frameStepCounter(0){
 
 }
 
 MasterClock::~MasterClock(){
-
+    stop();
 }
 
 MasterClock* MasterClock::instance(){
-    if(_clock == nullptr){
-        _clock = new MasterClock();
+    return World::current()->getClock();
+}
+
+void MasterClock::run(World* world){
+
+    _running = true;
+
+    //Run the clock event processes that are responsible for sending time events to subscribers.
+    //Each makes world current first so subscribers reach its brokers and not the default world's
+    _physicsThread = new std::thread(&MasterClock::_physicsProcess, this, world);
+    _fpsThread = new std::thread(&MasterClock::_fpsProcess, this, world);
+    _animationThread = new std::thread(&MasterClock::_animationProcess, this, world);
+}
+
+void MasterClock::stop(){
+
+    _running = false;
+
+    for (std::thread** thread : { &_physicsThread, &_fpsThread, &_animationThread }) {
+        if (*thread != nullptr) {
+            (*thread)->join();
+            delete *thread;
+            *thread = nullptr;
+        }
     }
-    return _clock;
 }
 
-void MasterClock::run(){
+void MasterClock::step(int milliSeconds){
 
-    //Run the clock event processes that are responsible for sending time events to subscribers
-    _physicsThread = new std::thread(&MasterClock::_physicsProcess, _clock);
-    _fpsThread = new std::thread(&MasterClock::_fpsProcess, _clock);
-    _animationThread = new std::thread(&MasterClock::_animationProcess, _clock);
+    //Same feed granularity as the clock threads but driven by the caller instead of wall time
+    _kinematicsStepCounter += milliSeconds;
+    while(_kinematicsStepCounter >= KINEMATICS_TIME){
+        _kinematicsStepCounter -= KINEMATICS_TIME;
+        for(auto funcs : _kinematicsRateFuncs){
+            funcs(KINEMATICS_TIME);
+        }
+    }
+
+    _animationStepCounter += milliSeconds;
+    while(_animationStepCounter >= _animationTime){
+        _animationStepCounter -= _animationTime;
+        for(auto funcs : _animationRateFuncs){
+            funcs(_animationTime);
+        }
+    }
+
+    _frameStepCounter += milliSeconds;
+    while(_frameStepCounter >= _frameTime){
+        _frameStepCounter -= _frameTime;
+        for(auto funcs : _frameRateFuncs){
+            funcs(_frameTime);
+        }
+    }
 }
 
-void MasterClock::_physicsProcess(){
+void MasterClock::_physicsProcess(World* world){
+    world->makeCurrent();
     int milliSecondCounter = 0;
-    while(true){
+    while(_running){
         auto start = std::chrono::high_resolution_clock::now();
         //If the millisecond amount is divisible by kinematics time then trigger a kinematic calculation time event to subscribers
         if(milliSecondCounter == KINEMATICS_TIME){
@@ -53,9 +102,10 @@ void MasterClock::_physicsProcess(){
     }
 }
 
-void MasterClock::_fpsProcess(){
+void MasterClock::_fpsProcess(World* world){
+    world->makeCurrent();
     int milliSecondCounter = 0;
-    while(true){
+    while(_running){
         auto start = std::chrono::high_resolution_clock::now();
         //If the millisecond amount is divisible by frame time then trigger a frame time event to subscribers
         if(milliSecondCounter == _frameTime){
@@ -73,9 +123,10 @@ void MasterClock::_fpsProcess(){
     }
 }
 
-void MasterClock::_animationProcess(){
+void MasterClock::_animationProcess(World* world){
+    world->makeCurrent();
     int milliSecondCounter = 0;
-    while(true){
+    while(_running){
         auto start = std::chrono::high_resolution_clock::now();
         //If the millisecond amount is divisible by frame time then trigger a frame time event to subscribers
         if(milliSecondCounter == _animationTime){
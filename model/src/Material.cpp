@@ -0,0 +1,47 @@
+#include "Material.h"
+
+Material::Material(uint32_t id, MaterialVariant variant, std::vector<MaterialTexture> textures, bool transparent) :
+    _id(id),
+    _variant(variant),
+    _textures(textures),
+    _transparent(transparent) {
+
+    _uniforms.layered = variant == MaterialVariant::Layered ? 1 : 0;
+}
+
+Material::~Material() {
+
+}
+
+uint32_t Material::getId() const {
+    return _id;
+}
+
+MaterialVariant Material::getVariant() const {
+    return _variant;
+}
+
+bool Material::isTransparent() const {
+    return _transparent;
+}
+
+const std::vector<MaterialTexture>& Material::getTextures() const {
+    return _textures;
+}
+
+void Material::bind(const GLint* samplerLocations, GLint layeredSwitchLocation) const {
+
+    glUniform1i(layeredSwitchLocation, _uniforms.layered);
+
+    for (const MaterialTexture& texture : _textures) {
+
+        //Programs that do not declare the sampler never read the texture
+        GLint location = samplerLocations[static_cast<int>(texture.sampler)];
+        if (location == -1) {
+            continue;
+        }
+        glActiveTexture(GL_TEXTURE0 + texture.unit);
+        glBindTexture(GL_TEXTURE_2D, texture.context);
+        glUniform1i(location, texture.unit);
+    }
+}
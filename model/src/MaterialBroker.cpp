@@ -0,0 +1,97 @@
+#include "MaterialBroker.h"
+#include "World.h"
+
+MaterialBroker* MaterialBroker::instance() { //Material cache of the calling thread's current world
+    return World::current()->getMaterialBroker();
+}
+
+MaterialBroker::MaterialBroker(TextureBroker* textureBroker) :
+    _textureBroker(textureBroker) {
+
+}
+
+MaterialBroker::~MaterialBroker() {
+    for (Material* material : _materials) {
+        delete material;
+    }
+}
+
+Material* MaterialBroker::getTexturedMaterial(TextureHandle texture) {
+
+    Texture* diffuse = _textureBroker->getTexture(texture);
+    std::vector<MaterialTexture> textures = {
+        { MaterialSampler::TextureMap, 0, diffuse->getContext() }
+    };
+    return _getMaterial(MaterialVariant::Textured, textures, diffuse->getTransparency());
+}
+
+Material* MaterialBroker::getLayeredMaterial(LayeredTextureHandle layeredTexture) {
+
+    auto& layers = _textureBroker->getLayeredTexture(layeredTexture)->getTextures();
+    std::vector<MaterialTexture> textures;
+
+    //Layered fbx materials either have four layers plus extra maps with the alpha map
+    //at index 7 or three layers followed by the alpha map
+    if (layers.size() > 4) {
+        textures = {
+            { MaterialSampler::Tex0,      1, layers[0]->getContext() },
+            { MaterialSampler::Tex1,      2, layers[1]->getContext() },
+            { MaterialSampler::Tex2,      3, layers[2]->getContext() },
+            { MaterialSampler::Tex3,      4, layers[3]->getContext() },
+            { MaterialSampler::AlphaTex0, 5, layers[7]->getContext() }
+        };
+    }
+    else {
+        textures = {
+            { MaterialSampler::Tex0,      1, layers[0]->getContext() },
+            { MaterialSampler::Tex1,      2, layers[1]->getContext() },
+            { MaterialSampler::Tex2,      3, layers[2]->getContext() },
+            { MaterialSampler::AlphaTex0, 5, layers[3]->getContext() }
+        };
+    }
+    return _getMaterial(MaterialVariant::Layered, textures, false);
+}
+
+Material* MaterialBroker::getTerrainMaterial(TextureHandle texture, const std::vector<TextureHandle>& layers) {
+
+    Texture* diffuse = _textureBroker->getTexture(texture);
+    std::vector<MaterialTexture> textures = {
+        { MaterialSampler::TextureMap, 0, diffuse->getContext() }
+    };
+    MaterialSampler samplers[] = { MaterialSampler::Tex0, MaterialSampler::Tex1, MaterialSampler::Tex2, MaterialSampler::Tex3 };
+    for (size_t layer = 0; layer < layers.size() && layer < 4; layer++) {
+        Texture* layerTexture = _textureBroker->getTexture(layers[layer]);
+        if (layerTexture != nullptr) {
+            textures.push_back({ samplers[layer], static_cast<GLuint>(layer), layerTexture->getContext() });
+        }
+    }
+    return _getMaterial(MaterialVariant::Terrain, textures, diffuse->getTransparency());
+}
+
+Material* MaterialBroker::getMaterial(uint32_t id) {
+    return _materials[id];
+}
+
+size_t MaterialBroker::getMaterialCount() {
+    return _materials.size();
+}
+
+Material* MaterialBroker::_getMaterial(MaterialVariant variant, std::vector<MaterialTexture> textures, bool transparent) {
+
+    std::vector<GLuint> key;
+    key.push_back(static_cast<GLuint>(variant));
+    for (MaterialTexture& texture : textures) {
+        key.push_back(static_cast<GLuint>(texture.sampler));
+        key.push_back(texture.unit);
+        key.push_back(texture.context);
+    }
+
+    auto material = _materialKeys.find(key);
+    if (material != _materialKeys.end()) {
+        return material->second;
+    }
+    Material* newMaterial = new Material(static_cast<uint32_t>(_materials.size()), variant, textures, transparent);
+    _materials.push_back(newMaterial);
+    _materialKeys[key] = newMaterial;
+    return newMaterial;
+}
@@ -3,7 +3,7 @@
 #include <iomanip>
 using namespace std;
 
-Matrix::Matrix() {
+Matrix::Matrix() : _type(MatrixType::Orthonormal) {
     //Identity 4x4 homogenous matrix
     _matrix[0] = 1.0, _matrix[1] = 0.0, _matrix[2] = 0.0, _matrix[3] = 0.0;
     _matrix[4] = 0.0, _matrix[5] = 1.0, _matrix[6] = 0.0, _matrix[7] = 0.0;
@@ -11,7 +11,7 @@ Matrix::Matrix() {
     _matrix[12] = 0.0, _matrix[13] = 0.0, _matrix[14] = 0.0, _matrix[15] = 1.0;
 }
 
-Matrix::Matrix(float* mat) {
+Matrix::Matrix(float* mat, MatrixType type) : _type(type) {
 
     _matrix[0] = mat[0], _matrix[1] = mat[1], _matrix[2] = mat[2], _matrix[3] = mat[3];
     _matrix[4] = mat[4], _matrix[5] = mat[5], _matrix[6] = mat[6], _matrix[7] = mat[7];
@@ -19,7 +19,7 @@ Matrix::Matrix(float* mat) {
     _matrix[12] = mat[12], _matrix[13] = mat[13], _matrix[14] = mat[14], _matrix[15] = mat[15];
 }
 
-Matrix::Matrix(double* mat) {
+Matrix::Matrix(double* mat, MatrixType type) : _type(type) {
 
     _matrix[0] = (float)mat[0], _matrix[1] = (float)mat[1], _matrix[2] = (float)mat[2], _matrix[3] = (float)mat[3];
     _matrix[4] = (float)mat[4], _matrix[5] = (float)mat[5], _matrix[6] = (float)mat[6], _matrix[7] = (float)mat[7];
@@ -31,19 +31,133 @@ float* Matrix::getFlatBuffer() {
     return _matrix;
 }
 
+const float* Matrix::getFlatBuffer() const {
+    return _matrix;
+}
+
+MatrixType Matrix::getType() const {
+    return _type;
+}
+
+void Matrix::setType(MatrixType type) {
+    _type = type;
+}
+
 Matrix Matrix::transpose() {
-    Matrix matrix(_matrix);
+    //Only a pure rotation keeps its structure, translation ends up in the bottom row
+    Matrix matrix(_matrix, _type == MatrixType::Orthonormal ? MatrixType::Orthonormal : MatrixType::General);
     float* mat = matrix.getFlatBuffer();
 
+#if defined(MATH_SSE)
+    __m128 row0 = _mm_load_ps(&_matrix[0]);
+    __m128 row1 = _mm_load_ps(&_matrix[4]);
+    __m128 row2 = _mm_load_ps(&_matrix[8]);
+    __m128 row3 = _mm_load_ps(&_matrix[12]);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_store_ps(&mat[0], row0);
+    _mm_store_ps(&mat[4], row1);
+    _mm_store_ps(&mat[8], row2);
+    _mm_store_ps(&mat[12], row3);
+#elif defined(MATH_NEON)
+    //De-interleaving load hands back the columns which are the rows of the transpose
+    float32x4x4_t columns = vld4q_f32(_matrix);
+    vst1q_f32(&mat[0], columns.val[0]);
+    vst1q_f32(&mat[4], columns.val[1]);
+    vst1q_f32(&mat[8], columns.val[2]);
+    vst1q_f32(&mat[12], columns.val[3]);
+#else
     mat[0] = _matrix[0], mat[1] = _matrix[4], mat[2] = _matrix[8], mat[3] = _matrix[12];
     mat[4] = _matrix[1], mat[5] = _matrix[5], mat[6] = _matrix[9], mat[7] = _matrix[13];
     mat[8] = _matrix[2], mat[9] = _matrix[6], mat[10] = _matrix[10], mat[11] = _matrix[14];
     mat[12] = _matrix[3], mat[13] = _matrix[7], mat[14] = _matrix[11], mat[15] = _matrix[15];
+#endif
 
     return matrix;
 }
 
 Matrix Matrix::inverse() {
+    switch (_type) {
+    case MatrixType::Orthonormal:
+        return inverseOrthonormal();
+    case MatrixType::Rigid:
+        return inverseRigid();
+    case MatrixType::Affine:
+        return inverseAffine();
+    default:
+        return _inverseGeneral();
+    }
+}
+
+Matrix Matrix::inverseAffine() {
+
+    MATH_ALIGN float result[16];
+    const float* m = _matrix;
+
+    //Cofactors of the first row give the determinant of the 3x3
+    float c00 = m[5] * m[10] - m[6] * m[9];
+    float c01 = m[6] * m[8] - m[4] * m[10];
+    float c02 = m[4] * m[9] - m[5] * m[8];
+    float det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+
+    //Determinant cannot equal zero, same as the general inverse the matrix is returned unchanged
+    if (det == 0) {
+        return Matrix(*this);
+    }
+    float invDet = 1.0f / det;
+
+    result[0] = c00 * invDet;
+    result[1] = (m[2] * m[9] - m[1] * m[10]) * invDet;
+    result[2] = (m[1] * m[6] - m[2] * m[5]) * invDet;
+    result[4] = c01 * invDet;
+    result[5] = (m[0] * m[10] - m[2] * m[8]) * invDet;
+    result[6] = (m[2] * m[4] - m[0] * m[6]) * invDet;
+    result[8] = c02 * invDet;
+    result[9] = (m[1] * m[8] - m[0] * m[9]) * invDet;
+    result[10] = (m[0] * m[5] - m[1] * m[4]) * invDet;
+
+    //Translation is undone by the inverse 3x3
+    result[3] = -(result[0] * m[3] + result[1] * m[7] + result[2] * m[11]);
+    result[7] = -(result[4] * m[3] + result[5] * m[7] + result[6] * m[11]);
+    result[11] = -(result[8] * m[3] + result[9] * m[7] + result[10] * m[11]);
+
+    result[12] = 0.0f, result[13] = 0.0f, result[14] = 0.0f, result[15] = 1.0f;
+
+    return Matrix(result, MatrixType::Affine);
+}
+
+Matrix Matrix::inverseRigid() {
+
+    MATH_ALIGN float result[16];
+    const float* m = _matrix;
+
+    //Inverse of a rotation is its transpose
+    result[0] = m[0], result[1] = m[4], result[2] = m[8];
+    result[4] = m[1], result[5] = m[5], result[6] = m[9];
+    result[8] = m[2], result[9] = m[6], result[10] = m[10];
+
+    //Translation is undone by the transposed rotation
+    result[3] = -(result[0] * m[3] + result[1] * m[7] + result[2] * m[11]);
+    result[7] = -(result[4] * m[3] + result[5] * m[7] + result[6] * m[11]);
+    result[11] = -(result[8] * m[3] + result[9] * m[7] + result[10] * m[11]);
+
+    result[12] = 0.0f, result[13] = 0.0f, result[14] = 0.0f, result[15] = 1.0f;
+
+    return Matrix(result, MatrixType::Rigid);
+}
+
+Matrix Matrix::inverseOrthonormal() {
+    return transpose();
+}
+
+Matrix Matrix::normalMatrix() {
+    //A pure rotation is its own inverse transpose
+    if (_type == MatrixType::Orthonormal) {
+        return Matrix(*this);
+    }
+    return inverse().transpose();
+}
+
+Matrix Matrix::_inverseGeneral() {
 
     Matrix matrix(_matrix);
     float* mat = matrix.getFlatBuffer();
@@ -114,23 +228,80 @@ Matrix Matrix::inverse() {
     return matrix;
 }
 
-Vector4 Matrix::operator * (Vector4 vec) {
-    Vector4 result; //Get underlying vector memory
-    float* vector = vec.getFlatBuffer();
-
+Vector4 Matrix::operator * (const Vector4& vec) {
+    const float* vector = vec.getFlatBuffer();
+
+#if defined(MATH_SSE)
+    //Sum the matrix columns scaled by each vector component, same add order as the scalar dot products
+    __m128 col0 = _mm_load_ps(&_matrix[0]);
+    __m128 col1 = _mm_load_ps(&_matrix[4]);
+    __m128 col2 = _mm_load_ps(&_matrix[8]);
+    __m128 col3 = _mm_load_ps(&_matrix[12]);
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+    __m128 result = _mm_mul_ps(col0, _mm_set1_ps(vector[0]));
+    result = _mm_add_ps(result, _mm_mul_ps(col1, _mm_set1_ps(vector[1])));
+    result = _mm_add_ps(result, _mm_mul_ps(col2, _mm_set1_ps(vector[2])));
+    result = _mm_add_ps(result, _mm_mul_ps(col3, _mm_set1_ps(vector[3])));
+
+    Vector4 product;
+    _mm_store_ps(product.getFlatBuffer(), result);
+    return product;
+#elif defined(MATH_NEON)
+    float32x4x4_t columns = vld4q_f32(_matrix);
+
+    float32x4_t result = vmulq_n_f32(columns.val[0], vector[0]);
+    result = vaddq_f32(result, vmulq_n_f32(columns.val[1], vector[1]));
+    result = vaddq_f32(result, vmulq_n_f32(columns.val[2], vector[2]));
+    result = vaddq_f32(result, vmulq_n_f32(columns.val[3], vector[3]));
+
+    Vector4 product;
+    vst1q_f32(product.getFlatBuffer(), result);
+    return product;
+#else
     float x = _matrix[0] * vector[0] + _matrix[1] * vector[1] + _matrix[2] * vector[2] + _matrix[3] * vector[3];
     float y = _matrix[4] * vector[0] + _matrix[5] * vector[1] + _matrix[6] * vector[2] + _matrix[7] * vector[3];
     float z = _matrix[8] * vector[0] + _matrix[9] * vector[1] + _matrix[10] * vector[2] + _matrix[11] * vector[3];
     float w = _matrix[12] * vector[0] + _matrix[13] * vector[1] + _matrix[14] * vector[2] + _matrix[15] * vector[3];
 
     return Vector4(x, y, z, w);
+#endif
 }
 
-Matrix Matrix::operator * (Matrix mat) {
+Matrix Matrix::operator * (const Matrix& mat) {
 
-    float result[16]; //Get underlying matrix memory
-    float* matBuff = mat.getFlatBuffer();
+    MATH_ALIGN float result[16]; //Get underlying matrix memory
+    const float* matBuff = mat._matrix;
 
+#if defined(MATH_SSE)
+    //Each result row is the rows of mat scaled by that row's entries, same add order as the scalar code
+    __m128 row0 = _mm_load_ps(&matBuff[0]);
+    __m128 row1 = _mm_load_ps(&matBuff[4]);
+    __m128 row2 = _mm_load_ps(&matBuff[8]);
+    __m128 row3 = _mm_load_ps(&matBuff[12]);
+
+    for (int i = 0; i < 16; i += 4) {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(_matrix[i]), row0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(_matrix[i + 1]), row1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(_matrix[i + 2]), row2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(_matrix[i + 3]), row3));
+        _mm_store_ps(&result[i], row);
+    }
+#elif defined(MATH_NEON)
+    float32x4_t row0 = vld1q_f32(&matBuff[0]);
+    float32x4_t row1 = vld1q_f32(&matBuff[4]);
+    float32x4_t row2 = vld1q_f32(&matBuff[8]);
+    float32x4_t row3 = vld1q_f32(&matBuff[12]);
+
+    //Separate multiply and add, a fused multiply add would round differently than the scalar path
+    for (int i = 0; i < 16; i += 4) {
+        float32x4_t row = vmulq_n_f32(row0, _matrix[i]);
+        row = vaddq_f32(row, vmulq_n_f32(row1, _matrix[i + 1]));
+        row = vaddq_f32(row, vmulq_n_f32(row2, _matrix[i + 2]));
+        row = vaddq_f32(row, vmulq_n_f32(row3, _matrix[i + 3]));
+        vst1q_f32(&result[i], row);
+    }
+#else
     result[0] = _matrix[0] * matBuff[0] + _matrix[1] * matBuff[4] + _matrix[2] * matBuff[8] + _matrix[3] * matBuff[12];
     result[1] = _matrix[0] * matBuff[1] + _matrix[1] * matBuff[5] + _matrix[2] * matBuff[9] + _matrix[3] * matBuff[13];
     result[2] = _matrix[0] * matBuff[2] + _matrix[1] * matBuff[6] + _matrix[2] * matBuff[10] + _matrix[3] * matBuff[14];
@@ -150,8 +321,9 @@ Matrix Matrix::operator * (Matrix mat) {
     result[13] = _matrix[12] * matBuff[1] + _matrix[13] * matBuff[5] + _matrix[14] * matBuff[9] + _matrix[15] * matBuff[13];
     result[14] = _matrix[12] * matBuff[2] + _matrix[13] * matBuff[6] + _matrix[14] * matBuff[10] + _matrix[15] * matBuff[14];
     result[15] = _matrix[12] * matBuff[3] + _matrix[13] * matBuff[7] + _matrix[14] * matBuff[11] + _matrix[15] * matBuff[15];
+#endif
 
-    return Matrix(result);
+    return Matrix(result, _type > mat._type ? _type : mat._type);
 }
 Matrix Matrix::operator + (Matrix mat) {
 
@@ -244,7 +416,7 @@ Matrix Matrix::rotationAroundX(float degrees) {
     result[8] = 0.0, result[9] = sin(theta), result[10] = cos(theta), result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Orthonormal);
 }
 
 
@@ -262,7 +434,7 @@ Matrix Matrix::rotationAroundY(float degrees) {
     result[8] = -sin(theta), result[9] = 0.0, result[10] = cos(theta), result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Orthonormal);
 }
 
 
@@ -280,7 +452,7 @@ Matrix Matrix::rotationAroundZ(float degrees) {
     result[8] = 0.0, result[9] = 0.0, result[10] = 1.0, result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Orthonormal);
 }
 
 //Translation Matrix of a +5 change in X position
@@ -296,7 +468,7 @@ Matrix Matrix::translation(float x, float y, float z) {
     result[8] = 0.0, result[9] = 0.0, result[10] = 1.0, result[11] = z;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Rigid);
 }
 
 //Scale Matrix of 2
@@ -312,7 +484,7 @@ Matrix Matrix::scale(float scalar) {
     result[8] = 0.0, result[9] = 0.0, result[10] = scalar, result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Affine);
 }
 
 //Scale Matrix of 2, 4 and 5
@@ -328,7 +500,7 @@ Matrix Matrix::scale(float x, float y, float z) {
     result[8] = 0.0, result[9] = 0.0, result[10] = z, result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Affine);
 }
 
 //Camera Rotation Matrix is opposite
@@ -341,7 +513,7 @@ Matrix Matrix::cameraRotationAroundX(float degrees) {
     result[8] = 0.0, result[9] = sin(theta), result[10] = cos(theta), result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Orthonormal);
 }
 
 
@@ -355,7 +527,7 @@ Matrix Matrix::cameraRotationAroundY(float degrees) {
     result[8] = -sin(theta), result[9] = 0.0, result[10] = cos(theta), result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Orthonormal);
 }
 
 //Camera Rotation Matrix is opposite
@@ -368,7 +540,7 @@ Matrix Matrix::cameraRotationAroundZ(float degrees) {
     result[8] = 0.0, result[9] = 0.0, result[10] = 1.0, result[11] = 0.0;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Orthonormal);
 }
 
 //Camera Translation Matrix is opposite
@@ -380,7 +552,7 @@ Matrix Matrix::cameraTranslation(float x, float y, float z) {
     result[8] = 0.0, result[9] = 0.0, result[10] = 1.0, result[11] = -z;
     result[12] = 0.0, result[13] = 0.0, result[14] = 0.0, result[15] = 1.0;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Rigid);
 }
 
 Matrix Matrix::cameraProjection(float angleOfView, float imageAspectRatio, float n, float f) {
@@ -419,7 +591,7 @@ Matrix Matrix::cameraOrtho(float orthoWidth, float orthoHeight, float n, float f
     result[8] = 0.0f, result[9] = 0.0f, result[10] = -2.0f / (f - n), result[11] = -(f + n) / (f - n);
     result[12] = 0.0f, result[13] = 0.0f, result[14] = 0.0f, result[15] = 1.0f;
 
-    return Matrix(result);
+    return Matrix(result, MatrixType::Affine);
 
 }
 
@@ -2,32 +2,43 @@
 #include "SimpleContext.h"
 #include "FbxLoader.h"
 #include "GeometryBuilder.h"
-
-TextureBroker* Model::_textureManager = TextureBroker::instance();
+#include "HashCombine.h"
+#include <functional>
+#include <math.h>
+#include <string.h>
 
 Model::Model(ViewManagerEvents* eventWrapper, RenderBuffers& renderBuffers, StaticShader* pStaticShader)
     : UpdateInterface(eventWrapper),
     _classId(ModelClass::ModelType),
     _fbxLoader(nullptr),
     _clock(MasterClock::instance()),
+    _textureManager(TextureBroker::instance()),
+    _materialManager(MaterialBroker::instance()),
     _debugMode(false),
     _debugShaderProgram(new DebugShader("debugShader")),
     _geometryType(GeometryType::Triangle),
     _renderBuffers(std::move(renderBuffers)),
     _shaderProgram(pStaticShader),
-    _isInstanced(false)
+    _isInstanced(false),
+    _instanceBoundsDirty(false),
+    _isOccluder(false)
 {
     _vao.createVAO(&_renderBuffers, _classId);
+    _computeBounds();
 }
 
 Model::Model(std::string name, ViewManagerEvents* eventWrapper, ModelClass classId) : UpdateInterface(eventWrapper),
 _fbxLoader(nullptr),
-_clock(MasterClock::instance()) {
+_clock(MasterClock::instance()),
+_textureManager(TextureBroker::instance()),
+_materialManager(MaterialBroker::instance()) {
 
     //Set class id
     _classId = classId;
 
     _isInstanced = false;
+    _instanceBoundsDirty = false;
+    _isOccluder = false;
 
     //disable debug mode
     _debugMode = false;
@@ -40,6 +51,9 @@ _clock(MasterClock::instance()) {
     //Populate model with fbx file data and recursivelty search with the root node of the scene
     _fbxLoader->loadModel(this, _fbxLoader->getScene()->GetRootNode());
 
+    //Bounds come from the loaded vertices before any of them are handed off to the gpu
+    _computeBounds();
+
     //GeometryBuilder::buildCube(this); //Add a generic cube centered at the origin
 
     //Create vao contexts
@@ -86,6 +100,17 @@ Model::~Model() {
 
 void Model::_updateDraw() {
 
+    //Static models are culled and queued by the scene's recording threads, only draws that
+    //need the gl thread right away are left here
+    if (_classId != ModelClass::AnimatedModelType && !_debugMode) {
+        return;
+    }
+
+    //Skip models that are completely outside of the camera's view
+    if (!isVisible(Frustum(_mvp.getProjectionMatrix() * _mvp.getViewMatrix()))) {
+        return;
+    }
+
     //if debugging normals, etc.
     if (_debugMode) {
 
@@ -93,9 +118,48 @@ void Model::_updateDraw() {
         _debugShaderProgram->runShader(this);
     }
 
-    //Run model shader by allowing the shader to operate on the model
-    _shaderProgram->runShader(this);
+    //Skinned models need their bone uniforms so they keep drawing right away
+    if (_classId == ModelClass::AnimatedModelType) {
+        _shaderProgram->runShader(this);
+    }
+}
+
+void Model::recordDraws(DrawList* drawList, const OcclusionBuffer* occlusionBuffer) {
 
+    //Skinned models draw themselves on the gl thread
+    if (_classId == ModelClass::AnimatedModelType) {
+        return;
+    }
+
+    //Skip models that are completely outside of the camera's view
+    if (!isVisible(Frustum(_mvp.getProjectionMatrix() * _mvp.getViewMatrix()))) {
+        return;
+    }
+
+    //Skip models completely behind this frame's occluders, an occluder would hide itself
+    if (occlusionBuffer != nullptr && !_isOccluder) {
+        Matrix boundsTransform;
+        if (_isInstanced) {
+            //isVisible just rebuilt the box around every instance
+            float* c = _instanceBoundsCenter.getFlatBuffer();
+            float* e = _instanceBoundsHalfExtent.getFlatBuffer();
+            boundsTransform = Matrix::translation(c[0], c[1], c[2]) * Matrix::scale(e[0], e[1], e[2]);
+        }
+        else {
+            boundsTransform = getBoundsTransform();
+        }
+        if (occlusionBuffer->isOccluded(boundsTransform)) {
+            return;
+        }
+    }
+
+    //Queue the model's draws with its camera distance, the scene sorts and submits them
+    //once every model has been queued
+    Vector4 center;
+    Vector4 halfExtent;
+    getWorldBounds(center, halfExtent);
+    Vector4 viewCenter = _mvp.getViewMatrix() * center;
+    _shaderProgram->recordDraws(this, drawList, -viewCenter.getz());
 }
 
 void Model::_updateKeyboard(int key, int x, int y) {
@@ -110,7 +174,7 @@ void Model::_updateView(Matrix view) {
     _mvp.setView(view); //Receive updates when the view matrix has changed
 
     //If view changes then change our normal matrix
-    _mvp.setNormal(view.inverse().transpose());
+    _mvp.setNormal(view.normalMatrix());
 }
 
 void Model::_updateProjection(Matrix projection) {
@@ -151,27 +215,52 @@ size_t Model::getArrayCount() {
 
 void Model::addTexture(std::string textureName, int stride) {
     _textureStrides.push_back(std::pair<std::string, int>(textureName, stride));
-    _textureManager->addTexture(textureName);
+    StrideTexture strideTexture;
+    strideTexture.layered = false;
+    strideTexture.texture = _textureManager->addTexture(textureName);
+    strideTexture.material = _materialManager->getTexturedMaterial(strideTexture.texture);
+    _strideTextures.push_back(strideTexture);
+}
+
+void Model::addTerrainTexture(std::string textureName, std::vector<std::string> layerNames, int stride) {
+    _textureStrides.push_back(std::pair<std::string, int>(textureName, stride));
+    std::vector<TextureHandle> layers;
+    for (auto& layerName : layerNames) {
+        layers.push_back(_textureManager->addTexture(layerName));
+    }
+    StrideTexture strideTexture;
+    strideTexture.layered = false;
+    strideTexture.texture = _textureManager->addTexture(textureName);
+    strideTexture.material = _materialManager->getTerrainMaterial(strideTexture.texture, layers);
+    _strideTextures.push_back(strideTexture);
 }
 
 void Model::addLayeredTexture(std::vector<std::string> textureNames, int stride) {
 
     //Encode layered into string to notify shader what type of texture is used
-    std::string sumString = "Layered";
-    for (auto& str : textureNames) {
-        sumString += str;
-    }
     //Create sum string for later identification
-    _textureStrides.push_back(std::pair<std::string, int>(sumString, stride));
-    _textureManager->addLayeredTexture(textureNames);
+    _textureStrides.push_back(std::pair<std::string, int>(TextureBroker::getLayeredName(textureNames), stride));
+    StrideTexture strideTexture;
+    strideTexture.layered = true;
+    strideTexture.layeredTexture = _textureManager->addLayeredTexture(textureNames);
+    strideTexture.material = _materialManager->getLayeredMaterial(strideTexture.layeredTexture);
+    _strideTextures.push_back(strideTexture);
 }
 
-Texture* Model::getTexture(std::string textureName) {
-    return _textureManager->getTexture(textureName);
+bool Model::isLayeredStride(int stride) {
+    return _strideTextures[stride].layered;
 }
 
-LayeredTexture* Model::getLayeredTexture(std::string textureName) {
-    return _textureManager->getLayeredTexture(textureName);
+Texture* Model::getStrideTexture(int stride) {
+    return _textureManager->getTexture(_strideTextures[stride].texture);
+}
+
+LayeredTexture* Model::getStrideLayeredTexture(int stride) {
+    return _textureManager->getLayeredTexture(_strideTextures[stride].layeredTexture);
+}
+
+Material* Model::getStrideMaterial(int stride) {
+    return _strideTextures[stride].material;
 }
 
 TextureMetaData& Model::getTextureStrides() {
@@ -224,20 +313,161 @@ void Model::setVelocity(Vector4 velocity) {
 }
 
 void Model::setInstances(std::vector<Vector4> offsets) {
-    _isInstanced = true;
-    int i = 0;
+    std::vector<Matrix> transforms;
+    transforms.reserve(offsets.size());
     for (auto& offset : offsets) {
-        _offsets[i++] = offset.getx();
-        _offsets[i++] = offset.gety();
-        _offsets[i++] = offset.getz();
+        transforms.push_back(Matrix::translation(offset.getx(), offset.gety(), offset.getz()));
     }
-    _instances = static_cast<int>(offsets.size());
+    setInstanceTransforms(transforms);
+}
+
+void Model::setInstanceTransforms(std::vector<Matrix> transforms) {
+
+    //First time instancing so hook the visible instance indices up to a vao of the model's own
+    if (!_isInstanced) {
+        _instanceBuffer.attach(_vao.detachVAOContext(), INSTANCE_INDEX_LOCATION);
+    }
+    _isInstanced = true;
+    _instanceTransforms = std::move(transforms);
+    _instanceBuffer.markDirty(0, _instanceTransforms.size());
+    _instanceBoundsDirty = true;
+}
+
+void Model::setInstanceTransform(size_t index, Matrix transform) {
+    _instanceTransforms[index] = transform;
+    _instanceBuffer.markDirty(index, 1);
+    _instanceBoundsDirty = true;
+}
+
+void Model::setOccluder(bool occluder) {
+    _isOccluder = occluder;
+}
+
+bool Model::isOccluder() {
+    return _isOccluder;
 }
 
 bool Model::getIsInstancedModel() {
     return _isInstanced;
 }
 
-float* Model::getInstanceOffsets() {
-    return _offsets;
+std::vector<Matrix>& Model::getInstanceTransforms() {
+    return _instanceTransforms;
+}
+
+InstanceBuffer* Model::getInstanceBuffer() {
+    return &_instanceBuffer;
+}
+
+size_t Model::getInstanceCount() {
+    return _instanceTransforms.size();
+}
+
+void Model::_computeBounds() {
+
+    std::vector<Vector4>* vertices = _renderBuffers.getVertices();
+    if (vertices->empty()) {
+        _boundsCenter = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+        _boundsHalfExtent = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    Vector4 minimum = (*vertices)[0];
+    Vector4 maximum = (*vertices)[0];
+    float* min = minimum.getFlatBuffer();
+    float* max = maximum.getFlatBuffer();
+    for (Vector4& vertex : *vertices) {
+        float* values = vertex.getFlatBuffer();
+        for (int axis = 0; axis < 3; axis++) {
+            min[axis] = values[axis] < min[axis] ? values[axis] : min[axis];
+            max[axis] = values[axis] > max[axis] ? values[axis] : max[axis];
+        }
+    }
+    _boundsCenter = Vector4((min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f, 1.0f);
+    _boundsHalfExtent = Vector4((max[0] - min[0]) * 0.5f, (max[1] - min[1]) * 0.5f, (max[2] - min[2]) * 0.5f, 0.0f);
+}
+
+//Axis aligned box around a transformed box.  The box's reach along each axis is the sum of
+//its half widths scaled by the absolute values in that row of the transform.
+static void transformBox(Matrix& transform, Vector4& center, Vector4& halfExtent,
+                         Vector4& outCenter, Vector4& outHalfExtent) {
+    float* m = transform.getFlatBuffer();
+    float* e = halfExtent.getFlatBuffer();
+    outCenter = transform * center;
+    outHalfExtent = Vector4(fabsf(m[0]) * e[0] + fabsf(m[1]) * e[1] + fabsf(m[2]) * e[2],
+                            fabsf(m[4]) * e[0] + fabsf(m[5]) * e[1] + fabsf(m[6]) * e[2],
+                            fabsf(m[8]) * e[0] + fabsf(m[9]) * e[1] + fabsf(m[10]) * e[2], 0.0f);
+}
+
+void Model::getWorldBounds(Vector4& center, Vector4& halfExtent) {
+    Matrix model = _mvp.getModelMatrix();
+    transformBox(model, _boundsCenter, _boundsHalfExtent, center, halfExtent);
+}
+
+size_t Model::getTransformSignature() {
+
+    std::hash<float> floatHash;
+    size_t signature = std::hash<Model*>()(this);
+    float* transform = _mvp.getModelBuffer();
+    for (int i = 0; i < 16; i++) {
+        hashCombine(signature, floatHash(transform[i]));
+    }
+    return signature;
+}
+
+Matrix Model::getBoundsTransform() {
+    float* c = _boundsCenter.getFlatBuffer();
+    float* e = _boundsHalfExtent.getFlatBuffer();
+    return _mvp.getModelMatrix() * Matrix::translation(c[0], c[1], c[2]) * Matrix::scale(e[0], e[1], e[2]);
+}
+
+void Model::_computeInstanceBounds(Matrix& model) {
+
+    //Start from the copy drawn without an instance transform
+    Vector4 center;
+    Vector4 halfExtent;
+    getWorldBounds(center, halfExtent);
+    Vector4 minimum = center - halfExtent;
+    Vector4 maximum = center + halfExtent;
+    float* min = minimum.getFlatBuffer();
+    float* max = maximum.getFlatBuffer();
+
+    for (Matrix& transform : _instanceTransforms) {
+        Vector4 instanceCenter;
+        Vector4 instanceHalfExtent;
+        transformBox(transform, center, halfExtent, instanceCenter, instanceHalfExtent);
+        float* c = instanceCenter.getFlatBuffer();
+        float* e = instanceHalfExtent.getFlatBuffer();
+        for (int axis = 0; axis < 3; axis++) {
+            min[axis] = c[axis] - e[axis] < min[axis] ? c[axis] - e[axis] : min[axis];
+            max[axis] = c[axis] + e[axis] > max[axis] ? c[axis] + e[axis] : max[axis];
+        }
+    }
+    _instanceBoundsCenter = (minimum + maximum) * 0.5f;
+    _instanceBoundsHalfExtent = (maximum - minimum) * 0.5f;
+    _instanceBoundsModel = model;
+    _instanceBoundsDirty = false;
+}
+
+bool Model::isVisible(const Frustum& frustum) {
+
+    //Skinning can move vertices outside of the bind pose box
+    if (_classId == ModelClass::AnimatedModelType) {
+        return true;
+    }
+
+    //The box around every instance is only rebuilt when the instances or the model matrix move
+    if (_isInstanced) {
+        Matrix model = _mvp.getModelMatrix();
+        if (_instanceBoundsDirty ||
+            memcmp(model.getFlatBuffer(), _instanceBoundsModel.getFlatBuffer(), 16 * sizeof(float)) != 0) {
+            _computeInstanceBounds(model);
+        }
+        return frustum.aabbVisible(_instanceBoundsCenter, _instanceBoundsHalfExtent);
+    }
+
+    Vector4 center;
+    Vector4 halfExtent;
+    getWorldBounds(center, halfExtent);
+    return frustum.aabbVisible(center, halfExtent);
 }
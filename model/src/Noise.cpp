@@ -11,11 +11,11 @@ float ValueNoise2D::noise(float x, float y) {
     // modf requires a pointer argument, and it must not be NULL.
     float dummy = 0;
 
-    float    xf = modf(x, &dummy);
+    float    xf = std::modf(x, &dummy);
     uint32_t x1 = (uint32_t(x) + w) % w;
     uint32_t x2 = (x1 + w - 1) % w;
 
-    float    yf = modf(y, &dummy);
+    float    yf = std::modf(y, &dummy);
     uint32_t y1 = (uint32_t(y) + h) % h;
     uint32_t y2 = (y1 + h - 1) % h;
 
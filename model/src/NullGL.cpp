@@ -0,0 +1,944 @@
+#include "NullGL.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+
+typedef std::chrono::high_resolution_clock NullClock;
+
+struct NullBuffer {
+    std::vector<unsigned char> data; //Contents are kept so mapped writes and read backs behave
+    bool                       mapped;
+};
+
+static struct {
+    bool                                                       installed;
+    GLuint                                                     nextName; //Every kind of object shares one counter
+    uintptr_t                                                  nextSync;
+    std::unordered_map<GLuint, NullBuffer>                     buffers;
+    std::unordered_set<GLuint>                                 textures;
+    std::unordered_set<GLuint>                                 vertexArrays;
+    std::unordered_set<GLuint>                                 framebuffers;
+    std::unordered_set<GLuint>                                 renderbuffers;
+    std::unordered_set<GLuint>                                 shaders;
+    std::unordered_set<GLuint>                                 programs;
+    std::unordered_map<GLuint, std::unordered_map<std::string, GLint>> uniformLocations; //Per program
+    std::unordered_map<GLenum, GLuint>                         boundBuffers; //Per target
+    std::map<std::pair<GLenum, GLuint>, std::pair<GLuint, GLintptr>> boundRanges; //Per indexed target, buffer and offset
+    std::map<std::pair<GLuint, GLenum>, GLuint>                boundTextures; //Per unit and target
+    std::unordered_map<GLenum, bool>                           capabilities; //Enable and disable state
+    GLuint                                                     activeUnit;
+    GLuint                                                     program;
+    GLuint                                                     vertexArray;
+    GLuint                                                     framebuffer;
+    GLuint                                                     renderbuffer;
+    GLint                                                      viewport[4];
+    GLenum                                                     blendFactors[2];
+    GLenum                                                     depthFunc;
+    GLfloat                                                    clearColor[4];
+    GLdouble                                                   clearDepth;
+    std::vector<NullGLPass>                                    passes; //Passes of the frame being recorded
+    std::vector<NullGLPass>                                    passTotals; //Each pass summed over the measured frames
+    NullGLStats                                                totals;
+    size_t                                                     frames;
+    size_t                                                     errors; //Across warm up and measured frames
+    NullClock::time_point                                      passStart;
+} nullState;
+
+static NullGLStats& passStats() {
+    return nullState.passes.back().stats;
+}
+
+static void countCall() {
+    passStats().calls++;
+}
+
+static void countChange(bool changed) {
+    if (changed) {
+        passStats().stateChanges++;
+    }
+    else {
+        passStats().redundantChanges++;
+    }
+}
+
+static void reportError(const std::string& message) {
+    passStats().errors++;
+    if (nullState.errors++ < NULL_GL_MAX_REPORTED_ERRORS) {
+        std::cout << "NullGL: " << message << std::endl;
+    }
+}
+
+static void checkName(const std::unordered_set<GLuint>& names, GLuint name, const char* function) {
+    if (name != 0 && names.find(name) == names.end()) {
+        reportError(std::string(function) + " was given " + std::to_string(name) + " which was never generated");
+    }
+}
+
+static void closePass() {
+    NullClock::time_point now = NullClock::now();
+    passStats().cpuMilliseconds += std::chrono::duration<double, std::milli>(now - nullState.passStart).count();
+    nullState.passStart = now;
+}
+
+static void startPass(GLuint framebuffer) {
+    closePass();
+    NullGLPass pass = {};
+    pass.framebuffer = framebuffer;
+    nullState.passes.push_back(pass);
+}
+
+static void addStats(NullGLStats& total, const NullGLStats& stats) {
+    total.calls += stats.calls;
+    total.drawCalls += stats.drawCalls;
+    total.stateChanges += stats.stateChanges;
+    total.redundantChanges += stats.redundantChanges;
+    total.uploadedBytes += stats.uploadedBytes;
+    total.errors += stats.errors;
+    total.cpuMilliseconds += stats.cpuMilliseconds;
+}
+
+static void genNames(GLsizei n, GLuint* names, std::unordered_set<GLuint>& set) {
+    countCall();
+    for (GLsizei i = 0; i < n; i++) {
+        names[i] = ++nullState.nextName;
+        set.insert(names[i]);
+    }
+}
+
+static void deleteNames(GLsizei n, const GLuint* names, std::unordered_set<GLuint>& set, GLuint& bound) {
+    countCall();
+    for (GLsizei i = 0; i < n; i++) {
+        set.erase(names[i]);
+        if (bound == names[i]) {
+            bound = 0;
+        }
+    }
+}
+
+static NullBuffer* boundBuffer(GLenum target, const char* function) {
+    auto bound = nullState.boundBuffers.find(target);
+    if (bound == nullState.boundBuffers.end() || bound->second == 0) {
+        reportError(std::string(function) + " has no buffer bound to its target");
+        return nullptr;
+    }
+    return &nullState.buffers[bound->second];
+}
+
+static bool checkRange(NullBuffer* buffer, GLintptr offset, GLsizeiptr size, const char* function) {
+    if (offset < 0 || size < 0 || static_cast<size_t>(offset + size) > buffer->data.size()) {
+        reportError(std::string(function) + " range runs past the end of the buffer");
+        return false;
+    }
+    return true;
+}
+
+static void checkDraw(const char* function) {
+    countCall();
+    passStats().drawCalls++;
+    if (nullState.program == 0) {
+        reportError(std::string(function) + " without a program in use");
+    }
+    if (nullState.vertexArray == 0) {
+        reportError(std::string(function) + " without a vertex array bound");
+    }
+}
+
+static void checkIndirect(const char* function) {
+    if (nullState.boundBuffers[GL_DRAW_INDIRECT_BUFFER] == 0) {
+        reportError(std::string(function) + " without an indirect buffer bound");
+    }
+}
+
+static void checkUniform(const char* function) {
+    countCall();
+    if (nullState.program == 0) {
+        reportError(std::string(function) + " without a program in use");
+    }
+}
+
+//Objects
+
+static void APIENTRY nullGenBuffers(GLsizei n, GLuint* buffers) {
+    countCall();
+    for (GLsizei i = 0; i < n; i++) {
+        buffers[i] = ++nullState.nextName;
+        nullState.buffers[buffers[i]].mapped = false;
+    }
+}
+
+static void APIENTRY nullDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    countCall();
+    for (GLsizei i = 0; i < n; i++) {
+        nullState.buffers.erase(buffers[i]);
+        for (auto& bound : nullState.boundBuffers) {
+            if (bound.second == buffers[i]) {
+                bound.second = 0;
+            }
+        }
+    }
+}
+
+static void APIENTRY nullGenTextures(GLsizei n, GLuint* textures) {
+    genNames(n, textures, nullState.textures);
+}
+
+static void APIENTRY nullDeleteTextures(GLsizei n, const GLuint* textures) {
+    countCall();
+    for (GLsizei i = 0; i < n; i++) {
+        nullState.textures.erase(textures[i]);
+        for (auto& bound : nullState.boundTextures) {
+            if (bound.second == textures[i]) {
+                bound.second = 0;
+            }
+        }
+    }
+}
+
+static void APIENTRY nullGenVertexArrays(GLsizei n, GLuint* arrays) {
+    genNames(n, arrays, nullState.vertexArrays);
+}
+
+static void APIENTRY nullDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    deleteNames(n, arrays, nullState.vertexArrays, nullState.vertexArray);
+}
+
+static void APIENTRY nullGenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    genNames(n, framebuffers, nullState.framebuffers);
+}
+
+static void APIENTRY nullDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    deleteNames(n, framebuffers, nullState.framebuffers, nullState.framebuffer);
+}
+
+static void APIENTRY nullGenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+    genNames(n, renderbuffers, nullState.renderbuffers);
+}
+
+static GLuint APIENTRY nullCreateShader(GLenum type) {
+    countCall();
+    nullState.shaders.insert(++nullState.nextName);
+    return nullState.nextName;
+}
+
+static GLuint APIENTRY nullCreateProgram() {
+    countCall();
+    nullState.programs.insert(++nullState.nextName);
+    return nullState.nextName;
+}
+
+static void APIENTRY nullShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+    countCall();
+    checkName(nullState.shaders, shader, "glShaderSource");
+}
+
+static void APIENTRY nullCompileShader(GLuint shader) {
+    countCall();
+    checkName(nullState.shaders, shader, "glCompileShader");
+}
+
+static void APIENTRY nullAttachShader(GLuint program, GLuint shader) {
+    countCall();
+    checkName(nullState.programs, program, "glAttachShader");
+    checkName(nullState.shaders, shader, "glAttachShader");
+}
+
+static void APIENTRY nullLinkProgram(GLuint program) {
+    countCall();
+    checkName(nullState.programs, program, "glLinkProgram");
+}
+
+static GLsync APIENTRY nullFenceSync(GLenum condition, GLbitfield flags) {
+    countCall();
+    return reinterpret_cast<GLsync>(++nullState.nextSync);
+}
+
+static GLenum APIENTRY nullClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+    countCall();
+    return GL_ALREADY_SIGNALED;
+}
+
+static void APIENTRY nullDeleteSync(GLsync sync) {
+    countCall();
+}
+
+//Buffer contents
+
+static void APIENTRY nullBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    countCall();
+    NullBuffer* buffer = boundBuffer(target, "glBufferData");
+    if (buffer != nullptr) {
+        if (buffer->mapped) {
+            reportError("glBufferData on a mapped buffer");
+        }
+        buffer->data.assign(static_cast<size_t>(size), 0);
+        if (data != nullptr) {
+            memcpy(buffer->data.data(), data, static_cast<size_t>(size));
+            passStats().uploadedBytes += static_cast<size_t>(size);
+        }
+    }
+}
+
+static void APIENTRY nullBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+    nullBufferData(target, size, data, GL_STATIC_DRAW);
+}
+
+static void APIENTRY nullBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    countCall();
+    NullBuffer* buffer = boundBuffer(target, "glBufferSubData");
+    if (buffer != nullptr && checkRange(buffer, offset, size, "glBufferSubData")) {
+        memcpy(buffer->data.data() + offset, data, static_cast<size_t>(size));
+        passStats().uploadedBytes += static_cast<size_t>(size);
+    }
+}
+
+static void APIENTRY nullGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void* data) {
+    countCall();
+    NullBuffer* buffer = boundBuffer(target, "glGetBufferSubData");
+    if (buffer != nullptr && checkRange(buffer, offset, size, "glGetBufferSubData")) {
+        memcpy(data, buffer->data.data() + offset, static_cast<size_t>(size));
+    }
+}
+
+static void* APIENTRY nullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    countCall();
+    NullBuffer* buffer = boundBuffer(target, "glMapBufferRange");
+    if (buffer == nullptr || !checkRange(buffer, offset, length, "glMapBufferRange")) {
+        return nullptr;
+    }
+    if (buffer->mapped) {
+        reportError("glMapBufferRange on a buffer that is already mapped");
+    }
+    buffer->mapped = true;
+    if (access & GL_MAP_WRITE_BIT) {
+        passStats().uploadedBytes += static_cast<size_t>(length);
+    }
+    return buffer->data.data() + offset;
+}
+
+static GLboolean APIENTRY nullUnmapBuffer(GLenum target) {
+    countCall();
+    NullBuffer* buffer = boundBuffer(target, "glUnmapBuffer");
+    if (buffer != nullptr) {
+        if (!buffer->mapped) {
+            reportError("glUnmapBuffer on a buffer that is not mapped");
+        }
+        buffer->mapped = false;
+    }
+    return GL_TRUE;
+}
+
+static void APIENTRY nullCopyImageSubData(GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY,
+                                       GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX,
+                                       GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth) {
+    countCall();
+    checkName(nullState.textures, srcName, "glCopyImageSubData");
+    checkName(nullState.textures, dstName, "glCopyImageSubData");
+}
+
+//Bindings
+
+static void APIENTRY nullBindBuffer(GLenum target, GLuint buffer) {
+    countCall();
+    if (buffer != 0 && nullState.buffers.find(buffer) == nullState.buffers.end()) {
+        reportError("glBindBuffer was given " + std::to_string(buffer) + " which was never generated");
+    }
+    GLuint& bound = nullState.boundBuffers[target];
+    countChange(bound != buffer);
+    bound = buffer;
+}
+
+static void bindRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, const char* function) {
+    countCall();
+    if (buffer != 0 && nullState.buffers.find(buffer) == nullState.buffers.end()) {
+        reportError(std::string(function) + " was given " + std::to_string(buffer) + " which was never generated");
+    }
+    std::pair<GLuint, GLintptr>& bound = nullState.boundRanges[std::make_pair(target, index)];
+    countChange(bound.first != buffer || bound.second != offset);
+    bound = std::make_pair(buffer, offset);
+    //Indexed binds also replace the generic binding
+    nullState.boundBuffers[target] = buffer;
+}
+
+static void APIENTRY nullBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    bindRange(target, index, buffer, 0, "glBindBufferBase");
+}
+
+static void APIENTRY nullBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    bindRange(target, index, buffer, offset, "glBindBufferRange");
+}
+
+static void APIENTRY nullActiveTexture(GLenum texture) {
+    countCall();
+    GLuint unit = texture - GL_TEXTURE0;
+    countChange(nullState.activeUnit != unit);
+    nullState.activeUnit = unit;
+}
+
+static void APIENTRY nullBindTexture(GLenum target, GLuint texture) {
+    countCall();
+    checkName(nullState.textures, texture, "glBindTexture");
+    GLuint& bound = nullState.boundTextures[std::make_pair(nullState.activeUnit, target)];
+    countChange(bound != texture);
+    bound = texture;
+}
+
+static void APIENTRY nullBindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer,
+                                       GLenum access, GLenum format) {
+    countCall();
+    checkName(nullState.textures, texture, "glBindImageTexture");
+}
+
+static void APIENTRY nullBindVertexArray(GLuint array) {
+    countCall();
+    checkName(nullState.vertexArrays, array, "glBindVertexArray");
+    countChange(nullState.vertexArray != array);
+    nullState.vertexArray = array;
+}
+
+static void APIENTRY nullUseProgram(GLuint program) {
+    countCall();
+    checkName(nullState.programs, program, "glUseProgram");
+    countChange(nullState.program != program);
+    nullState.program = program;
+}
+
+static void APIENTRY nullBindFramebuffer(GLenum target, GLuint framebuffer) {
+    countCall();
+    checkName(nullState.framebuffers, framebuffer, "glBindFramebuffer");
+    if (target == GL_READ_FRAMEBUFFER) {
+        return;
+    }
+    countChange(nullState.framebuffer != framebuffer);
+    if (nullState.framebuffer != framebuffer) {
+        nullState.framebuffer = framebuffer;
+        startPass(framebuffer);
+    }
+}
+
+static void APIENTRY nullBindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    countCall();
+    checkName(nullState.renderbuffers, renderbuffer, "glBindRenderbuffer");
+    countChange(nullState.renderbuffer != renderbuffer);
+    nullState.renderbuffer = renderbuffer;
+}
+
+//Fixed function state
+
+static void setCapability(GLenum cap, bool enabled) {
+    countCall();
+    auto capability = nullState.capabilities.find(cap);
+    bool current = capability != nullState.capabilities.end() && capability->second;
+    countChange(current != enabled);
+    nullState.capabilities[cap] = enabled;
+}
+
+static void APIENTRY nullEnable(GLenum cap) {
+    setCapability(cap, true);
+}
+
+static void APIENTRY nullDisable(GLenum cap) {
+    setCapability(cap, false);
+}
+
+static void APIENTRY nullViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    countCall();
+    GLint viewport[4] = { x, y, width, height };
+    countChange(memcmp(viewport, nullState.viewport, sizeof(viewport)) != 0);
+    memcpy(nullState.viewport, viewport, sizeof(viewport));
+}
+
+static void APIENTRY nullBlendFunc(GLenum sfactor, GLenum dfactor) {
+    countCall();
+    countChange(nullState.blendFactors[0] != sfactor || nullState.blendFactors[1] != dfactor);
+    nullState.blendFactors[0] = sfactor;
+    nullState.blendFactors[1] = dfactor;
+}
+
+static void APIENTRY nullDepthFunc(GLenum func) {
+    countCall();
+    countChange(nullState.depthFunc != func);
+    nullState.depthFunc = func;
+}
+
+static void APIENTRY nullClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    countCall();
+    GLfloat color[4] = { red, green, blue, alpha };
+    countChange(memcmp(color, nullState.clearColor, sizeof(color)) != 0);
+    memcpy(nullState.clearColor, color, sizeof(color));
+}
+
+static void APIENTRY nullClearDepth(GLdouble depth) {
+    countCall();
+    countChange(nullState.clearDepth != depth);
+    nullState.clearDepth = depth;
+}
+
+//Draws
+
+static void APIENTRY nullClear(GLbitfield mask) {
+    countCall();
+}
+
+static void APIENTRY nullDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    checkDraw("glDrawArrays");
+}
+
+static void APIENTRY nullDrawArraysIndirect(GLenum mode, const void* indirect) {
+    checkDraw("glDrawArraysIndirect");
+    checkIndirect("glDrawArraysIndirect");
+}
+
+static void APIENTRY nullDrawArraysInstancedBaseInstance(GLenum mode, GLint first, GLsizei count, GLsizei instancecount,
+                                                      GLuint baseinstance) {
+    checkDraw("glDrawArraysInstancedBaseInstance");
+}
+
+static void APIENTRY nullDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                             GLint basevertex) {
+    checkDraw("glDrawElementsBaseVertex");
+}
+
+static void APIENTRY nullMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount,
+                                                GLsizei stride) {
+    checkDraw("glMultiDrawElementsIndirect");
+    checkIndirect("glMultiDrawElementsIndirect");
+}
+
+static void APIENTRY nullDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z) {
+    countCall();
+    passStats().drawCalls++;
+    if (nullState.program == 0) {
+        reportError("glDispatchCompute without a program in use");
+    }
+}
+
+static void APIENTRY nullMemoryBarrier(GLbitfield barriers) {
+    countCall();
+}
+
+//Uniforms
+
+static void APIENTRY nullUniform1f(GLint location, GLfloat v0) {
+    checkUniform("glUniform1f");
+}
+
+static void APIENTRY nullUniform1i(GLint location, GLint v0) {
+    checkUniform("glUniform1i");
+}
+
+static void APIENTRY nullUniform1ui(GLint location, GLuint v0) {
+    checkUniform("glUniform1ui");
+}
+
+static void APIENTRY nullUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    checkUniform("glUniform3f");
+}
+
+static void APIENTRY nullUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    checkUniform("glUniform3fv");
+}
+
+static void APIENTRY nullUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    checkUniform("glUniform4fv");
+}
+
+static void APIENTRY nullUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    checkUniform("glUniformMatrix4fv");
+}
+
+static void APIENTRY nullUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) {
+    countCall();
+    checkName(nullState.programs, program, "glUniformBlockBinding");
+}
+
+static GLint APIENTRY nullGetUniformLocation(GLuint program, const GLchar* name) {
+    countCall();
+    checkName(nullState.programs, program, "glGetUniformLocation");
+    //Locations only need to be stable and distinct within a program
+    std::unordered_map<std::string, GLint>& locations = nullState.uniformLocations[program];
+    auto location = locations.find(name);
+    if (location == locations.end()) {
+        location = locations.emplace(name, static_cast<GLint>(locations.size())).first;
+    }
+    return location->second;
+}
+
+static GLuint APIENTRY nullGetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName) {
+    return static_cast<GLuint>(nullGetUniformLocation(program, uniformBlockName));
+}
+
+//Vertex attributes
+
+static void APIENTRY nullEnableVertexAttribArray(GLuint index) {
+    countCall();
+    if (nullState.vertexArray == 0) {
+        reportError("glEnableVertexAttribArray without a vertex array bound");
+    }
+}
+
+static void APIENTRY nullVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+                                          const void* pointer) {
+    countCall();
+    if (nullState.vertexArray == 0 || nullState.boundBuffers[GL_ARRAY_BUFFER] == 0) {
+        reportError("glVertexAttribPointer needs a vertex array and an array buffer bound");
+    }
+}
+
+static void APIENTRY nullVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer) {
+    countCall();
+    if (nullState.vertexArray == 0 || nullState.boundBuffers[GL_ARRAY_BUFFER] == 0) {
+        reportError("glVertexAttribIPointer needs a vertex array and an array buffer bound");
+    }
+}
+
+static void APIENTRY nullVertexAttribDivisor(GLuint index, GLuint divisor) {
+    countCall();
+}
+
+//Textures and framebuffers
+
+static void APIENTRY nullTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                 GLint border, GLenum format, GLenum type, const void* pixels) {
+    countCall();
+}
+
+static void APIENTRY nullTexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height,
+                                   GLsizei depth) {
+    countCall();
+}
+
+static void APIENTRY nullTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {
+    countCall();
+    if (buffer != 0 && nullState.buffers.find(buffer) == nullState.buffers.end()) {
+        reportError("glTexBuffer was given " + std::to_string(buffer) + " which was never generated");
+    }
+}
+
+static void APIENTRY nullTexParameteri(GLenum target, GLenum pname, GLint param) {
+    countCall();
+}
+
+static void APIENTRY nullTexParameterf(GLenum target, GLenum pname, GLfloat param) {
+    countCall();
+}
+
+static void APIENTRY nullGenerateMipmap(GLenum target) {
+    countCall();
+}
+
+static void APIENTRY nullFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level) {
+    countCall();
+    checkName(nullState.textures, texture, "glFramebufferTexture");
+}
+
+static void APIENTRY nullFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture,
+                                           GLint level) {
+    countCall();
+    checkName(nullState.textures, texture, "glFramebufferTexture2D");
+}
+
+static void APIENTRY nullFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level,
+                                              GLint layer) {
+    countCall();
+    checkName(nullState.textures, texture, "glFramebufferTextureLayer");
+}
+
+static void APIENTRY nullFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget,
+                                              GLuint renderbuffer) {
+    countCall();
+    checkName(nullState.renderbuffers, renderbuffer, "glFramebufferRenderbuffer");
+}
+
+static void APIENTRY nullRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+    countCall();
+}
+
+static GLenum APIENTRY nullCheckFramebufferStatus(GLenum target) {
+    countCall();
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void APIENTRY nullDrawBuffer(GLenum buf) {
+    countCall();
+}
+
+static void APIENTRY nullDrawBuffers(GLsizei n, const GLenum* bufs) {
+    countCall();
+}
+
+static void APIENTRY nullReadBuffer(GLenum src) {
+    countCall();
+}
+
+//Queries
+
+static GLenum APIENTRY nullGetError() {
+    countCall();
+    return GL_NO_ERROR;
+}
+
+static const GLubyte* APIENTRY nullGetString(GLenum name) {
+    countCall();
+    switch (name) {
+    case GL_VERSION:
+        return reinterpret_cast<const GLubyte*>("4.3 NullGL");
+    case GL_SHADING_LANGUAGE_VERSION:
+        return reinterpret_cast<const GLubyte*>("4.30");
+    default:
+        return reinterpret_cast<const GLubyte*>("NullGL");
+    }
+}
+
+static const GLubyte* APIENTRY nullGetStringi(GLenum name, GLuint index) {
+    countCall();
+    reportError("glGetStringi index " + std::to_string(index) + " is past the reported count");
+    return reinterpret_cast<const GLubyte*>("");
+}
+
+static void APIENTRY nullGetIntegerv(GLenum pname, GLint* data) {
+    countCall();
+    switch (pname) {
+    case GL_MAJOR_VERSION:
+        *data = 4;
+        break;
+    case GL_MINOR_VERSION:
+        *data = 3;
+        break;
+    case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT:
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+        *data = 256;
+        break;
+    case GL_VIEWPORT:
+        memcpy(data, nullState.viewport, sizeof(nullState.viewport));
+        break;
+    case GL_CURRENT_PROGRAM:
+        *data = static_cast<GLint>(nullState.program);
+        break;
+    default:
+        //No extensions and no other limits are reported
+        *data = 0;
+        break;
+    }
+}
+
+static void APIENTRY nullGetFloatv(GLenum pname, GLfloat* data) {
+    countCall();
+    *data = pname == GL_MAX_TEXTURE_MAX_ANISOTROPY ? 16.0f : 0.0f;
+}
+
+static void APIENTRY nullGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    countCall();
+    checkName(nullState.shaders, shader, "glGetShaderiv");
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY nullGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+    countCall();
+    checkName(nullState.programs, program, "glGetProgramiv");
+    *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY nullGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    countCall();
+    if (length != nullptr) {
+        *length = 0;
+    }
+    if (bufSize > 0) {
+        infoLog[0] = '\0';
+    }
+}
+
+static void APIENTRY nullGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    nullGetShaderInfoLog(program, bufSize, length, infoLog);
+}
+
+void NullGL::install() {
+
+    nullState.installed = true;
+    nullState.nextName = 0;
+    nullState.nextSync = 0;
+    nullState.activeUnit = 0;
+    nullState.program = 0;
+    nullState.vertexArray = 0;
+    nullState.framebuffer = 0;
+    nullState.renderbuffer = 0;
+    nullState.viewport[0] = 0;
+    nullState.viewport[1] = 0;
+    nullState.viewport[2] = screenPixelWidth;
+    nullState.viewport[3] = screenPixelHeight;
+    nullState.blendFactors[0] = GL_ONE;
+    nullState.blendFactors[1] = GL_ZERO;
+    nullState.depthFunc = GL_LESS;
+    memset(nullState.clearColor, 0, sizeof(nullState.clearColor));
+    nullState.clearDepth = 1.0;
+    nullState.errors = 0;
+    resetTotals();
+
+    //Loading runs before the first frame so its calls land in a pass that is never reported
+    nullState.passes.assign(1, NullGLPass());
+    nullState.passStart = NullClock::now();
+
+    //Only the entry points the engine calls are filled in, anything else stays null and faults
+    //straight away so a new call can not silently go unrecorded
+    gl3wProcs.gl.ActiveTexture = nullActiveTexture;
+    gl3wProcs.gl.AttachShader = nullAttachShader;
+    gl3wProcs.gl.BindBuffer = nullBindBuffer;
+    gl3wProcs.gl.BindBufferBase = nullBindBufferBase;
+    gl3wProcs.gl.BindBufferRange = nullBindBufferRange;
+    gl3wProcs.gl.BindFramebuffer = nullBindFramebuffer;
+    gl3wProcs.gl.BindImageTexture = nullBindImageTexture;
+    gl3wProcs.gl.BindRenderbuffer = nullBindRenderbuffer;
+    gl3wProcs.gl.BindTexture = nullBindTexture;
+    gl3wProcs.gl.BindVertexArray = nullBindVertexArray;
+    gl3wProcs.gl.BlendFunc = nullBlendFunc;
+    gl3wProcs.gl.BufferData = nullBufferData;
+    gl3wProcs.gl.BufferStorage = nullBufferStorage;
+    gl3wProcs.gl.BufferSubData = nullBufferSubData;
+    gl3wProcs.gl.CheckFramebufferStatus = nullCheckFramebufferStatus;
+    gl3wProcs.gl.Clear = nullClear;
+    gl3wProcs.gl.ClearColor = nullClearColor;
+    gl3wProcs.gl.ClearDepth = nullClearDepth;
+    gl3wProcs.gl.ClientWaitSync = nullClientWaitSync;
+    gl3wProcs.gl.CompileShader = nullCompileShader;
+    gl3wProcs.gl.CopyImageSubData = nullCopyImageSubData;
+    gl3wProcs.gl.CreateProgram = nullCreateProgram;
+    gl3wProcs.gl.CreateShader = nullCreateShader;
+    gl3wProcs.gl.DeleteBuffers = nullDeleteBuffers;
+    gl3wProcs.gl.DeleteFramebuffers = nullDeleteFramebuffers;
+    gl3wProcs.gl.DeleteSync = nullDeleteSync;
+    gl3wProcs.gl.DeleteTextures = nullDeleteTextures;
+    gl3wProcs.gl.DeleteVertexArrays = nullDeleteVertexArrays;
+    gl3wProcs.gl.DepthFunc = nullDepthFunc;
+    gl3wProcs.gl.Disable = nullDisable;
+    gl3wProcs.gl.DispatchCompute = nullDispatchCompute;
+    gl3wProcs.gl.DrawArrays = nullDrawArrays;
+    gl3wProcs.gl.DrawArraysIndirect = nullDrawArraysIndirect;
+    gl3wProcs.gl.DrawArraysInstancedBaseInstance = nullDrawArraysInstancedBaseInstance;
+    gl3wProcs.gl.DrawBuffer = nullDrawBuffer;
+    gl3wProcs.gl.DrawBuffers = nullDrawBuffers;
+    gl3wProcs.gl.DrawElementsBaseVertex = nullDrawElementsBaseVertex;
+    gl3wProcs.gl.Enable = nullEnable;
+    gl3wProcs.gl.EnableVertexAttribArray = nullEnableVertexAttribArray;
+    gl3wProcs.gl.FenceSync = nullFenceSync;
+    gl3wProcs.gl.FramebufferRenderbuffer = nullFramebufferRenderbuffer;
+    gl3wProcs.gl.FramebufferTexture = nullFramebufferTexture;
+    gl3wProcs.gl.FramebufferTexture2D = nullFramebufferTexture2D;
+    gl3wProcs.gl.FramebufferTextureLayer = nullFramebufferTextureLayer;
+    gl3wProcs.gl.GenBuffers = nullGenBuffers;
+    gl3wProcs.gl.GenFramebuffers = nullGenFramebuffers;
+    gl3wProcs.gl.GenRenderbuffers = nullGenRenderbuffers;
+    gl3wProcs.gl.GenTextures = nullGenTextures;
+    gl3wProcs.gl.GenVertexArrays = nullGenVertexArrays;
+    gl3wProcs.gl.GenerateMipmap = nullGenerateMipmap;
+    gl3wProcs.gl.GetBufferSubData = nullGetBufferSubData;
+    gl3wProcs.gl.GetError = nullGetError;
+    gl3wProcs.gl.GetFloatv = nullGetFloatv;
+    gl3wProcs.gl.GetIntegerv = nullGetIntegerv;
+    gl3wProcs.gl.GetProgramInfoLog = nullGetProgramInfoLog;
+    gl3wProcs.gl.GetProgramiv = nullGetProgramiv;
+    gl3wProcs.gl.GetShaderInfoLog = nullGetShaderInfoLog;
+    gl3wProcs.gl.GetShaderiv = nullGetShaderiv;
+    gl3wProcs.gl.GetString = nullGetString;
+    gl3wProcs.gl.GetStringi = nullGetStringi;
+    gl3wProcs.gl.GetUniformBlockIndex = nullGetUniformBlockIndex;
+    gl3wProcs.gl.GetUniformLocation = nullGetUniformLocation;
+    gl3wProcs.gl.LinkProgram = nullLinkProgram;
+    gl3wProcs.gl.MapBufferRange = nullMapBufferRange;
+    gl3wProcs.gl.MemoryBarrier = nullMemoryBarrier;
+    gl3wProcs.gl.MultiDrawElementsIndirect = nullMultiDrawElementsIndirect;
+    gl3wProcs.gl.ReadBuffer = nullReadBuffer;
+    gl3wProcs.gl.RenderbufferStorage = nullRenderbufferStorage;
+    gl3wProcs.gl.ShaderSource = nullShaderSource;
+    gl3wProcs.gl.TexBuffer = nullTexBuffer;
+    gl3wProcs.gl.TexImage2D = nullTexImage2D;
+    gl3wProcs.gl.TexParameterf = nullTexParameterf;
+    gl3wProcs.gl.TexParameteri = nullTexParameteri;
+    gl3wProcs.gl.TexStorage3D = nullTexStorage3D;
+    gl3wProcs.gl.Uniform1f = nullUniform1f;
+    gl3wProcs.gl.Uniform1i = nullUniform1i;
+    gl3wProcs.gl.Uniform1ui = nullUniform1ui;
+    gl3wProcs.gl.Uniform3f = nullUniform3f;
+    gl3wProcs.gl.Uniform3fv = nullUniform3fv;
+    gl3wProcs.gl.Uniform4fv = nullUniform4fv;
+    gl3wProcs.gl.UniformBlockBinding = nullUniformBlockBinding;
+    gl3wProcs.gl.UniformMatrix4fv = nullUniformMatrix4fv;
+    gl3wProcs.gl.UnmapBuffer = nullUnmapBuffer;
+    gl3wProcs.gl.UseProgram = nullUseProgram;
+    gl3wProcs.gl.VertexAttribDivisor = nullVertexAttribDivisor;
+    gl3wProcs.gl.VertexAttribIPointer = nullVertexAttribIPointer;
+    gl3wProcs.gl.VertexAttribPointer = nullVertexAttribPointer;
+    gl3wProcs.gl.Viewport = nullViewport;
+}
+
+bool NullGL::isInstalled() {
+    return nullState.installed;
+}
+
+void NullGL::beginFrame() {
+    NullGLPass pass = {};
+    pass.framebuffer = nullState.framebuffer;
+    nullState.passes.assign(1, pass);
+    nullState.passStart = NullClock::now();
+}
+
+void NullGL::endFrame() {
+
+    closePass();
+
+    //Passes are matched up by their order in the frame
+    if (nullState.passTotals.size() < nullState.passes.size()) {
+        nullState.passTotals.resize(nullState.passes.size(), NullGLPass());
+    }
+    for (size_t i = 0; i < nullState.passes.size(); i++) {
+        nullState.passTotals[i].framebuffer = nullState.passes[i].framebuffer;
+        addStats(nullState.passTotals[i].stats, nullState.passes[i].stats);
+        addStats(nullState.totals, nullState.passes[i].stats);
+    }
+    nullState.frames++;
+
+    //Calls between frames are not part of any pass
+    nullState.passes.assign(1, NullGLPass());
+}
+
+void NullGL::resetTotals() {
+    nullState.passTotals.clear();
+    nullState.totals = NullGLStats();
+    nullState.frames = 0;
+}
+
+static void printStats(const NullGLStats& stats, double frames) {
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(9) << stats.cpuMilliseconds / frames << " ms "
+              << std::setprecision(1)
+              << std::setw(9) << stats.calls / frames << " calls "
+              << std::setw(7) << stats.drawCalls / frames << " draws "
+              << std::setw(8) << stats.stateChanges / frames << " changes "
+              << std::setw(8) << stats.redundantChanges / frames << " redundant "
+              << std::setw(11) << stats.uploadedBytes / frames << " bytes "
+              << stats.errors / frames << " errors" << std::endl;
+}
+
+void NullGL::printReport() {
+
+    if (nullState.frames == 0) {
+        std::cout << "NullGL: no frames were measured" << std::endl;
+        return;
+    }
+    double frames = static_cast<double>(nullState.frames);
+    std::cout << "NullGL: averages over " << nullState.frames << " frames" << std::endl;
+    std::cout << "frame            ";
+    printStats(nullState.totals, frames);
+    for (size_t i = 0; i < nullState.passTotals.size(); i++) {
+        std::cout << "pass " << std::setw(2) << i << " fbo " << std::setw(4) << nullState.passTotals[i].framebuffer << " ";
+        printStats(nullState.passTotals[i].stats, frames);
+    }
+    if (nullState.errors > 0) {
+        std::cout << "NullGL: " << nullState.errors << " calls failed validation" << std::endl;
+    }
+}
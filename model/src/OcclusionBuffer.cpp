@@ -0,0 +1,340 @@
+#include "OcclusionBuffer.h"
+#include "BatchMath.h"
+#include <algorithm>
+#include <math.h>
+
+#if defined(MATH_SSE)
+typedef __m128 Lanes;
+typedef __m128 LaneMask;
+
+static inline Lanes _load(const float* values) { return _mm_load_ps(values); }
+static inline void _store(float* values, Lanes a) { _mm_store_ps(values, a); }
+static inline Lanes _splat(float value) { return _mm_set1_ps(value); }
+static inline Lanes _add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+static inline Lanes _sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+static inline Lanes _mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+static inline Lanes _div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+static inline Lanes _min(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+static inline Lanes _max(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+static inline LaneMask _noLanes() { return _mm_setzero_ps(); }
+static inline LaneMask _lessThan(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+static inline LaneMask _or(LaneMask a, LaneMask b) { return _mm_or_ps(a, b); }
+static inline uint32_t _bits(LaneMask mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+static inline void _transpose(Lanes& r0, Lanes& r1, Lanes& r2, Lanes& r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+#elif defined(MATH_NEON)
+typedef float32x4_t Lanes;
+typedef uint32x4_t  LaneMask;
+
+static inline Lanes _load(const float* values) { return vld1q_f32(values); }
+static inline void _store(float* values, Lanes a) { vst1q_f32(values, a); }
+static inline Lanes _splat(float value) { return vdupq_n_f32(value); }
+static inline Lanes _add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+static inline Lanes _sub(Lanes a, Lanes b) { return vsubq_f32(a, b); }
+static inline Lanes _mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+static inline Lanes _div(Lanes a, Lanes b) { return vdivq_f32(a, b); }
+static inline Lanes _min(Lanes a, Lanes b) { return vminq_f32(a, b); }
+static inline Lanes _max(Lanes a, Lanes b) { return vmaxq_f32(a, b); }
+static inline LaneMask _noLanes() { return vdupq_n_u32(0); }
+static inline LaneMask _lessThan(Lanes a, Lanes b) { return vcltq_f32(a, b); }
+static inline LaneMask _or(LaneMask a, LaneMask b) { return vorrq_u32(a, b); }
+static inline uint32_t _bits(LaneMask mask) {
+    const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(mask, vld1q_u32(laneBits)));
+}
+static inline void _transpose(Lanes& r0, Lanes& r1, Lanes& r2, Lanes& r3) {
+    float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    float32x4x2_t t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
+
+OcclusionBuffer::OcclusionBuffer() :
+    _depth(OCCLUSION_WIDTH * OCCLUSION_HEIGHT, 0.0f),
+    _nearPlane(0.0f),
+    _hasOccluders(false) {
+}
+
+OcclusionBuffer::~OcclusionBuffer() {
+
+}
+
+void OcclusionBuffer::clear(const Matrix& projection, const Matrix& view) {
+
+    Matrix cameraProjection = projection;
+    const float* p = cameraProjection.getFlatBuffer();
+    _nearPlane = (2.0f*p[11]) / (2.0f*p[10] - 2.0f);
+    _viewProjection = cameraProjection * view;
+    std::fill(_depth.begin(), _depth.end(), 0.0f);
+    _hasOccluders = false;
+}
+
+void OcclusionBuffer::rasterize(const Matrix& model, const std::vector<Vector4>& vertices,
+                                const std::vector<int>& indices) {
+
+    Matrix viewProjection = _viewProjection;
+    _projected.resize(vertices.size());
+    BatchMath::transformPoints(viewProjection * model, vertices.data(), _projected.data(), vertices.size());
+
+    //Project each vertex once, neighboring triangles share most of them
+    for (Vector4& vertex : _projected) {
+        float* v = vertex.getFlatBuffer();
+
+        //The gpu clips anything in front of the near plane or past the far plane
+        if (v[3] < _nearPlane || v[2] > v[3]) {
+            v[3] = 0.0f;
+            continue;
+        }
+        float reciprocalW = 1.0f / v[3];
+        float x = v[0] * reciprocalW;
+        float y = v[1] * reciprocalW;
+        if (fabsf(x) > OCCLUSION_GUARD_BAND || fabsf(y) > OCCLUSION_GUARD_BAND) {
+            v[3] = 0.0f;
+            continue;
+        }
+        v[0] = (x * 0.5f + 0.5f) * static_cast<float>(OCCLUSION_WIDTH);
+        v[1] = (y * 0.5f + 0.5f) * static_cast<float>(OCCLUSION_HEIGHT);
+        v[2] = reciprocalW;
+        v[3] = 1.0f;
+    }
+
+    //Triangles with a vertex the gpu would clip are left out, a partial occluder only hides less
+    size_t count = indices.empty() ? vertices.size() : indices.size();
+    for (size_t i = 0; i + 2 < count; i += 3) {
+        const float* corners[3];
+        bool projected = true;
+        for (int corner = 0; corner < 3; corner++) {
+            size_t vertex = indices.empty() ? i + corner : static_cast<size_t>(indices[i + corner]);
+            corners[corner] = _projected[vertex].getFlatBuffer();
+            projected = projected && corners[corner][3] != 0.0f;
+        }
+        if (projected) {
+            _rasterizeTriangle(corners[0], corners[1], corners[2]);
+        }
+    }
+    _hasOccluders = _hasOccluders || count >= 3;
+}
+
+void OcclusionBuffer::_rasterizeTriangle(const float* a, const float* b, const float* c) {
+
+    //Counter clockwise order makes every edge function positive inside, back faces occlude too
+    float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+    if (!(area > 0.0f)) {
+        return;
+    }
+
+    //Pixels that can lie inside the triangle, clamped to the screen
+    int minX = std::max(static_cast<int>(floorf(std::min(a[0], std::min(b[0], c[0])))), 0);
+    int maxX = std::min(static_cast<int>(floorf(std::max(a[0], std::max(b[0], c[0])))), OCCLUSION_WIDTH - 1);
+    int minY = std::max(static_cast<int>(floorf(std::min(a[1], std::min(b[1], c[1])))), 0);
+    int maxY = std::min(static_cast<int>(floorf(std::max(a[1], std::max(b[1], c[1])))), OCCLUSION_HEIGHT - 1);
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+
+    //Each edge function is the opposite vertex's barycentric weight times the area and steps by a
+    //constant per pixel, so depth does too
+    float stepX[3] = { b[1] - c[1], c[1] - a[1], a[1] - b[1] };
+    float stepY[3] = { c[0] - b[0], a[0] - c[0], b[0] - a[0] };
+    float x = static_cast<float>(minX) + 0.5f;
+    float y = static_cast<float>(minY) + 0.5f;
+    float rowEdges[3] = { stepY[0] * (y - b[1]) + stepX[0] * (x - b[0]),
+                          stepY[1] * (y - c[1]) + stepX[1] * (x - c[0]),
+                          stepY[2] * (y - a[1]) + stepX[2] * (x - a[0]) };
+    float inverseArea = 1.0f / area;
+    float depthStepX = (stepX[0] * a[2] + stepX[1] * b[2] + stepX[2] * c[2]) * inverseArea;
+    float depthStepY = (stepY[0] * a[2] + stepY[1] * b[2] + stepY[2] * c[2]) * inverseArea;
+    float rowDepth = (rowEdges[0] * a[2] + rowEdges[1] * b[2] + rowEdges[2] * c[2]) * inverseArea;
+
+    //Only pixels the triangle covers completely are written and with the farthest depth inside them,
+    //so an occluder never hides anything it does not hide on screen.  A linear function is smallest at
+    //one of the pixel's corners, half a step in x and in y from the center
+    for (int edge = 0; edge < 3; edge++) {
+        rowEdges[edge] -= 0.5f * (fabsf(stepX[edge]) + fabsf(stepY[edge]));
+    }
+    rowDepth -= 0.5f * (fabsf(depthStepX) + fabsf(depthStepY));
+
+    for (int row = minY; row <= maxY; row++) {
+        float* pixels = &_depth[row * OCCLUSION_WIDTH];
+        float edge0 = rowEdges[0];
+        float edge1 = rowEdges[1];
+        float edge2 = rowEdges[2];
+        float depth = rowDepth;
+        for (int column = minX; column <= maxX; column++) {
+            if (edge0 >= 0.0f && edge1 >= 0.0f && edge2 >= 0.0f && depth > pixels[column]) {
+                pixels[column] = depth;
+            }
+            edge0 += stepX[0];
+            edge1 += stepX[1];
+            edge2 += stepX[2];
+            depth += depthStepX;
+        }
+        rowEdges[0] += stepY[0];
+        rowEdges[1] += stepY[1];
+        rowEdges[2] += stepY[2];
+        rowDepth += depthStepY;
+    }
+}
+
+bool OcclusionBuffer::_rectOccluded(float minX, float maxX, float minY, float maxY, float nearest) const {
+
+    //Boxes off the screen are left to the frustum test
+    int x0 = std::max(static_cast<int>(floorf(minX)), 0);
+    int x1 = std::min(static_cast<int>(floorf(maxX)), OCCLUSION_WIDTH - 1);
+    int y0 = std::max(static_cast<int>(floorf(minY)), 0);
+    int y1 = std::min(static_cast<int>(floorf(maxY)), OCCLUSION_HEIGHT - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+
+    //Any pixel the box touches without an occluder nearer than the box's nearest corner can show it
+    for (int row = y0; row <= y1; row++) {
+        const float* pixels = &_depth[row * OCCLUSION_WIDTH];
+        for (int column = x0; column <= x1; column++) {
+            if (pixels[column] < nearest) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool OcclusionBuffer::isOccluded(const Matrix& transform) const {
+
+    if (!_hasOccluders) {
+        return false;
+    }
+
+    //Columns of the clip space box are its half axes and its center, every corner is the center
+    //plus or minus each axis
+    Matrix viewProjection = _viewProjection;
+    Matrix clip = viewProjection * transform;
+    const float* m = clip.getFlatBuffer();
+    float minX = static_cast<float>(OCCLUSION_WIDTH);
+    float maxX = 0.0f;
+    float minY = static_cast<float>(OCCLUSION_HEIGHT);
+    float maxY = 0.0f;
+    float nearest = 0.0f;
+    for (int corner = 0; corner < 8; corner++) {
+        float sx = (corner & 1) ? 1.0f : -1.0f;
+        float sy = (corner & 2) ? 1.0f : -1.0f;
+        float sz = (corner & 4) ? 1.0f : -1.0f;
+        float w = m[15] + sx * m[12] + sy * m[13] + sz * m[14];
+
+        //A box reaching past the near plane surrounds the camera, nothing can be in front of all of it
+        if (w < _nearPlane) {
+            return false;
+        }
+        float reciprocalW = 1.0f / w;
+        float x = ((m[3] + sx * m[0] + sy * m[1] + sz * m[2]) * reciprocalW * 0.5f + 0.5f) * static_cast<float>(OCCLUSION_WIDTH);
+        float y = ((m[7] + sx * m[4] + sy * m[5] + sz * m[6]) * reciprocalW * 0.5f + 0.5f) * static_cast<float>(OCCLUSION_HEIGHT);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::max(nearest, reciprocalW);
+    }
+
+    return _rectOccluded(minX, maxX, minY, maxY, nearest);
+}
+
+void OcclusionBuffer::testOBBs(const Matrix* transforms, size_t count, uint32_t* visibleMasks) const {
+
+    if (!_hasOccluders) {
+        return;
+    }
+    size_t i = 0;
+
+#if defined(MATH_SSE) || defined(MATH_NEON)
+    //Four boxes at a time with one lane per box for the corner projection, the same operations in
+    //the same order as isOccluded so both give the same screen rectangles
+    Matrix viewProjection = _viewProjection;
+    Matrix clips[4];
+    MATH_ALIGN float rect[5][4];
+    for (; i + 4 <= count; i += 4) {
+        uint32_t visible = (visibleMasks[i / 32] >> (i % 32)) & 0xF;
+        if (visible == 0) {
+            continue;
+        }
+        for (int box = 0; box < 4; box++) {
+            clips[box] = viewProjection * transforms[i + box];
+        }
+
+        //Rows x, y and w of the clip matrices transposed so each element is one register
+        Lanes m[3][4];
+        const int rows[3] = { 0, 1, 3 };
+        for (int row = 0; row < 3; row++) {
+            m[row][0] = _load(&clips[0].getFlatBuffer()[rows[row] * 4]);
+            m[row][1] = _load(&clips[1].getFlatBuffer()[rows[row] * 4]);
+            m[row][2] = _load(&clips[2].getFlatBuffer()[rows[row] * 4]);
+            m[row][3] = _load(&clips[3].getFlatBuffer()[rows[row] * 4]);
+            _transpose(m[row][0], m[row][1], m[row][2], m[row][3]);
+        }
+
+        Lanes nearPlane = _splat(_nearPlane);
+        Lanes half = _splat(0.5f);
+        Lanes width = _splat(static_cast<float>(OCCLUSION_WIDTH));
+        Lanes height = _splat(static_cast<float>(OCCLUSION_HEIGHT));
+        Lanes one = _splat(1.0f);
+        Lanes minX = width;
+        Lanes maxX = _splat(0.0f);
+        Lanes minY = height;
+        Lanes maxY = _splat(0.0f);
+        Lanes nearest = _splat(0.0f);
+        LaneMask crossesNear = _noLanes();
+        for (int corner = 0; corner < 8; corner++) {
+            Lanes clip[3];
+            for (int row = 0; row < 3; row++) {
+                Lanes value = m[row][3];
+                value = (corner & 1) ? _add(value, m[row][0]) : _sub(value, m[row][0]);
+                value = (corner & 2) ? _add(value, m[row][1]) : _sub(value, m[row][1]);
+                value = (corner & 4) ? _add(value, m[row][2]) : _sub(value, m[row][2]);
+                clip[row] = value;
+            }
+            crossesNear = _or(crossesNear, _lessThan(clip[2], nearPlane));
+            Lanes reciprocalW = _div(one, clip[2]);
+            Lanes x = _mul(_add(_mul(_mul(clip[0], reciprocalW), half), half), width);
+            Lanes y = _mul(_add(_mul(_mul(clip[1], reciprocalW), half), half), height);
+            minX = _min(minX, x);
+            maxX = _max(maxX, x);
+            minY = _min(minY, y);
+            maxY = _max(maxY, y);
+            nearest = _max(nearest, reciprocalW);
+        }
+
+        //Boxes reaching past the near plane surround the camera and stay visible
+        visible &= ~_bits(crossesNear);
+        _store(rect[0], minX);
+        _store(rect[1], maxX);
+        _store(rect[2], minY);
+        _store(rect[3], maxY);
+        _store(rect[4], nearest);
+        for (uint32_t box = 0; box < 4; box++) {
+            if ((visible & (1u << box)) && _rectOccluded(rect[0][box], rect[1][box], rect[2][box], rect[3][box], rect[4][box])) {
+                visibleMasks[i / 32] &= ~(1u << ((i + box) % 32));
+            }
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        uint32_t bit = 1u << (i % 32);
+        if ((visibleMasks[i / 32] & bit) && isOccluded(transforms[i])) {
+            visibleMasks[i / 32] &= ~bit;
+        }
+    }
+}
+
+bool OcclusionBuffer::hasOccluders() const {
+    return _hasOccluders;
+}
+
+const float* OcclusionBuffer::getDepth() const {
+    return _depth.data();
+}
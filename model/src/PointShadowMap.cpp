@@ -1,34 +1,142 @@
 #include "PointShadowMap.h"
+#include "ViewManager.h"
+#include "HashCombine.h"
+#include <cmath>
+#include <cassert>
 
-PointShadowMap::PointShadowMap(GLuint width, GLuint height) :
-    CubeMapRenderer(width, height, true),
+PointShadowMap::PointShadowMap(GLuint maxResolution) :
+    CubeMapRenderer(POINT_SHADOW_MIN_RESOLUTION, POINT_SHADOW_MIN_RESOLUTION, true),
     _pointShadowShader("pointShadowShader"),
-    _pointAnimatedShadowShader("pointAnimatedShadowShader") {
+    _pointAnimatedShadowShader("pointAnimatedShadowShader"),
+    _maxResolution(maxResolution),
+    _cachedLight(nullptr) {
 
+    invalidateCache();
 }
 
 PointShadowMap::~PointShadowMap() {
 
 }
 
+void PointShadowMap::invalidateCache() {
+    for (int face = 0; face < 6; face++) {
+        _faceValid[face] = false;
+        _faceSignatures[face] = 0;
+    }
+}
+
+GLuint PointShadowMap::_selectResolution(Light* light, ViewManager* viewManager) {
+
+    //Distance from the camera to the light in view space
+    Vector4 viewPosition = viewManager->getView() * light->getPosition();
+    float* position = viewPosition.getFlatBuffer();
+    float distanceSquared = position[0] * position[0] + position[1] * position[1] + position[2] * position[2];
+    float range = light->getRange();
+
+    //Anything lit can be right in front of the camera so use full detail
+    if (distanceSquared <= range * range) {
+        return _maxResolution;
+    }
+
+    //Pixels across the light's sphere of influence on screen
+    float* projMatrix = viewManager->getProjection().getFlatBuffer();
+    float tangent = range / std::sqrt(distanceSquared - range * range);
+    float coverage = tangent * projMatrix[5] * static_cast<float>(screenPixelHeight);
 
-void PointShadowMap::render(std::vector<Model*> modelList, Light* light) {
+    GLuint current = _cubeTextureMap.getWidth();
+    GLuint resolution = POINT_SHADOW_MIN_RESOLUTION;
+    while (resolution < _maxResolution && static_cast<float>(resolution) < coverage) {
+        resolution *= 2;
+    }
+
+    //Hold the current size near a boundary so the faces are not reallocated every other frame
+    if (resolution < current && coverage > POINT_SHADOW_SHRINK_MARGIN * static_cast<float>(current / 2)) {
+        return current;
+    }
+    return resolution;
+}
+
+void PointShadowMap::render(std::vector<Model*>& modelList, Light* light, ViewManager* viewManager) {
 
     //Does this light support cube map depth rendering
     if (light->getType() == LightType::POINT && light->isShadowCaster()) {
 
+        //There is one cube map and every lighting shader samples it, so it holds the shadows of the
+        //first point light that casts them.  Drawing a second caster would overwrite the first one's
+        //faces every frame
+        assert(_cachedLight == nullptr || light == _cachedLight);
+        if (_cachedLight != nullptr && light != _cachedLight) {
+            return;
+        }
+
+        GLuint resolution = _selectResolution(light, viewManager);
+        if (resolution != _cubeTextureMap.getWidth()) {
+            _cubeTextureMap.resize(resolution, resolution);
+            invalidateCache();
+        }
+
+        Vector4 lightPosition = light->getPosition();
+        Vector4 moved = lightPosition - _cachedLightPosition;
+        if (light != _cachedLight || moved.getx() != 0.0f || moved.gety() != 0.0f || moved.getz() != 0.0f) {
+            invalidateCache();
+            _cachedLight = light;
+            _cachedLightPosition = lightPosition;
+        }
+
         //Prepare cube face transforms
-        preCubeFaceRender(modelList, &light->getLightMVP());
+        MVP lightMVP = light->getLightMVP();
+        buildFaceTransforms(&lightMVP);
 
+        //Cull every model into the faces it touches and hash what each face would draw
+        size_t signatures[6];
+        bool animated[6];
+        for (int face = 0; face < 6; face++) {
+            _faceModels[face].clear();
+            signatures[face] = 0;
+            animated[face] = false;
+        }
         for (Model* model : modelList) {
-            if (model->getClassType() == ModelClass::ModelType) {
-                _pointShadowShader.runShader(model, light, _transforms);
+
+            //Skip models that are outside of every cube face
+            int faceMask = getFaceMask(model);
+            if (faceMask == 0) {
+                continue;
+            }
+
+            size_t modelSignature = model->getTransformSignature();
+            for (int face = 0; face < 6; face++) {
+                if (faceMask & (1 << face)) {
+                    _faceModels[face].push_back(model);
+                    hashCombine(signatures[face], modelSignature);
+                    animated[face] = animated[face] || model->getClassType() == ModelClass::AnimatedModelType;
+                }
             }
-            else if (model->getClassType() == ModelClass::AnimatedModelType) {
-                _pointAnimatedShadowShader.runShader(model, light, _transforms);
+        }
+
+        //Faces whose models did not move keep last frame's depth, animated models pose every frame
+        bool rendered = false;
+        for (int face = 0; face < 6; face++) {
+            if (_faceValid[face] && !animated[face] && signatures[face] == _faceSignatures[face]) {
+                continue;
             }
+
+            bindCubeFace(face);
+            for (Model* model : _faceModels[face]) {
+                if (model->getClassType() == ModelClass::ModelType) {
+                    _pointShadowShader.runShader(model, light, _transforms[face]);
+                }
+                else if (model->getClassType() == ModelClass::AnimatedModelType) {
+                    _pointAnimatedShadowShader.runShader(model, light, _transforms[face]);
+                }
+            }
+            _faceValid[face] = true;
+            _faceSignatures[face] = signatures[face];
+            rendered = true;
         }
+
         //Clean up cube face render contexts
-        postCubeFaceRender();
+        if (rendered) {
+            postCubeFaceRender();
+        }
     }
 }
@@ -115,7 +115,12 @@ static Model* GenerateTerrain()
     // We use this texture for its strides - the actualy texture loaded doesn't matter.
     // ***THIS MUST NOT HAVE AN ALPHA CHANNEL!***.
     // The existance of an alpha channel triggers extra functionality that we do not want.
-    pModel->addTexture("../assets/textures/landscape/Rock_6_d.png", textureStride);
+    pModel->addTerrainTexture("../assets/textures/landscape/Rock_6_d.png",
+                              { "../assets/textures/landscape/dirt.jpg",
+                                "../assets/textures/landscape/grass.jpg",
+                                "../assets/textures/landscape/rocks.jpg",
+                                "../assets/textures/landscape/snow.jpg" },
+                              textureStride);
     return pModel;
 }
 
@@ -160,14 +165,9 @@ static Model* GenerateTrees()
 void GenerateProceduralIsland(std::vector<Model*>& models, ProcState params)
 {
     Model* pTerrain = GenerateTerrain();
+    // The terrain hides most of the island from any camera near the ground.
+    pTerrain->setOccluder(true);
     models.push_back(pTerrain);
     Model* pTrees = GenerateTrees();
     models.push_back(pTrees);
-
-    //Add textures for procedural island
-    TextureBroker* texBroker = TextureBroker::instance();
-    texBroker->addTexture("../assets/textures/landscape/grass.jpg");
-    texBroker->addTexture("../assets/textures/landscape/snow.jpg");
-    texBroker->addTexture("../assets/textures/landscape/dirt.jpg");
-    texBroker->addTexture("../assets/textures/landscape/rocks.jpg");
 }
@@ -0,0 +1,239 @@
+#include "Quaternion.h"
+#include <math.h>
+
+#if defined(MATH_SSE)
+//Sums all four lanes of products and returns it in the low lane
+static inline __m128 _sumXYZW(__m128 products) {
+    __m128 sum = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#endif
+
+//Weighted sum of two quaternions, the core of both blends
+static inline Quaternion _blend(const Quaternion& a, float weightA, const Quaternion& b, float weightB) {
+    Quaternion result;
+#if defined(MATH_SSE)
+    __m128 blend = _mm_add_ps(_mm_mul_ps(_mm_load_ps(a.getFlatBuffer()), _mm_set1_ps(weightA)),
+                              _mm_mul_ps(_mm_load_ps(b.getFlatBuffer()), _mm_set1_ps(weightB)));
+    _mm_store_ps(result.getFlatBuffer(), blend);
+#elif defined(MATH_NEON)
+    float32x4_t blend = vaddq_f32(vmulq_n_f32(vld1q_f32(a.getFlatBuffer()), weightA),
+                                  vmulq_n_f32(vld1q_f32(b.getFlatBuffer()), weightB));
+    vst1q_f32(result.getFlatBuffer(), blend);
+#else
+    const float* quatA = a.getFlatBuffer();
+    const float* quatB = b.getFlatBuffer();
+    float* quat = result.getFlatBuffer();
+    for (int i = 0; i < 4; i++) {
+        quat[i] = quatA[i] * weightA + quatB[i] * weightB;
+    }
+#endif
+    return result;
+}
+
+Quaternion::Quaternion() {
+    _quat[0] = 0.0f;
+    _quat[1] = 0.0f;
+    _quat[2] = 0.0f;
+    _quat[3] = 1.0f;
+}
+
+Quaternion::Quaternion(float x, float y, float z, float w) {
+    _quat[0] = x;
+    _quat[1] = y;
+    _quat[2] = z;
+    _quat[3] = w;
+}
+
+Quaternion::Quaternion(const Quaternion& other) {
+    _quat[0] = other._quat[0];
+    _quat[1] = other._quat[1];
+    _quat[2] = other._quat[2];
+    _quat[3] = other._quat[3];
+}
+
+Quaternion::Quaternion(const Matrix& rotation) {
+
+    const float* m = rotation.getFlatBuffer();
+    float trace = m[0] + m[5] + m[10];
+
+    //Build from the largest of w, x, y and z to keep the square root away from zero
+    if (trace > 0.0f) {
+        float s = sqrtf(trace + 1.0f) * 2.0f;
+        _quat[3] = 0.25f * s;
+        _quat[0] = (m[9] - m[6]) / s;
+        _quat[1] = (m[2] - m[8]) / s;
+        _quat[2] = (m[4] - m[1]) / s;
+    }
+    else if (m[0] > m[5] && m[0] > m[10]) {
+        float s = sqrtf(1.0f + m[0] - m[5] - m[10]) * 2.0f;
+        _quat[3] = (m[9] - m[6]) / s;
+        _quat[0] = 0.25f * s;
+        _quat[1] = (m[1] + m[4]) / s;
+        _quat[2] = (m[2] + m[8]) / s;
+    }
+    else if (m[5] > m[10]) {
+        float s = sqrtf(1.0f + m[5] - m[0] - m[10]) * 2.0f;
+        _quat[3] = (m[2] - m[8]) / s;
+        _quat[0] = (m[1] + m[4]) / s;
+        _quat[1] = 0.25f * s;
+        _quat[2] = (m[6] + m[9]) / s;
+    }
+    else {
+        float s = sqrtf(1.0f + m[10] - m[0] - m[5]) * 2.0f;
+        _quat[3] = (m[4] - m[1]) / s;
+        _quat[0] = (m[2] + m[8]) / s;
+        _quat[1] = (m[6] + m[9]) / s;
+        _quat[2] = 0.25f * s;
+    }
+}
+
+float* Quaternion::getFlatBuffer() {
+    return _quat;
+}
+
+const float* Quaternion::getFlatBuffer() const {
+    return _quat;
+}
+
+float Quaternion::getx() const {
+    return _quat[0];
+}
+
+float Quaternion::gety() const {
+    return _quat[1];
+}
+
+float Quaternion::getz() const {
+    return _quat[2];
+}
+
+float Quaternion::getw() const {
+    return _quat[3];
+}
+
+Quaternion Quaternion::operator * (const Quaternion& other) const {
+    const float* q = other._quat;
+    return Quaternion(_quat[3] * q[0] + _quat[0] * q[3] + _quat[1] * q[2] - _quat[2] * q[1],
+                      _quat[3] * q[1] - _quat[0] * q[2] + _quat[1] * q[3] + _quat[2] * q[0],
+                      _quat[3] * q[2] + _quat[0] * q[1] - _quat[1] * q[0] + _quat[2] * q[3],
+                      _quat[3] * q[3] - _quat[0] * q[0] - _quat[1] * q[1] - _quat[2] * q[2]);
+}
+
+Quaternion Quaternion::operator * (float scale) const {
+    return _blend(*this, scale, *this, 0.0f);
+}
+
+Quaternion Quaternion::operator + (const Quaternion& other) const {
+    return _blend(*this, 1.0f, other, 1.0f);
+}
+
+Quaternion Quaternion::operator - () const {
+    return Quaternion(-_quat[0], -_quat[1], -_quat[2], -_quat[3]);
+}
+
+Quaternion& Quaternion::operator = (const Quaternion& other) {
+    _quat[0] = other._quat[0];
+    _quat[1] = other._quat[1];
+    _quat[2] = other._quat[2];
+    _quat[3] = other._quat[3];
+    return *this;
+}
+
+float Quaternion::dotProduct(const Quaternion& other) const {
+#if defined(MATH_SSE)
+    return _mm_cvtss_f32(_sumXYZW(_mm_mul_ps(_mm_load_ps(_quat), _mm_load_ps(other._quat))));
+#elif defined(MATH_NEON)
+    return vaddvq_f32(vmulq_f32(vld1q_f32(_quat), vld1q_f32(other._quat)));
+#else
+    return _quat[0] * other._quat[0] + _quat[1] * other._quat[1] + _quat[2] * other._quat[2] + _quat[3] * other._quat[3];
+#endif
+}
+
+float Quaternion::getMagnitude() const {
+    return sqrtf(dotProduct(*this));
+}
+
+void Quaternion::normalize() {
+    float magnitude = getMagnitude();
+    if (magnitude == 0.0f) {
+        return;
+    }
+#if defined(MATH_SSE)
+    _mm_store_ps(_quat, _mm_div_ps(_mm_load_ps(_quat), _mm_set1_ps(magnitude)));
+#elif defined(MATH_NEON)
+    vst1q_f32(_quat, vdivq_f32(vld1q_f32(_quat), vdupq_n_f32(magnitude)));
+#else
+    _quat[0] /= magnitude;
+    _quat[1] /= magnitude;
+    _quat[2] /= magnitude;
+    _quat[3] /= magnitude;
+#endif
+}
+
+Quaternion Quaternion::conjugate() const {
+    return Quaternion(-_quat[0], -_quat[1], -_quat[2], _quat[3]);
+}
+
+Vector4 Quaternion::rotate(const Vector4& vec) const {
+
+    //v + 2w(q x v) + 2q x (q x v) without building the full sandwich product
+    const float* v = vec.getFlatBuffer();
+    float tx = 2.0f * (_quat[1] * v[2] - _quat[2] * v[1]);
+    float ty = 2.0f * (_quat[2] * v[0] - _quat[0] * v[2]);
+    float tz = 2.0f * (_quat[0] * v[1] - _quat[1] * v[0]);
+
+    return Vector4(v[0] + _quat[3] * tx + (_quat[1] * tz - _quat[2] * ty),
+                   v[1] + _quat[3] * ty + (_quat[2] * tx - _quat[0] * tz),
+                   v[2] + _quat[3] * tz + (_quat[0] * ty - _quat[1] * tx),
+                   v[3]);
+}
+
+Matrix Quaternion::toMatrix() const {
+
+    MATH_ALIGN float result[16];
+    float x = _quat[0], y = _quat[1], z = _quat[2], w = _quat[3];
+
+    result[0] = 1.0f - 2.0f * (y * y + z * z), result[1] = 2.0f * (x * y - w * z), result[2] = 2.0f * (x * z + w * y), result[3] = 0.0f;
+    result[4] = 2.0f * (x * y + w * z), result[5] = 1.0f - 2.0f * (x * x + z * z), result[6] = 2.0f * (y * z - w * x), result[7] = 0.0f;
+    result[8] = 2.0f * (x * z - w * y), result[9] = 2.0f * (y * z + w * x), result[10] = 1.0f - 2.0f * (x * x + y * y), result[11] = 0.0f;
+    result[12] = 0.0f, result[13] = 0.0f, result[14] = 0.0f, result[15] = 1.0f;
+
+    return Matrix(result, MatrixType::Orthonormal);
+}
+
+Quaternion Quaternion::fromAxisAngle(Vector4 axis, float degrees) {
+    axis.normalize();
+    float halfTheta = degrees * PI_OVER_180 * 0.5f;
+    float s = sinf(halfTheta);
+    return Quaternion(axis.getx() * s, axis.gety() * s, axis.getz() * s, cosf(halfTheta));
+}
+
+Quaternion Quaternion::nlerp(const Quaternion& a, const Quaternion& b, float t) {
+    //q and -q are the same rotation, flip b so the blend takes the short way around
+    float sign = a.dotProduct(b) < 0.0f ? -1.0f : 1.0f;
+    Quaternion result = _blend(a, 1.0f - t, b, t * sign);
+    result.normalize();
+    return result;
+}
+
+Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float t) {
+
+    float cosTheta = a.dotProduct(b);
+    float sign = 1.0f;
+    if (cosTheta < 0.0f) {
+        cosTheta = -cosTheta;
+        sign = -1.0f;
+    }
+
+    //Nearly parallel rotations make sin(theta) too small to divide by and nlerp is just as accurate
+    if (cosTheta > 0.9995f) {
+        return nlerp(a, b, t);
+    }
+
+    float theta = acosf(cosTheta);
+    float sinTheta = sinf(theta);
+    float weightA = sinf((1.0f - t) * theta) / sinTheta;
+    float weightB = sinf(t * theta) / sinTheta;
+    return _blend(a, weightA, b, weightB * sign);
+}
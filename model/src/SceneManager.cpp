@@ -2,6 +2,7 @@
 #include "MasterClock.h"
 #include "SimpleContextEvents.h"
 #include "ViewManager.h"
+#include "SimpleContext.h"
 #include "Factory.h"
 #include "DeferredRenderer.h"
 #include "ShadowRenderer.h"
@@ -12,6 +13,9 @@
 #include "ProcIsland.h"
 #include "Water.h"
 #include "Font.h"
+#include "UniformBlocks.h"
+#include "LightClusters.h"
+#include "DrawRecorder.h"
 
 #include <Triangle.h>
 #include <chrono>
@@ -23,22 +27,30 @@ uint64_t nowMs();
 // We define this here because this file is basically main.
 volatile bool g_AssertOnBadOpenGlCall = false;
 
-SceneManager::SceneManager(int* argc, char** argv, unsigned int viewportWidth, unsigned int viewportHeight, float nearPlaneDistance, float farPlaneDistance) {
+SceneManager::SceneManager(int* argc, char** argv, unsigned int viewportWidth, unsigned int viewportHeight, float nearPlaneDistance, float farPlaneDistance) :
+    _world(true) {
+    _world.makeCurrent(); //Everything created on this thread from here on belongs to the scene's world
+
     _viewManager = new ViewManager(argc, argv, viewportWidth, viewportHeight);
     glCheck();
 
     Factory::setViewWrapper(_viewManager); //Set the reference to the view model event interface
 
+    _uniformBlocks = new UniformBlocks();
+    _lightClusters = new LightClusters();
+    _drawRecorder = new DrawRecorder();
+    glCheck();
+
     _deferredRenderer = new DeferredRenderer();
     glCheck();
 
     _forwardRenderer = new ForwardRenderer();
     glCheck();
 
-    _shadowRenderer = new ShadowRenderer(8*1024, 8*1024);
+    _shadowRenderer = new ShadowRenderer(2048);
     glCheck();
 
-    _pointShadowMap = new PointShadowMap(2000, 2000);
+    _pointShadowMap = new PointShadowMap(2048);
     glCheck();
 
     _ssaoPass = new SSAO();
@@ -65,8 +77,8 @@ SceneManager::SceneManager(int* argc, char** argv, unsigned int viewportWidth, u
 
     //_modelList.push_back(Factory::make<Model>("landscape/landscape.fbx")); //Add a static model to the scene
 
-    //_physics.addModels(_modelList); //Gives physics a pointer to all models which allows access to underlying geometry
-    //_physics.run(); //Dispatch physics to start kinematics
+    //_world.getPhysics()->addModels(_modelList); //Gives physics a pointer to all models which allows access to underlying geometry
+    //_world.getPhysics()->run(_world.getClock()); //Dispatch physics to start kinematics
 
     //Add a directional light pointing down in the negative y axis
     {
@@ -123,7 +135,10 @@ SceneManager::SceneManager(int* argc, char** argv, unsigned int viewportWidth, u
     pointLightMVP.setModel(Matrix::translation(-100.0f, 25.0f, 0.0f));
     _lightList.push_back(Factory::make<Light>(pointLightMVP, LightType::POINT, Vector4(1.0f, 0.0f, 1.0f, 1.0f)));*/
 
-    MasterClock::instance()->run(); //Scene manager kicks off the clock event manager
+    //Headless benchmarks step the world once per frame instead so every run simulates the same frames
+    if (!SimpleContext::isHeadless()) {
+        _world.run(); //Scene manager kicks off the clock event manager
+    }
 
     _audioManager->StartAll();
 
@@ -149,17 +164,31 @@ SceneManager::~SceneManager() {
     delete _viewManager;
     delete _audioManager;
     delete _forwardRenderer;
+    delete _uniformBlocks;
+    delete _lightClusters;
+    delete _drawRecorder;
 }
 
 void SceneManager::_preDraw() {
     glCheck();
 
-    //send all vbo data to shadow shader pre pass
-    _shadowRenderer->generateShadowBuffer(_modelList, _lightList);
+    if (SimpleContext::isHeadless()) {
+        _world.step(DEFAULT_FRAME_TIME);
+    }
+
+    //Constants shared by every shader this frame are written once before any pass draws
+    static uint64_t startTime = nowMs();
+    _uniformBlocks->updateFrame((nowMs() - startTime) / 1000.0f, static_cast<int>(_viewManager->getViewState()));
+    _uniformBlocks->updateView(_viewManager);
+    _lightClusters->update(_viewManager, _lightList);
+
+    //send all vbo data to shadow shader pre pass, the light constants need the fitted cascades
+    _shadowRenderer->generateShadowBuffer(_modelList, _lightList, _viewManager);
+    _uniformBlocks->updateLights(_viewManager, _lightList, _lightClusters, _shadowRenderer);
 
     //send all vbo data to point light shadow pre pass
     for (Light* light : _lightList) {
-        _pointShadowMap->render(_modelList, light);
+        _pointShadowMap->render(_modelList, light, _viewManager);
     }
 
     //Disable environment mapping onto a texture cube atm
@@ -172,9 +201,36 @@ void SceneManager::_preDraw() {
     _deferredRenderer->bind();
     glCheck();
 }
+void SceneManager::_drawOccluders() {
+
+    OcclusionBuffer* occlusionBuffer = _world.getOcclusionBuffer();
+    occlusionBuffer->clear(_viewManager->getProjection(), _viewManager->getView());
+    Frustum frustum(_viewManager->getProjection() * _viewManager->getView());
+    for (Model* model : _modelList) {
+        if (model->isOccluder() && model->isVisible(frustum)) {
+            RenderBuffers* renderBuffers = model->getRenderBuffers();
+            occlusionBuffer->rasterize(model->getMVP()->getModelMatrix(), *renderBuffers->getVertices(),
+                                       *renderBuffers->getIndices());
+        }
+    }
+}
+
 void SceneManager::_postDraw() {
     glCheck();
 
+    //The occluders are drawn on the cpu first so the recording threads can skip what they hide.
+    //Shadow casters are not culled this way, a caster hidden from the camera still shades what it sees
+    _drawOccluders();
+    const OcclusionBuffer* occlusionBuffer = _world.getOcclusionBuffer();
+
+    //Cull and queue the g buffer draws across the recording threads now that every model has its
+    //view for this frame, then send them from this thread sorted by state and depth
+    _drawRecorder->record(_modelList.size(), [this, occlusionBuffer](size_t index, DrawList* drawList) {
+        _modelList[index]->recordDraws(drawList, occlusionBuffer);
+    });
+    _drawRecorder->gather(_world.getDrawList());
+    _world.getDrawList()->submit();
+
     //Render the water around the island
     _water->render();
 
@@ -194,7 +250,8 @@ void SceneManager::_postDraw() {
     if (_viewManager->getViewState() == ViewManager::ViewState::DEFERRED_LIGHTING) {
 
         //Draw transparent objects onto of the deferred renderer
-        _forwardRenderer->forwardLighting(_modelList, _viewManager, _shadowRenderer, _lightList, _pointShadowMap);
+        _forwardRenderer->forwardLighting(_modelList, _viewManager, _shadowRenderer, _lightList, _pointShadowMap,
+                                          occlusionBuffer);
         
         // Lights - including the fire point lights
         for (auto light : _lightList) {
@@ -1,121 +1,207 @@
 #include "ShadowRenderer.h"
 #include "ViewManager.h"
+#include "HashCombine.h"
+#include <algorithm>
+#include <cmath>
 
-ShadowRenderer::ShadowRenderer(GLuint width, GLuint height) :
+ShadowRenderer::ShadowRenderer(GLuint resolution) :
     _staticShadowShader("staticShadowShader"),
-	_animatedShadowShader("animatedShadowShader"),
-    _staticRendered(false),
-    _staticShadowFBO(width, height),
-    _animatedShadowFBO(width, height),
-    _mapShadowFBO(width, height) {
-
+    _animatedShadowShader("animatedShadowShader"),
+    _cascadeFBO(resolution, resolution, SHADOW_CASCADES),
+    _staticCacheFBO(resolution, resolution, SHADOW_CASCADES),
+    _cachedStaticSignature(0) {
+
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        _cacheValid[cascade] = false;
+        _cascadeRadii[cascade] = 0.0f;
+        _splits[cascade] = 0.0f;
+    }
 }
 
 ShadowRenderer::~ShadowRenderer() {
 
 }
 
-GLuint ShadowRenderer::getStaticDepthTexture() {
-    return _staticShadowFBO.getTextureContext();
+GLuint ShadowRenderer::getCascadeTexture() {
+    return _cascadeFBO.getTextureContext();
 }
 
-GLuint ShadowRenderer::getAnimatedDepthTexture() {
-    return _animatedShadowFBO.getTextureContext();
+Matrix ShadowRenderer::getCascadeMatrix(int cascade) {
+    return _cascadeMVPs[cascade].getProjectionMatrix() * _cascadeMVPs[cascade].getViewMatrix();
 }
 
-GLuint ShadowRenderer::getMapDepthTexture() {
-    return _mapShadowFBO.getTextureContext();
+float ShadowRenderer::getCascadeSplit(int cascade) {
+    return _splits[cascade];
 }
 
-void ShadowRenderer::generateShadowBuffer(std::vector<Model*> modelList, std::vector<Light*>& lights) {
+void ShadowRenderer::invalidateStaticCache() {
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        _cacheValid[cascade] = false;
+    }
+}
 
-    // Specify what to render an start acquiring
-    GLenum buffers[] = { GL_NONE };
-    Light* light = nullptr;
+void ShadowRenderer::_fitCascade(int cascade, float splitNear, float splitFar, ViewManager* viewManager,
+                                 Matrix& lightRotation, float margin, float center[3], float& radius) {
 
-    //Only render static objects once to generate depth texture
-    //if(!_staticRendered){
+    float* projMatrix = viewManager->getProjection().getFlatBuffer();
 
-        //Bind frame buffer
-        glBindFramebuffer(GL_FRAMEBUFFER, _mapShadowFBO.getFrameBufferContext());
+    //Slope of the frustum's corner edges away from the view axis
+    float tanHalfHeight = 1.0f / projMatrix[5];
+    float tanHalfWidth = 1.0f / projMatrix[0];
+    float cornerSlopeSquared = tanHalfHeight * tanHalfHeight + tanHalfWidth * tanHalfWidth;
 
-        //Need to change viewport to the resolution of the shadow texture
-        glViewport(0, 0, _mapShadowFBO.getWidth(), _mapShadowFBO.getHeight());
+    //Smallest sphere around the slice, it only depends on the split distances so it keeps the
+    //same size however the camera turns
+    float centerDepth = std::min(0.5f * (splitNear + splitFar) * (1.0f + cornerSlopeSquared), splitFar);
+    float farCornerDistance = splitFar * std::sqrt(cornerSlopeSquared);
+    radius = std::sqrt((splitFar - centerDepth) * (splitFar - centerDepth) + farCornerDistance * farCornerDistance);
 
-        //Clear depth buffer
-        glClear(GL_DEPTH_BUFFER_BIT);
+    //Round up so float noise between frames never changes the texel size
+    radius = std::ceil(radius * (1.0f + margin) * 16.0f) / 16.0f;
 
-        glDrawBuffers(1, buffers);
+    Vector4 worldCenter = viewManager->getView().inverse() * Vector4(0.0f, 0.0f, -centerDepth, 1.0f);
+    Vector4 lightCenter = lightRotation * worldCenter;
+    float* lightCenterBuffer = lightCenter.getFlatBuffer();
+    center[0] = lightCenterBuffer[0];
+    center[1] = lightCenterBuffer[1];
+    center[2] = lightCenterBuffer[2];
+}
 
-        light = lights[1];
-        for (Model* model : modelList) {
+void ShadowRenderer::_setCascadeMVP(int cascade, Matrix& lightRotation, float center[3], float radius) {
 
-            if (model->getClassType() == ModelClass::ModelType) {
-				_staticShadowShader.runShader(model, light);
-            }
-        }
+    //Move the light volume in whole texels so the same world position always lands on the same texel
+    float texelSize = 2.0f * radius / static_cast<float>(_cascadeFBO.getWidth());
+    float snappedX = std::floor(center[0] / texelSize) * texelSize;
+    float snappedY = std::floor(center[1] / texelSize) * texelSize;
 
-        //remove framebuffer context
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        _staticRendered = true;
+    _cascadeCenters[cascade][0] = center[0];
+    _cascadeCenters[cascade][1] = center[1];
+    _cascadeCenters[cascade][2] = center[2];
+    _cascadeRadii[cascade] = radius;
 
-    //}
+    //The light looks down its negative z axis so casters between the sun and the slice have larger z
+    _cascadeMVPs[cascade].setView(Matrix::translation(-snappedX, -snappedY, -center[2]) * lightRotation);
+    _cascadeMVPs[cascade].setProjection(Matrix::cameraOrtho(2.0f * radius, 2.0f * radius,
+                                                            -(radius + SHADOW_CASTER_DEPTH), radius));
+}
+
+void ShadowRenderer::_bindLayer(DepthArrayFrameBuffer& frameBuffer, int layer, bool clear) {
+
+    // Specify what to render an start acquiring
+    GLenum buffers[] = { GL_NONE };
 
     //Bind frame buffer
-    glBindFramebuffer(GL_FRAMEBUFFER, _staticShadowFBO.getFrameBufferContext());
+    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer.getFrameBufferContext(layer));
 
     //Need to change viewport to the resolution of the shadow texture
-    glViewport(0, 0, _staticShadowFBO.getWidth(), _staticShadowFBO.getHeight());
+    glViewport(0, 0, frameBuffer.getWidth(), frameBuffer.getHeight());
 
     //Clear depth buffer
-    glClear(GL_DEPTH_BUFFER_BIT);
+    if (clear) {
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
 
     glDrawBuffers(1, buffers);
+}
+
+void ShadowRenderer::_renderModels(std::vector<Model*>& modelList, ModelClass modelClass, MVP& cascadeMVP) {
 
-    light = lights[0];
+    Frustum frustum(cascadeMVP.getProjectionMatrix() * cascadeMVP.getViewMatrix());
     for (Model* model : modelList) {
 
-        if (model->getClassType() == ModelClass::ModelType) {
-            _staticShadowShader.runShader(model, light);
+        if (model->getClassType() == modelClass && model->isVisible(frustum)) {
+            if (modelClass == ModelClass::AnimatedModelType) {
+                _animatedShadowShader.runShader(model, cascadeMVP);
+            }
+            else {
+                _staticShadowShader.runShader(model, cascadeMVP);
+            }
         }
     }
+}
 
-    //remove framebuffer context
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+void ShadowRenderer::generateShadowBuffer(std::vector<Model*> modelList, std::vector<Light*>& lights, ViewManager* viewManager) {
 
-    //REMOVE BLIT CAUSE ITS SLOW!!!
-    ////Bind frame buffer
-    //glBindFramebuffer(GL_FRAMEBUFFER, _animatedShadowFBO.getFrameBufferContext());
+    //Only the sun's rotation is used, each cascade supplies its own position
+    Matrix lightRotation = lights[0]->getLightMVP().getViewMatrix();
+    float* rotation = lightRotation.getFlatBuffer();
+    rotation[3] = 0.0f;
+    rotation[7] = 0.0f;
+    rotation[11] = 0.0f;
+    lightRotation = Matrix(rotation, MatrixType::Orthonormal);
+    Vector4 lightDirection(rotation[2], rotation[6], rotation[10], 0.0f);
 
-    ////Clear depth buffer
-    //glClear(GL_DEPTH_BUFFER_BIT);
+    //Any change to the sun or the static models invalidates every cached cascade.  Static models
+    //still move through kinematics so their transforms are part of the hash
+    size_t staticSignature = 0;
+    for (Model* model : modelList) {
+        if (model->getClassType() == ModelClass::ModelType) {
+            hashCombine(staticSignature, model->getTransformSignature());
+        }
+    }
+    if (staticSignature != _cachedStaticSignature ||
+        lightDirection.dotProduct(_cachedLightDirection) < SHADOW_CACHE_ANGLE) {
+        invalidateStaticCache();
+        _cachedStaticSignature = staticSignature;
+        _cachedLightDirection = lightDirection;
+    }
 
-    ////Blit static depth info into animation depth render pass
-    //glBindFramebuffer(GL_READ_FRAMEBUFFER, _staticShadowFBO.getFrameBufferContext());
-    //glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _animatedShadowFBO.getFrameBufferContext());
+    //Practical split scheme, a blend of logarithmic and uniform splits
+    float* projMatrix = viewManager->getProjection().getFlatBuffer();
+    float nearPlane = (2.0f*projMatrix[11]) / (2.0f*projMatrix[10] - 2.0f);
+    float shadowFar = std::min(((projMatrix[10] - 1.0f)*nearPlane) / (projMatrix[10] + 1.0f), SHADOW_DISTANCE);
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        float fraction = static_cast<float>(cascade + 1) / static_cast<float>(SHADOW_CASCADES);
+        float logSplit = nearPlane * std::pow(shadowFar / nearPlane, fraction);
+        float uniformSplit = nearPlane + (shadowFar - nearPlane) * fraction;
+        _splits[cascade] = SHADOW_SPLIT_LAMBDA * logSplit + (1.0f - SHADOW_SPLIT_LAMBDA) * uniformSplit;
+    }
 
-    //glBlitFramebuffer(0, 0, _staticShadowFBO.getWidth(), _staticShadowFBO.getHeight(),
-    //                  0, 0, _animatedShadowFBO.getWidth(), _animatedShadowFBO.getHeight(),
-    //                  GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
 
-    //glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-    //glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        float splitNear = cascade == 0 ? nearPlane : _splits[cascade - 1];
+        float center[3];
+        float radius = 0.0f;
 
-    //Bind frame buffer
-    glBindFramebuffer(GL_FRAMEBUFFER, _animatedShadowFBO.getFrameBufferContext());
+        if (cascade == 0) {
+            //The nearest cascade holds the most detail and changes every frame so it is always redrawn
+            _fitCascade(cascade, splitNear, _splits[cascade], viewManager, lightRotation, 0.0f, center, radius);
+            _setCascadeMVP(cascade, lightRotation, center, radius);
 
-    //Need to change viewport to the resolution of the shadow texture
-    glViewport(0, 0, _animatedShadowFBO.getWidth(), _animatedShadowFBO.getHeight());
+            _bindLayer(_cascadeFBO, cascade, true);
+            _renderModels(modelList, ModelClass::ModelType, _cascadeMVPs[cascade]);
+            _renderModels(modelList, ModelClass::AnimatedModelType, _cascadeMVPs[cascade]);
+            continue;
+        }
 
-    // Specify what to render an start acquiring
-    glDrawBuffers(1, buffers);
+        //The cache is still usable while the current slice's sphere fits inside the enlarged one it was drawn with
+        _fitCascade(cascade, splitNear, _splits[cascade], viewManager, lightRotation, 0.0f, center, radius);
+        if (_cacheValid[cascade]) {
+            float dx = center[0] - _cascadeCenters[cascade][0];
+            float dy = center[1] - _cascadeCenters[cascade][1];
+            float dz = center[2] - _cascadeCenters[cascade][2];
+            float limit = _cascadeRadii[cascade] - radius;
+            if (std::sqrt(dx * dx + dy * dy) > limit || std::fabs(dz) > limit) {
+                _cacheValid[cascade] = false;
+            }
+        }
 
-    light = lights[0];
-    for (Model* model : modelList) {
+        if (!_cacheValid[cascade]) {
+            _fitCascade(cascade, splitNear, _splits[cascade], viewManager, lightRotation, SHADOW_CACHE_MARGIN, center, radius);
+            _setCascadeMVP(cascade, lightRotation, center, radius);
 
-        if (model->getClassType() == ModelClass::AnimatedModelType) {
-			_animatedShadowShader.runShader(model, light);
+            _bindLayer(_staticCacheFBO, cascade, true);
+            _renderModels(modelList, ModelClass::ModelType, _cascadeMVPs[cascade]);
+            _cacheValid[cascade] = true;
         }
+
+        //Start from the cached static depth and draw only the models that move
+        glCopyImageSubData(_staticCacheFBO.getTextureContext(), GL_TEXTURE_2D_ARRAY, 0, 0, 0, cascade,
+                           _cascadeFBO.getTextureContext(), GL_TEXTURE_2D_ARRAY, 0, 0, 0, cascade,
+                           _cascadeFBO.getWidth(), _cascadeFBO.getHeight(), 1);
+
+        _bindLayer(_cascadeFBO, cascade, false);
+        _renderModels(modelList, ModelClass::AnimatedModelType, _cascadeMVPs[cascade]);
     }
 
     //remove framebuffer context
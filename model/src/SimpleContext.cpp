@@ -1,11 +1,16 @@
 #include "SimpleContext.h"
 #include "ViewManagerEvents.h"
 #include "MasterClock.h"
+#include "NullGL.h"
+#include "GLStateCache.h"
+#include <cstring>
+#include <cstdlib>
 
 int         SimpleContext::_renderNow = 0;
 std::mutex  SimpleContext::_renderLock;
 GLFWwindow* SimpleContext::_window;
 bool        SimpleContext::_quit = false;
+int         SimpleContext::_headlessFrames = 0;
 
 std::priority_queue<TimeEvent> SimpleContext::_timeEvents; // Events that trigger at a specific time
 
@@ -22,48 +27,68 @@ SimpleContext::SimpleContext(int* argc, char** argv, unsigned int viewportWidth,
     GetCurrentDirectory(sizeof(workingDir), workingDir);
     std::cout << "Working directory: " << workingDir << std::endl;
 
-    //Initialize glfw for window creation
-    glfwInit();
-
-    //Make opengl core profile 4.3
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_MAXIMIZED, true);
-
-    glfwSetErrorCallback([](int code, const char* pMsg) {
-        char buffer[1024];
-        snprintf(buffer, sizeof(buffer), "GLFW [0x%Xu] %s\n", code, pMsg);
-        std::cerr << buffer << std::endl;
-    });
-
-    //Create a glfw window for a context
-    _window = glfwCreateWindow(viewportWidth, viewportHeight, "HawaiiRelief", NULL, NULL);
-    if (!_window) {
-        // Window or OpenGL context creation failed
-        // The error callback above will tell us what happened.
-        std::abort();
+    //-headless [frames] draws through the recording backend without a window to benchmark the cpu side
+    for (int i = 1; i < *argc; i++) {
+        if (strcmp(argv[i], "-headless") == 0) {
+            _headlessFrames = (i + 1 < *argc) ? atoi(argv[i + 1]) : 0;
+            if (_headlessFrames <= 0) {
+                _headlessFrames = HEADLESS_DEFAULT_FRAMES;
+            }
+        }
     }
-    glfwMakeContextCurrent(_window); //Make current opengl context current
 
-    //Callbacks
-    glfwSetKeyCallback(_window, &SimpleContext::_keyboardUpdate);
-    glfwSetCursorPosCallback(_window, &SimpleContext::_mouseUpdate);
+    if (_headlessFrames > 0) {
+        NullGL::install();
+    }
+    else {
+        //Initialize glfw for window creation
+        glfwInit();
+
+        //Make opengl core profile 4.3
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_MAXIMIZED, true);
+
+        glfwSetErrorCallback([](int code, const char* pMsg) {
+            char buffer[1024];
+            snprintf(buffer, sizeof(buffer), "GLFW [0x%Xu] %s\n", code, pMsg);
+            std::cerr << buffer << std::endl;
+        });
+
+        //Create a glfw window for a context
+        _window = glfwCreateWindow(viewportWidth, viewportHeight, "HawaiiRelief", NULL, NULL);
+        if (!_window) {
+            // Window or OpenGL context creation failed
+            // The error callback above will tell us what happened.
+            std::abort();
+        }
+        glfwMakeContextCurrent(_window); //Make current opengl context current
+
+        //Callbacks
+        glfwSetKeyCallback(_window, &SimpleContext::_keyboardUpdate);
+        glfwSetCursorPosCallback(_window, &SimpleContext::_mouseUpdate);
 
-    //Sets atleast one extra render buffer for double buffering to prevent screen tearing
-    //glfwSwapInterval(1); //Enables 60 hz vsync
-    glfwSwapInterval(0); //Disables 60 hz vsync
+        //Sets atleast one extra render buffer for double buffering to prevent screen tearing
+        //glfwSwapInterval(1); //Enables 60 hz vsync
+        glfwSwapInterval(0); //Disables 60 hz vsync
 
-    if (gl3wInit()) {
-        std::cout << "failed to initialize OpenGL\n" << std::endl;
+        if (gl3wInit()) {
+            std::cout << "failed to initialize OpenGL\n" << std::endl;
+        }
+        if (!gl3wIsSupported(3, 0)) {
+            std::cout << "OpenGL 3.2 not supported\n" << std::endl;
+        }
+        printf("OpenGL: %s\nGLSL: %s\nVendor: %s\n",
+               glGetString(GL_VERSION),
+               glGetString(GL_SHADING_LANGUAGE_VERSION),
+               glGetString(GL_VENDOR));
     }
-    if (!gl3wIsSupported(3, 0)) {
-        std::cout << "OpenGL 3.2 not supported\n" << std::endl;
+
+    //Sits in front of whichever backend was loaded
+    if (GL_STATE_FILTERING) {
+        GLStateCache::install();
     }
-    printf("OpenGL: %s\nGLSL: %s\nVendor: %s\n",
-           glGetString(GL_VERSION),
-           glGetString(GL_SHADING_LANGUAGE_VERSION),
-           glGetString(GL_VENDOR));
 
     //PER SAMPLE PROCESSING DEFAULTS
     glClearDepth(1.0);
@@ -72,7 +97,9 @@ SimpleContext::SimpleContext(int* argc, char** argv, unsigned int viewportWidth,
     glClearColor(0.0, 0.0, 0.0, 0.0);
 
     //Disable mouse cursor view
-    glfwSetInputMode(_window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+    if (_window != nullptr) {
+        glfwSetInputMode(_window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+    }
 
     MasterClock* masterClock = MasterClock::instance();
     masterClock->setFrameRate(60); //Establishes the frame rate of the draw context
@@ -90,7 +117,16 @@ SimpleContext::SimpleContext(int* argc, char** argv, unsigned int viewportWidth,
 }
 
 void SimpleContext::run() {
-    _drawUpdate();
+    if (_headlessFrames > 0) {
+        _drawHeadless();
+    }
+    else {
+        _drawUpdate();
+    }
+}
+
+bool SimpleContext::isHeadless() {
+    return _headlessFrames > 0;
 }
 
 void SimpleContext::subscribeToKeyboard(std::function<void(int, int, int)> func) { //Use this call to connect functions to key updates
@@ -153,6 +189,25 @@ void SimpleContext::_drawUpdate() {
     }
 }
 
+//Fixed number of frames through the recording backend, the first ones fill caches so they are not measured
+void SimpleContext::_drawHeadless() {
+    for (int frame = 0; frame < HEADLESS_WARMUP_FRAMES + _headlessFrames; frame++) {
+        if (frame == HEADLESS_WARMUP_FRAMES) {
+            NullGL::resetTotals();
+            GLStateCache::resetFilteredCalls();
+        }
+        NullGL::beginFrame();
+        SimpleContextEvents::updateDraw(nullptr);
+        NullGL::endFrame();
+    }
+    NullGL::printReport();
+    if (GL_STATE_FILTERING) {
+        std::cout << "GLStateCache: " << GLStateCache::getFilteredCalls() / _headlessFrames
+                  << " redundant state changes dropped per frame" << std::endl;
+    }
+    _quit = true;
+}
+
 //All mouse input will be notified here
 void SimpleContext::_mouseUpdate(GLFWwindow* window, double x, double y) {
 
@@ -57,9 +57,12 @@ void SimpleContextEvents::updateDraw(GLFWwindow* _window) {
     //Call scene manager to go any global operations after drawing
     _postDrawCallback();
 
-    glfwSwapBuffers(_window); // Double buffering
+    //Headless benchmark frames have no window to present to
+    if (_window != nullptr) {
+        glfwSwapBuffers(_window); // Double buffering
 
-    glfwPollEvents(); //Poll for events
+        glfwPollEvents(); //Poll for events
+    }
 }
 
 
@@ -0,0 +1,47 @@
+#include "SnormNormal.h"
+#include <math.h>
+
+//Largest magnitude a 10 bit signed normalized component can hold
+static const float SNORM_10_SCALE = 511.0f;
+
+static inline uint32_t _packComponent(float value) {
+    value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+    int32_t component = static_cast<int32_t>(lroundf(value * SNORM_10_SCALE));
+    return static_cast<uint32_t>(component) & 0x3FF;
+}
+
+static inline float _unpackComponent(uint32_t bits, int shift) {
+    //Move the 10 bits to the top and arithmetic shift back down to sign extend
+    int32_t component = static_cast<int32_t>(bits << (22 - shift)) >> 22;
+    float value = static_cast<float>(component) / SNORM_10_SCALE;
+    return value < -1.0f ? -1.0f : value;
+}
+
+SnormNormal::SnormNormal() :
+    _bits(0) {
+}
+
+SnormNormal::SnormNormal(const Vector4& normal) {
+    const float* vector = normal.getFlatBuffer();
+    _bits = _packComponent(vector[0]) |
+            (_packComponent(vector[1]) << 10) |
+            (_packComponent(vector[2]) << 20);
+}
+
+uint32_t SnormNormal::getBits() const {
+    return _bits;
+}
+
+Vector4 SnormNormal::toVector4() const {
+    return Vector4(_unpackComponent(_bits, 0),
+                   _unpackComponent(_bits, 10),
+                   _unpackComponent(_bits, 20),
+                   0.0f);
+}
+
+void SnormNormal::pack(const std::vector<Vector4>& in, std::vector<SnormNormal>& out) {
+    out.resize(in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        out[i] = SnormNormal(in[i]);
+    }
+}
@@ -0,0 +1,180 @@
+#include "StreamBuffer.h"
+#include <cstring>
+
+StreamBuffer::StreamBuffer(GLenum target, size_t regionSize) :
+    _target(target),
+    _bufferContext(0),
+    _regionSize(regionSize),
+    _region(0),
+    _offset(0),
+    _persistent(supportsPersistentMapping()),
+    _persistentData(nullptr),
+    _mapped(false) {
+
+    for (int i = 0; i < STREAM_BUFFER_REGIONS; i++) {
+        _fences[i] = nullptr;
+    }
+    _create();
+}
+
+StreamBuffer::~StreamBuffer() {
+    _destroy();
+}
+
+bool StreamBuffer::supportsPersistentMapping() {
+
+    static int supported = -1;
+    if (supported == -1) {
+        supported = 0;
+
+        //Mesa drivers are faster with orphaning so they stay on the fallback path
+        std::string version(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+        if (version.find("Mesa") == std::string::npos) {
+            if (gl3wIsSupported(4, 4)) {
+                supported = 1;
+            }
+            else {
+                GLint extensionCount = 0;
+                glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+                for (GLint i = 0; i < extensionCount; i++) {
+                    const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+                    if (strcmp(extension, "GL_ARB_buffer_storage") == 0) {
+                        supported = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return supported == 1;
+}
+
+void StreamBuffer::_create() {
+
+    glGenBuffers(1, &_bufferContext);
+    glBindBuffer(_target, _bufferContext);
+    if (_persistent) {
+        //Coherent so writes become visible without flushing each range
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(_target, STREAM_BUFFER_REGIONS * _regionSize, nullptr, flags);
+        _persistentData = static_cast<unsigned char*>(
+            glMapBufferRange(_target, 0, STREAM_BUFFER_REGIONS * _regionSize, flags));
+    }
+    else {
+        glBufferData(_target, _regionSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(_target, 0);
+
+    _region = 0;
+    _offset = 0;
+}
+
+void StreamBuffer::_destroy() {
+
+    for (int i = 0; i < STREAM_BUFFER_REGIONS; i++) {
+        if (_fences[i] != nullptr) {
+            glDeleteSync(_fences[i]);
+            _fences[i] = nullptr;
+        }
+    }
+    //Deleting the buffer also unmaps it and gl keeps the storage alive until pending draws finish
+    glDeleteBuffers(1, &_bufferContext);
+    _bufferContext = 0;
+    _persistentData = nullptr;
+    _mapped = false;
+}
+
+void StreamBuffer::_nextRegion() {
+
+    if (_persistent) {
+        _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _region = (_region + 1) % STREAM_BUFFER_REGIONS;
+
+        //Only blocks when the cpu has lapped the gpu by a whole ring
+        if (_fences[_region] != nullptr) {
+            GLenum result = glClientWaitSync(_fences[_region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            while (result == GL_TIMEOUT_EXPIRED) {
+                result = glClientWaitSync(_fences[_region], 0, 1000000);
+            }
+            glDeleteSync(_fences[_region]);
+            _fences[_region] = nullptr;
+        }
+    }
+    else {
+        //Orphan the storage, the driver hands back fresh memory while the gpu finishes with the old
+        glBindBuffer(_target, _bufferContext);
+        glBufferData(_target, _regionSize, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(_target, 0);
+    }
+    _offset = 0;
+}
+
+void StreamBuffer::_grow(size_t size) {
+
+    while (_regionSize < size) {
+        _regionSize *= 2;
+    }
+    _destroy();
+    _create();
+}
+
+void* StreamBuffer::map(size_t size, size_t alignment, size_t& offset) {
+
+    if (size > _regionSize) {
+        _grow(size);
+    }
+
+    //Align the absolute offset so vertex strides that are not a power of two can be drawn from
+    size_t regionStart = _persistent ? _region * _regionSize : 0;
+    size_t aligned = (regionStart + _offset + alignment - 1) / alignment * alignment - regionStart;
+    if (aligned + size > _regionSize) {
+        _nextRegion();
+        regionStart = _persistent ? _region * _regionSize : 0;
+        aligned = (regionStart + alignment - 1) / alignment * alignment - regionStart;
+        if (aligned + size > _regionSize) {
+            _grow(aligned + size);
+            aligned = 0;
+        }
+    }
+    _offset = aligned + size;
+    offset = regionStart + aligned;
+
+    if (_persistent) {
+        return _persistentData + offset;
+    }
+
+    //The range has not been handed to the gpu since the last orphan so no sync is needed
+    glBindBuffer(_target, _bufferContext);
+    void* data = glMapBufferRange(_target, offset, size,
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    glBindBuffer(_target, 0);
+    _mapped = true;
+    return data;
+}
+
+void StreamBuffer::unmap() {
+    if (_mapped) {
+        glBindBuffer(_target, _bufferContext);
+        glUnmapBuffer(_target);
+        glBindBuffer(_target, 0);
+        _mapped = false;
+    }
+}
+
+size_t StreamBuffer::write(const void* data, size_t size, size_t alignment) {
+    size_t offset = 0;
+    void* destination = map(size, alignment, offset);
+    if (destination != nullptr) {
+        memcpy(destination, data, size);
+    }
+    unmap();
+    return offset;
+}
+
+GLuint StreamBuffer::getContext() {
+    return _bufferContext;
+}
+
+bool StreamBuffer::isPersistent() {
+    return _persistent;
+}
@@ -1,47 +1,96 @@
 #include "TextureBroker.h"
-TextureBroker* TextureBroker::_broker = nullptr;
+#include "World.h"
 
-TextureBroker* TextureBroker::instance() { //Only initializes the static pointer once
-    if (_broker == nullptr) {
-        _broker = new TextureBroker();
-    }
-    return _broker;
+TextureBroker* TextureBroker::instance() { //Texture cache of the calling thread's current world
+    return World::current()->getTextureBroker();
 }
 TextureBroker::TextureBroker() {
 
 }
 TextureBroker::~TextureBroker() {
 
-}
-
-void TextureBroker::addTexture(std::string textureName) {
-
-    if(_textures.find(textureName) == _textures.end()){
-        _textures[textureName] = new Texture(textureName);
+    //Every texture was added under a name, the pools hand each one back to be freed
+    for (auto& texture : _textureNames) {
+        delete _textures.remove(texture.second);
+    }
+    for (auto& layeredTexture : _layeredTextureNames) {
+        delete _layeredTextures.remove(layeredTexture.second);
     }
 }
 
-void TextureBroker::addLayeredTexture(std::vector<std::string> textureNames) {
+std::string TextureBroker::getLayeredName(const std::vector<std::string>& textureNames) {
 
     std::string sumString = "Layered";
     for (auto& str : textureNames) {
         sumString += str;
     }
-    if (_layeredTextures.find(sumString) == _layeredTextures.end()) {
-        _layeredTextures[sumString] = new LayeredTexture(textureNames);
+    return sumString;
+}
+
+TextureHandle TextureBroker::addTexture(std::string textureName) {
+
+    auto texture = _textureNames.find(textureName);
+    if (texture != _textureNames.end()) {
+        return texture->second;
+    }
+    TextureHandle handle = _textures.add(new Texture(textureName));
+    _textureNames[textureName] = handle;
+    return handle;
+}
+
+LayeredTextureHandle TextureBroker::addLayeredTexture(std::vector<std::string> textureNames) {
+
+    std::string sumString = getLayeredName(textureNames);
+    auto layeredTexture = _layeredTextureNames.find(sumString);
+    if (layeredTexture != _layeredTextureNames.end()) {
+        return layeredTexture->second;
     }
+    LayeredTextureHandle handle = _layeredTextures.add(new LayeredTexture(textureNames));
+    _layeredTextureNames[sumString] = handle;
+    return handle;
 }
 
-void TextureBroker::addCubeTexture(std::string textureName) {
-    if (_textures.find(textureName) == _textures.end()) {
-        _textures[textureName] = new Texture(textureName, true);
+TextureHandle TextureBroker::addCubeTexture(std::string textureName) {
+
+    auto texture = _textureNames.find(textureName);
+    if (texture != _textureNames.end()) {
+        return texture->second;
     }
+    TextureHandle handle = _textures.add(new Texture(textureName, true));
+    _textureNames[textureName] = handle;
+    return handle;
+}
+
+TextureHandle TextureBroker::findTexture(const std::string& textureName) {
+
+    auto texture = _textureNames.find(textureName);
+    if (texture == _textureNames.end()) {
+        return TextureHandle();
+    }
+    return texture->second;
+}
+
+LayeredTextureHandle TextureBroker::findLayeredTexture(const std::string& textureName) {
+
+    auto layeredTexture = _layeredTextureNames.find(textureName);
+    if (layeredTexture == _layeredTextureNames.end()) {
+        return LayeredTextureHandle();
+    }
+    return layeredTexture->second;
+}
+
+Texture* TextureBroker::getTexture(TextureHandle handle) {
+    return _textures.get(handle);
+}
+
+LayeredTexture* TextureBroker::getLayeredTexture(LayeredTextureHandle handle) {
+    return _layeredTextures.get(handle);
 }
 
-Texture* TextureBroker::getTexture(std::string textureName) {
-    return _textures[textureName];
+Texture* TextureBroker::getTexture(const std::string& textureName) {
+    return _textures.get(findTexture(textureName));
 }
 
-LayeredTexture* TextureBroker::getLayeredTexture(std::string textureName) {
-    return _layeredTextures[textureName];
+size_t TextureBroker::getTextureCount() {
+    return _textures.size();
 }
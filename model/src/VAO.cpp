@@ -1,11 +1,31 @@
 #include "VAO.h"
 #include "Model.h"
-
-VAO::VAO(){
-
+#include "Vector3.h"
+#include "SnormNormal.h"
+#include "World.h"
+
+VAO::VAO() :
+    _vaoContext(0),
+    _vaoShadowContext(0),
+    _debugNormalBufferContext(0),
+    _arena(nullptr),
+    _privateVAO(false) {
+
+    _allocation.block = -1;
+    _allocation.baseVertex = 0;
+    _allocation.firstIndex = 0;
+    _allocation.vertexCount = 0;
+    _allocation.indexCount = 0;
 }
 VAO::~VAO(){
 
+    if (_arena != nullptr) {
+        if (_privateVAO) {
+            _arena->destroyPrivateVAO(_vaoContext);
+        }
+        _arena->free(_allocation);
+        glDeleteBuffers(1, &_debugNormalBufferContext);
+    }
 }
 
 void VAO::setVertexContext(GLuint context){
@@ -52,7 +72,7 @@ void VAO::createVAO(RenderBuffers* renderBuffers, ModelClass classId, Animation*
     std::vector<int>&     indices      = *renderBuffers->getIndices();
     std::vector<Vector4>& debugNormals = *renderBuffers->getDebugNormals();
 
-    const size_t vertexCount = indices.size();
+    const size_t vertexCount = vertices.size();
     if (vertexCount == 0) {
         printf("Creating a model with no vertices!");
     }
@@ -65,102 +85,52 @@ void VAO::createVAO(RenderBuffers* renderBuffers, ModelClass classId, Animation*
         }
     }
 
-    // Generate buffers
-    {
-        // Indices
-        glGenBuffers(1, &_indexBufferContext);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBufferContext);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                     indices.size() * sizeof(float),
-                     indices.data(),
-                     GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-        // Positions
-        glGenBuffers(1, &_vertexBufferContext);
-        glBindBuffer(GL_ARRAY_BUFFER, _vertexBufferContext);
-        glBufferData(GL_ARRAY_BUFFER,
-                     vertexCount * sizeof(float),
-                     vertices.data(),
-                     GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // Normals
-        glGenBuffers(1, &_normalBufferContext);
-        glBindBuffer(GL_ARRAY_BUFFER, _normalBufferContext);
-        glBufferData(GL_ARRAY_BUFFER,
-                     vertexCount * sizeof(float),
-                     normals.data(),
-                     GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // Texture Coords
-        glGenBuffers(1, &_textureBufferContext); // Do not need to double buffer
-        glBindBuffer(GL_ARRAY_BUFFER, _textureBufferContext);
-        glBufferData(GL_ARRAY_BUFFER,
-                     vertexCount * sizeof(float),
-                     textures.data(),
-                     GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // Debug Normals (unused?)
-        glGenBuffers(1, &_debugNormalBufferContext);
-        glBindBuffer(GL_ARRAY_BUFFER, _debugNormalBufferContext);
-        glBufferData(GL_ARRAY_BUFFER,
-                     vertexCount * sizeof(float),
-                     debugNormals.data(),
-                     GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    }
-
-    // Setup VAOs for the Deferred Pass
-    {
-        // Bind regular vertex, normal and texture coordinate vao
-        glGenVertexArrays(1, &_vaoContext);
-        glBindVertexArray(_vaoContext);
-
-        // Indices
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBufferContext);
-
-        // Bind vertex buff context to current buffer
-        glBindBuffer(GL_ARRAY_BUFFER, _vertexBufferContext);
-        // Note: Stride here is important - Vector4 has extra data that we don't pass to OpenGL, so we
-        //       need to specifiy the actual size of our 4D vectors.
-        //       (We ignore the w component.)
-        //       This happens on all of these, but I'll only write it out on this one. ;)
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector4), 0);
-        glEnableVertexAttribArray(0);
-
-        // Bind normal buff context to current buffer
-        glBindBuffer(GL_ARRAY_BUFFER, _normalBufferContext);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vector4), 0);
-        glEnableVertexAttribArray(1);
-
-        // Bind texture coordinate buff context to current buffer
-        glBindBuffer(GL_ARRAY_BUFFER, _textureBufferContext);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vector4), 0);
-        glEnableVertexAttribArray(2);
-
-        // Close vao
-        glBindVertexArray(0);
-    }
+    // The GPU never reads w so vertex data is packed before upload:
+    // positions as 3 floats, normals as 10:10:10:2 snorm and debug normals as 3 floats.
+    // Debug normal lines end at world space points so halfs would lose precision on the island
+    std::vector<Vector3>     packedVertices;
+    std::vector<SnormNormal> packedNormals;
+    std::vector<Vector3>     packedDebugNormals;
+    Vector3::pack(vertices, packedVertices);
+    SnormNormal::pack(normals, packedNormals);
+    Vector3::pack(debugNormals, packedDebugNormals);
+
+    // Positions, normals, texture coordinates and indices are suballocated from the world's
+    // shared buffers so every model in a block draws from the same vaos
+    _arena = World::current()->getGeometryArena();
+    _allocation = _arena->allocate(packedVertices, packedNormals, textures, indices);
+    _vertexBufferContext = _arena->getPositionContext(_allocation.block);
+    _normalBufferContext = _arena->getNormalContext(_allocation.block);
+    _textureBufferContext = _arena->getTextureContext(_allocation.block);
+    _vaoContext = _arena->getVAOContext(_allocation.block);
+    _vaoShadowContext = _arena->getShadowVAOContext(_allocation.block);
+
+    // Debug Normals (unused?)
+    glGenBuffers(1, &_debugNormalBufferContext);
+    glBindBuffer(GL_ARRAY_BUFFER, _debugNormalBufferContext);
+    glBufferData(GL_ARRAY_BUFFER,
+                 packedDebugNormals.size() * sizeof(Vector3),
+                 packedDebugNormals.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-    // Setup VAOs for Shadow Passes
-    {
-        glGenVertexArrays(1, &_vaoShadowContext);
-        glBindVertexArray(_vaoShadowContext);
+GLuint VAO::detachVAOContext() {
 
-        // Indices
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBufferContext);
+    //Attributes added to the shared vao would show up in every other model of the block
+    if (_arena != nullptr && !_privateVAO) {
+        _vaoContext = _arena->createPrivateVAO(_allocation.block);
+        _privateVAO = true;
+    }
+    return _vaoContext;
+}
 
-        // Shadows only need position data.
-        glBindBuffer(GL_ARRAY_BUFFER, _vertexBufferContext);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector4), 0);
-        glEnableVertexAttribArray(0);
+GLint VAO::getBaseVertex() {
+    return _allocation.baseVertex;
+}
 
-        // Close vao
-        glBindVertexArray(0);
-    }
+GLuint VAO::getFirstIndex() {
+    return _allocation.firstIndex;
 }
 
 GLuint VAO::getVAOContext() {
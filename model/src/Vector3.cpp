@@ -0,0 +1,51 @@
+#include "Vector3.h"
+
+Vector3::Vector3() {
+    _vec[0] = 0.0f;
+    _vec[1] = 0.0f;
+    _vec[2] = 0.0f;
+}
+
+Vector3::Vector3(float x, float y, float z) {
+    _vec[0] = x;
+    _vec[1] = y;
+    _vec[2] = z;
+}
+
+Vector3::Vector3(const Vector4& vec) {
+    const float* vector = vec.getFlatBuffer();
+    _vec[0] = vector[0];
+    _vec[1] = vector[1];
+    _vec[2] = vector[2];
+}
+
+float* Vector3::getFlatBuffer() {
+    return _vec;
+}
+
+const float* Vector3::getFlatBuffer() const {
+    return _vec;
+}
+
+float Vector3::getx() const {
+    return _vec[0];
+}
+
+float Vector3::gety() const {
+    return _vec[1];
+}
+
+float Vector3::getz() const {
+    return _vec[2];
+}
+
+Vector4 Vector3::toVector4(float w) const {
+    return Vector4(_vec[0], _vec[1], _vec[2], w);
+}
+
+void Vector3::pack(const std::vector<Vector4>& in, std::vector<Vector3>& out) {
+    out.resize(in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        out[i] = Vector3(in[i]);
+    }
+}
@@ -1,6 +1,7 @@
 #include "Vector4.h"
 #include <iostream>
 #include <iomanip>
+#include <math.h>
 using namespace std;
 
 Vector4::Vector4() {
@@ -28,8 +29,33 @@ float* Vector4::getFlatBuffer() {
     return _vec;
 }
 
+const float* Vector4::getFlatBuffer() const {
+    return _vec;
+}
+
+#if defined(MATH_SSE)
+//Sums the x, y and z lanes of products in the scalar add order and returns it in the low lane
+static inline __m128 _sumXYZ(__m128 products) {
+    __m128 sum = _mm_add_ss(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_add_ss(sum, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 2, 2, 2)));
+}
+#elif defined(MATH_NEON)
+//Rotates x, y and z lanes into y, z and x, the w lane holds x and is thrown away
+static inline float32x4_t _yzx(float32x4_t vec) {
+    return vsetq_lane_f32(vgetq_lane_f32(vec, 0), vextq_f32(vec, vec, 1), 2);
+}
+#endif
+
 float Vector4::getMagnitude() {
+#if defined(MATH_SSE)
+    __m128 vec = _mm_load_ps(_vec);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_sumXYZ(_mm_mul_ps(vec, vec))));
+#elif defined(MATH_NEON)
+    float32x4_t products = vmulq_f32(vld1q_f32(_vec), vld1q_f32(_vec));
+    return sqrtf(vgetq_lane_f32(products, 0) + vgetq_lane_f32(products, 1) + vgetq_lane_f32(products, 2));
+#else
     return sqrtf((_vec[0] * _vec[0]) + (_vec[1] * _vec[1]) + (_vec[2] * _vec[2]));
+#endif
 }
 
 Vector4 Vector4::operator / (float scale) {
@@ -89,37 +115,75 @@ Vector4 Vector4::operator - () {
 }
 
 
-Vector4 Vector4::crossProduct(Vector4 other) {
+Vector4 Vector4::crossProduct(const Vector4& other) {
     Vector4 result;
     float* vector = result.getFlatBuffer();
-    float* vector2 = other.getFlatBuffer();
+    const float* vector2 = other.getFlatBuffer();
     //x1 y1 z1
     //x2 y2 z2
     //x = y1*z2 - z1*y2
     //y = x1*z2 - z1*x2
     //z = x1*y2 - y1*x2
     //result = x - y + z
+#if defined(MATH_SSE)
+    __m128 a = _mm_load_ps(_vec);
+    __m128 b = _mm_load_ps(vector2);
+    __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 cross = _mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX));
+    //Clear w to 0 like the scalar code
+    cross = _mm_and_ps(cross, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+    _mm_store_ps(vector, cross);
+#elif defined(MATH_NEON)
+    float32x4_t a = vld1q_f32(_vec);
+    float32x4_t b = vld1q_f32(vector2);
+    float32x4_t aYZX = _yzx(a);
+    float32x4_t bYZX = _yzx(b);
+    float32x4_t cross = vsubq_f32(vmulq_f32(aYZX, _yzx(bYZX)), vmulq_f32(_yzx(aYZX), bYZX));
+    vst1q_f32(vector, vsetq_lane_f32(0.f, cross, 3));
+#else
     vector[0] =  (_vec[1] * vector2[2]) - (_vec[2] * vector2[1]);
     vector[1] = -(_vec[0] * vector2[2]) + (_vec[2] * vector2[0]);
     vector[2] =  (_vec[0] * vector2[1]) - (_vec[1] * vector2[0]);
     vector[3] = 0.f;
+#endif
     return result;
 }
 
-float Vector4::dotProduct(Vector4 other) {
+float Vector4::dotProduct(const Vector4& other) {
+    const float* vector2 = other.getFlatBuffer();
+#if defined(MATH_SSE)
+    return _mm_cvtss_f32(_sumXYZ(_mm_mul_ps(_mm_load_ps(_vec), _mm_load_ps(vector2))));
+#elif defined(MATH_NEON)
+    float32x4_t products = vmulq_f32(vld1q_f32(_vec), vld1q_f32(vector2));
+    return vgetq_lane_f32(products, 0) + vgetq_lane_f32(products, 1) + vgetq_lane_f32(products, 2);
+#else
     float result;
-    float* vector2 = other.getFlatBuffer();
     result = (_vec[0] * vector2[0]) + (_vec[1] * vector2[1]) + (_vec[2] * vector2[2]);
     return result;
+#endif
 }
 
 void Vector4::normalize() {
-    Vector4 result;
-    float* vector = result.getFlatBuffer();
+#if defined(MATH_SSE)
+    __m128 vec = _mm_load_ps(_vec);
+    __m128 mag = _mm_sqrt_ss(_sumXYZ(_mm_mul_ps(vec, vec)));
+    __m128 normal = _mm_div_ps(vec, _mm_shuffle_ps(mag, mag, _MM_SHUFFLE(0, 0, 0, 0)));
+    //Only x, y and z are scaled, w is left untouched
+    __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    _mm_store_ps(_vec, _mm_or_ps(_mm_and_ps(xyzMask, normal), _mm_andnot_ps(xyzMask, vec)));
+#elif defined(MATH_NEON)
+    float32x4_t vec = vld1q_f32(_vec);
+    float32x4_t normal = vdivq_f32(vec, vdupq_n_f32(getMagnitude()));
+    vst1q_f32(_vec, vsetq_lane_f32(_vec[3], normal, 3));
+#else
     float mag = getMagnitude();
     _vec[0] /= mag;
     _vec[1] /= mag;
     _vec[2] /= mag;
+#endif
 }
 
 //Prints out the result in row major
@@ -0,0 +1,69 @@
+#include "World.h"
+
+thread_local World* World::_currentWorld = nullptr;
+
+World::World(bool looseDynamic) :
+    _materialBroker(&_textureBroker),
+    _physics(looseDynamic) {
+
+}
+
+World::~World() {
+    stop();
+    if (_currentWorld == this) {
+        _currentWorld = nullptr;
+    }
+}
+
+World* World::current() {
+    if (_currentWorld == nullptr) {
+        //Threads that never picked a world all share one, only initializes the static world once
+        static World defaultWorld;
+        return &defaultWorld;
+    }
+    return _currentWorld;
+}
+
+void World::makeCurrent() {
+    _currentWorld = this;
+}
+
+MasterClock* World::getClock() {
+    return &_clock;
+}
+
+TextureBroker* World::getTextureBroker() {
+    return &_textureBroker;
+}
+
+MaterialBroker* World::getMaterialBroker() {
+    return &_materialBroker;
+}
+
+Physics* World::getPhysics() {
+    return &_physics;
+}
+
+DrawList* World::getDrawList() {
+    return &_drawList;
+}
+
+GeometryArena* World::getGeometryArena() {
+    return &_geometryArena;
+}
+
+OcclusionBuffer* World::getOcclusionBuffer() {
+    return &_occlusionBuffer;
+}
+
+void World::run() {
+    _clock.run(this);
+}
+
+void World::step(int milliSeconds) {
+    _clock.step(milliSeconds);
+}
+
+void World::stop() {
+    _clock.stop();
+}
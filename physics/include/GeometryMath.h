@@ -20,8 +20,12 @@
 */
 
 #pragma once
-#include "Model.h"
+#include "Sphere.h"
+#include "Triangle.h"
 #include "Cube.h"
+
+class Model;
+
 class GeometryMath {
 
     static float   _max(float a, float b);
@@ -0,0 +1,46 @@
+/*
+* LooseOctTree is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  LooseOctTree class. Octary tree for moving collision spheres.  Every node's bounds are
+*  enlarged by _looseness so each sphere is stored in exactly one node picked by its radius
+*  and center.  Inserting, moving and removing a sphere only walks down one path of the tree.
+*/
+#pragma once
+#include "OctNode.h"
+#include "Cube.h"
+#include <unordered_map>
+
+class LooseOctTree {
+    OctNode<Cube*>*                              _root; //Tight cell of the root node spans the whole volume
+    float                                        _looseness; //Scale of a node's loose bounds relative to its cell
+    int                                          _maxDepth; //Deepest level a sphere can be stored in
+    std::unordered_map<Sphere*, OctNode<Cube*>*> _sphereNodes; //The one node each sphere currently lives in
+    OctNode<Cube*>*                              _findNode(Sphere* sphere); //Walks down to the node a sphere belongs in
+    OctNode<Cube*>*                              _getChild(OctNode<Cube*>* node, int octant); //Creates children on demand
+    bool                                         _cellContains(Cube* cube, Vector4& position);
+    void                                         _querySpheres(OctNode<Cube*>* node, Sphere* sphere,
+                                                               std::unordered_map<Model*, std::set<Sphere*>>& overlaps);
+    void                                         _destroy(OctNode<Cube*>* node);
+public:
+    LooseOctTree(float cubicDimension, int maxDepth, float looseness = 2.0f);
+    ~LooseOctTree();
+    void insert(Model* model, Sphere* sphere);
+    void remove(Model* model, Sphere* sphere);
+    void update(Model* model, Sphere* sphere); //Relocates the sphere only if it has left its node's cell
+    void querySpheres(Sphere* sphere, std::unordered_map<Model*, std::set<Sphere*>>& overlaps); //Spheres whose nodes touch sphere
+};
\ No newline at end of file
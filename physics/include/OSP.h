@@ -19,15 +19,19 @@
 *  OSP class. Octary Space Partition class that subdivides primitive geometries for
 *  collision handling, etc.  Recursively creates subspaces based upon the maximum
 *  number of collision primitices specified by _maxGeometries.  The other tunable
-*  parameter is the size of the 3D space being captured by the OSP.
+*  parameter is the size of the 3D space being captured by the OSP.  Moving spheres can
+*  optionally be kept in a LooseOctTree instead so each one lives in a single node.
 */
 #pragma once
 #include <vector>
 #include "OctTree.h"
 #include "Cube.h"
 #include "Geometry.h"
+#include "LooseOctTree.h"
 #include <map>
 
+const int LOOSE_OCT_TREE_DEPTH = 8; //Deepest level of the dynamic loose oct tree
+
 class OSP {
     std::vector<OctNode<Cube*>*> _ospLeaves; //End nodes that are used for collision testing
     OctTree<Cube*>               _octTree; //Make a Cube Octary tree
@@ -37,10 +41,14 @@ class OSP {
     void                         _buildOctetTree(Cube* rectangle, OctNode<Cube*>* node);
     bool                         _insertSphereSubspaces(Model* model, Sphere& sphere, OctNode<Cube*>* node);
     std::map<Sphere*, std::set<Cube*>> _sphereCubeCache; //Caches previous list of subspace cubes for early out testing
+    LooseOctTree*                _looseOctTree; //Dynamic sphere layer, nullptr when spheres are stored in the leaves
+    void                         _findSphereLeaves(Sphere* sphere, OctNode<Cube*>* node, std::vector<OctNode<Cube*>*>& leaves);
 public:
-    OSP(float cubicDimension, int maxGeometries);
+    OSP(float cubicDimension, int maxGeometries, bool looseDynamic = false);
     ~OSP();
     void generateOSP(std::vector<Model*>& models);
     void updateOSP(std::vector<Model*>& models);
     std::vector<OctNode<Cube*>*>* getOSPLeaves();
+    LooseOctTree* getLooseOctTree();
+    void getSphereLeaves(Sphere* sphere, std::vector<OctNode<Cube*>*>& leaves); //Static leaves a sphere overlaps
 };
\ No newline at end of file
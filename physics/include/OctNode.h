@@ -22,10 +22,11 @@
 #include "Triangle.h"
 #include "Sphere.h"
 #include <unordered_map>
-#include "Model.h"
 #include <set>
 #include <vector>
 
+class Model; //Only used as a key so the tree builds without gl
+
 template<typename T>
 class OctNode {
     std::vector<OctNode*> _children; //8 children in an oct node
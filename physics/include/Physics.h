@@ -23,18 +23,21 @@
 #include "Model.h"
 #include "OSP.h"
 #include <vector>
+#include <map>
 
 class Physics {
 
     OSP                 _octalSpacePartioner;
     std::vector<Model*> _models; //Models containing collision Geometry
     void                _physicsProcess(int milliseconds); //Physics processing thread
+    void                _leafDetection(std::map<Model*, bool>& newContactStates); //Spheres and triangles share the OSP leaves
+    void                _looseDetection(std::map<Model*, bool>& newContactStates); //Spheres live in the OSP's loose oct tree
     void                _slowDetection(); //Keep the slow collision detection around for testing purposes
 
 public:
-    Physics();
+    Physics(bool looseDynamic = false); //looseDynamic stores moving spheres in a loose oct tree
     ~Physics();
-    void                run();
+    void                run(MasterClock* clock = MasterClock::instance()); //Subscribes to the kinematics feed of clock
     void                addModels(std::vector<Model*> models);
     void                addModel(Model* model);
 };
\ No newline at end of file
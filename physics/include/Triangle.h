@@ -20,13 +20,13 @@
 */
 
 #pragma once
-#include "Vector4.h"
+#include "Vector3.h"
 
 class Triangle {
-    Vector4 _points[3];
+    Vector3 _points[3]; //Packed storage, a triangle point's w is always 1
 public:
     Triangle(Vector4 A, Vector4 B, Vector4 C);
     ~Triangle();
-    Vector4x3 getTrianglePoints();
+    void getTrianglePoints(Vector4x3 points); //Expands the packed points for math
 
 };
\ No newline at end of file
@@ -35,50 +35,6 @@ bool GeometryMath::sphereProtrudesCube(Sphere* sphere, Cube* cube) {
     return false;
 }
 
-bool GeometryMath::spheresSpheresDetection(Model *spheresA, Model *spheresB) {
-
-    Geometry* spheresGeometryA = spheresA->getGeometry();
-    Geometry* spheresGeometryB = spheresB->getGeometry();
-
-    // Get all of the spheres that model the geometry A
-    auto sphereVecA = spheresGeometryA->getSpheres();
-    //Get all of the triangles that model the geometry B
-    auto sphereVecB = spheresGeometryB->getSpheres();
-
-    for (auto sphereA : *sphereVecA) {
-
-        for (auto sphereB : *sphereVecB) {
-
-            if (sphereSphereDetection(sphereA, sphereB)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool GeometryMath::spheresTrianglesDetection(Model *spheres, Model *triangles) {
-
-    Geometry* spheresGeometry = spheres->getGeometry();
-    Geometry* triangleGeometry = triangles->getGeometry();
-
-    //Get all of the spheres that model the geometry
-    auto sphereVec = spheresGeometry->getSpheres();
-    //Get all of the triangles that model the geometry
-    auto triangleVec = triangleGeometry->getTriangles();
-
-    for (auto sphere : *sphereVec) {
-
-        for (auto triangle : *triangleVec) {
-
-            if (sphereTriangleDetection(sphere, triangle)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 //3D Triangle plane test against a 3D Sphere
 bool GeometryMath::sphereTriangleDetection(Sphere& sphere, Triangle& triangle) {
 
@@ -96,7 +52,8 @@ bool GeometryMath::sphereTriangleDetection(Sphere& sphere, Triangle& triangle) {
     Vector4 spherePosition = sphere.getPosition();
     float sphereRadius = sphere.getRadius();
 
-    Vector4 *trianglePoints = triangle.getTrianglePoints();
+    Vector4 trianglePoints[3];
+    triangle.getTrianglePoints(trianglePoints);
     //Points A, B and C that describe a 3D Triangle
     Vector4 A(trianglePoints[0] - spherePosition);
     Vector4 B(trianglePoints[1] - spherePosition);
@@ -222,7 +179,8 @@ bool GeometryMath::triangleCubeDetection(Triangle* triangle, Cube* cube) {
     float e2 = cube->getLength() / 2.0f;
 
     // Translate triangle as conceptually moving AABB to origin
-    Vector4* points = triangle->getTrianglePoints();
+    Vector4 points[3];
+    triangle->getTrianglePoints(points);
     Vector4 v0 = points[0] - c;
     Vector4 v1 = points[1] - c;
     Vector4 v2 = points[2] - c;
@@ -475,45 +433,6 @@ bool GeometryMath::sphereCubeDetection(Sphere *sphere, Cube *cube) {
     return false;
 }
 
-void GeometryMath::sphereTriangleResolution(Model* modelA, Sphere& sphere, Model* modelB, Triangle& triangle) {
-
-    StateVector* modelStateA = modelA->getStateVector();
-    Vector4* triPoints = triangle.getTrianglePoints();
-    Vector4 spherePosition = sphere.getPosition();
-    float sphereRadius = sphere.getRadius();
-
-    //Compute the normal of the triangle
-    Vector4 normal = triPoints[2] - triPoints[0];
-    normal = normal.crossProduct(triPoints[1] - triPoints[0]);
-    normal.normalize();
-
-    Vector4 closestPointOnTriangle = _closestPoint(&sphere, &triangle);
-    Vector4 overlap = closestPointOnTriangle - spherePosition;
-    overlap.normalize();
-
-    Vector4 closestPoint = closestPointOnTriangle - ((overlap)*(sphereRadius*1.0001f)) - sphere.getPosition();
-
-    //Sliding velocity component
-    //Compute the speed of the resultant velocity along the normal for sliding collision resolution
-    float normalComponent = modelStateA->getLinearVelocity().dotProduct(normal);
-    //Resultant velocity vector
-    Vector4 n = normal*normalComponent;
-    //Subtract original velocity vectory with the new velocity vector along the normal
-    Vector4 resultantVelocity = modelStateA->getLinearVelocity() - n;
-
-    modelStateA->setLinearVelocity(resultantVelocity);
-
-    modelStateA->setContact(true);
-}
-void GeometryMath::sphereSphereResolution(Model* modelA, Sphere& sphereA, Model* modelB, Sphere& sphereB) {
-    //TODO but for now just halt kinematics
-    StateVector* modelStateA = modelA->getStateVector();
-    modelStateA->setActive(false);
-
-    StateVector* modelStateB = modelB->getStateVector();
-    modelStateB->setActive(false);
-}
-
 float GeometryMath::_max(float a, float b) {
     return (a > b ? a : b);
 }
@@ -527,7 +446,8 @@ Vector4 GeometryMath::_closestPoint(Sphere* sphere, Triangle* triangle)
     /** The code for Triangle-float3 test is from Christer Ericson's Real-Time Collision Detection, pp. 141-142. */
 
     // Check if P is in vertex region outside A.
-    Vector4* triPoints = triangle->getTrianglePoints();
+    Vector4 triPoints[3];
+    triangle->getTrianglePoints(triPoints);
     Vector4 A = triPoints[0];
     Vector4 B = triPoints[1];
     Vector4 C = triPoints[2];
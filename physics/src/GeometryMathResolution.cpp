@@ -0,0 +1,90 @@
+#include "GeometryMath.h"
+#include "Model.h"
+
+//Model level detection and resolution, kept out of GeometryMath.cpp so the primitive tests
+//build without the renderer
+
+bool GeometryMath::spheresSpheresDetection(Model *spheresA, Model *spheresB) {
+
+    Geometry* spheresGeometryA = spheresA->getGeometry();
+    Geometry* spheresGeometryB = spheresB->getGeometry();
+
+    // Get all of the spheres that model the geometry A
+    auto sphereVecA = spheresGeometryA->getSpheres();
+    //Get all of the triangles that model the geometry B
+    auto sphereVecB = spheresGeometryB->getSpheres();
+
+    for (auto sphereA : *sphereVecA) {
+
+        for (auto sphereB : *sphereVecB) {
+
+            if (sphereSphereDetection(sphereA, sphereB)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool GeometryMath::spheresTrianglesDetection(Model *spheres, Model *triangles) {
+
+    Geometry* spheresGeometry = spheres->getGeometry();
+    Geometry* triangleGeometry = triangles->getGeometry();
+
+    //Get all of the spheres that model the geometry
+    auto sphereVec = spheresGeometry->getSpheres();
+    //Get all of the triangles that model the geometry
+    auto triangleVec = triangleGeometry->getTriangles();
+
+    for (auto sphere : *sphereVec) {
+
+        for (auto triangle : *triangleVec) {
+
+            if (sphereTriangleDetection(sphere, triangle)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void GeometryMath::sphereTriangleResolution(Model* modelA, Sphere& sphere, Model* modelB, Triangle& triangle) {
+
+    StateVector* modelStateA = modelA->getStateVector();
+    Vector4 triPoints[3];
+    triangle.getTrianglePoints(triPoints);
+    Vector4 spherePosition = sphere.getPosition();
+    float sphereRadius = sphere.getRadius();
+
+    //Compute the normal of the triangle
+    Vector4 normal = triPoints[2] - triPoints[0];
+    normal = normal.crossProduct(triPoints[1] - triPoints[0]);
+    normal.normalize();
+
+    Vector4 closestPointOnTriangle = _closestPoint(&sphere, &triangle);
+    Vector4 overlap = closestPointOnTriangle - spherePosition;
+    overlap.normalize();
+
+    Vector4 closestPoint = closestPointOnTriangle - ((overlap)*(sphereRadius*1.0001f)) - sphere.getPosition();
+
+    //Sliding velocity component
+    //Compute the speed of the resultant velocity along the normal for sliding collision resolution
+    float normalComponent = modelStateA->getLinearVelocity().dotProduct(normal);
+    //Resultant velocity vector
+    Vector4 n = normal*normalComponent;
+    //Subtract original velocity vectory with the new velocity vector along the normal
+    Vector4 resultantVelocity = modelStateA->getLinearVelocity() - n;
+
+    modelStateA->setLinearVelocity(resultantVelocity);
+
+    modelStateA->setContact(true);
+}
+
+void GeometryMath::sphereSphereResolution(Model* modelA, Sphere& sphereA, Model* modelB, Sphere& sphereB) {
+    //TODO but for now just halt kinematics
+    StateVector* modelStateA = modelA->getStateVector();
+    modelStateA->setActive(false);
+
+    StateVector* modelStateB = modelB->getStateVector();
+    modelStateB->setActive(false);
+}
@@ -0,0 +1,160 @@
+#include "LooseOctTree.h"
+#include "GeometryMath.h"
+
+LooseOctTree::LooseOctTree(float cubicDimension, int maxDepth, float looseness) :
+    _looseness(looseness),
+    _maxDepth(maxDepth) {
+
+    //Root cell is centered at the origin of the axis just like the static OSP volume
+    _root = new OctNode<Cube*>(new Cube(cubicDimension, cubicDimension, cubicDimension, Vector4(0.0f, 0.0f, 0.0f, 1.0f)));
+}
+
+LooseOctTree::~LooseOctTree() {
+    _destroy(_root);
+}
+
+void LooseOctTree::insert(Model* model, Sphere* sphere) {
+    OctNode<Cube*>* node = _findNode(sphere);
+    node->addGeometry(model, sphere);
+    _sphereNodes[sphere] = node;
+}
+
+void LooseOctTree::remove(Model* model, Sphere* sphere) {
+    auto sphereNode = _sphereNodes.find(sphere);
+    if (sphereNode != _sphereNodes.end()) {
+        sphereNode->second->removeGeometry(model, sphere);
+        _sphereNodes.erase(sphereNode);
+    }
+}
+
+void LooseOctTree::update(Model* model, Sphere* sphere) {
+
+    auto sphereNode = _sphereNodes.find(sphere);
+    if (sphereNode == _sphereNodes.end()) {
+        insert(model, sphere);
+        return;
+    }
+
+    //The depth a sphere is stored at only depends on its radius, so as long as the center
+    //stays inside the same cell the sphere still belongs to the same node.  The root also holds
+    //spheres that were outside of the volume so always recheck those.
+    Vector4 position = sphere->getPosition();
+    if (sphereNode->second != _root && _cellContains(sphereNode->second->getData(), position)) {
+        return;
+    }
+
+    OctNode<Cube*>* node = _findNode(sphere);
+    if (node != sphereNode->second) {
+        sphereNode->second->removeGeometry(model, sphere);
+        node->addGeometry(model, sphere);
+        sphereNode->second = node;
+    }
+}
+
+void LooseOctTree::querySpheres(Sphere* sphere, std::unordered_map<Model*, std::set<Sphere*>>& overlaps) {
+    _querySpheres(_root, sphere, overlaps);
+}
+
+OctNode<Cube*>* LooseOctTree::_findNode(Sphere* sphere) {
+
+    Vector4 position = sphere->getPosition();
+    float radius = sphere->getRadius();
+    float* center = position.getFlatBuffer();
+
+    OctNode<Cube*>* node = _root;
+
+    //Anything centered outside of the volume can only be held by the root's loose bounds
+    if (!_cellContains(node->getData(), position)) {
+        return node;
+    }
+
+    for (int depth = 0; depth < _maxDepth; ++depth) {
+
+        //A child's loose bounds reach (_looseness - 1) half cells past its own cell so the
+        //sphere only fits in a child if its radius is no larger than that overhang
+        float childHalf = node->getData()->getLength() / 4.0f;
+        if (radius > (_looseness - 1.0f) * childHalf) {
+            break;
+        }
+
+        //Pick the child cell containing the sphere's center
+        Vector4 cellCenter = node->getData()->getCenter();
+        int octant = (center[0] > cellCenter.getx() ? 1 : 0) |
+                     (center[1] > cellCenter.gety() ? 2 : 0) |
+                     (center[2] > cellCenter.getz() ? 4 : 0);
+        node = _getChild(node, octant);
+    }
+    return node;
+}
+
+OctNode<Cube*>* LooseOctTree::_getChild(OctNode<Cube*>* node, int octant) {
+
+    OctNode<Cube*>* child = node->getChild(octant);
+    if (child == nullptr) {
+        Cube* cube = node->getData();
+        float cubicDimension = cube->getLength() / 2.0f;
+        float dim = cubicDimension / 2.0f;
+
+        Vector4 offset((octant & 1) ? dim : -dim,
+                       (octant & 2) ? dim : -dim,
+                       (octant & 4) ? dim : -dim, 1);
+
+        child = node->insert(new Cube(cubicDimension, cubicDimension, cubicDimension, offset + cube->getCenter()), octant);
+    }
+    return child;
+}
+
+bool LooseOctTree::_cellContains(Cube* cube, Vector4& position) {
+
+    Vector4 distance = position - cube->getCenter();
+    float* dist = distance.getFlatBuffer();
+    float half = cube->getLength() / 2.0f;
+
+    return dist[0] >= -half && dist[0] <= half &&
+           dist[1] >= -half && dist[1] <= half &&
+           dist[2] >= -half && dist[2] <= half;
+}
+
+void LooseOctTree::_querySpheres(OctNode<Cube*>* node, Sphere* sphere,
+                                 std::unordered_map<Model*, std::set<Sphere*>>& overlaps) {
+
+    //Test against the node's loose bounds instead of its cell
+    Cube* cube = node->getData();
+    float looseDimension = cube->getLength() * _looseness;
+    Cube looseCube(looseDimension, looseDimension, looseDimension, cube->getCenter());
+    bool overlapsBounds = GeometryMath::sphereCubeDetection(sphere, &looseCube);
+
+    //The root also holds the spheres centered outside of the volume wherever they are, so its own
+    //spheres are always candidates and only its children are skipped by the bounds test
+    if (!overlapsBounds && node != _root) {
+        return;
+    }
+
+    for (std::pair<Model* const, std::set<Sphere*>>& sphereMap : *node->getSpheres()) {
+        for (Sphere* other : sphereMap.second) {
+            if (other != sphere) {
+                overlaps[sphereMap.first].insert(other);
+            }
+        }
+    }
+
+    if (!overlapsBounds) {
+        return;
+    }
+
+    for (OctNode<Cube*>* child : node->getChildren()) {
+        if (child != nullptr) {
+            _querySpheres(child, sphere, overlaps);
+        }
+    }
+}
+
+void LooseOctTree::_destroy(OctNode<Cube*>* node) {
+    for (OctNode<Cube*>* child : node->getChildren()) {
+        if (child != nullptr) {
+            _destroy(child);
+        }
+    }
+    delete node->getData();
+    delete node;
+}
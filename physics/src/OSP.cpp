@@ -1,20 +1,50 @@
 #include "OSP.h"
 #include "GeometryMath.h"
+#include "Model.h"
 
-OSP::OSP(float cubicDimension, int maxGeometries) :
+OSP::OSP(float cubicDimension, int maxGeometries, bool looseDynamic) :
     _cubicDimension(cubicDimension),
-    _maxGeometries(maxGeometries) {
+    _maxGeometries(maxGeometries),
+    _looseOctTree(nullptr) {
 
+    if (looseDynamic) {
+        _looseOctTree = new LooseOctTree(cubicDimension, LOOSE_OCT_TREE_DEPTH);
+    }
 }
 
 OSP::~OSP() {
-
+    delete _looseOctTree;
 }
 
 std::vector<OctNode<Cube*>*>* OSP::getOSPLeaves() {
     return &_ospLeaves;
 }
 
+LooseOctTree* OSP::getLooseOctTree() {
+    return _looseOctTree;
+}
+
+void OSP::getSphereLeaves(Sphere* sphere, std::vector<OctNode<Cube*>*>& leaves) {
+    _findSphereLeaves(sphere, _octTree.getRoot(), leaves);
+}
+
+void OSP::_findSphereLeaves(Sphere* sphere, OctNode<Cube*>* node, std::vector<OctNode<Cube*>*>& leaves) {
+
+    if (!GeometryMath::sphereCubeDetection(sphere, node->getData())) {
+        return;
+    }
+
+    //Children are always built as a full set of 8 so an empty first slot marks a leaf
+    std::vector<OctNode<Cube*>*>& children = node->getChildren();
+    if (children[0] == nullptr) {
+        leaves.push_back(node);
+        return;
+    }
+    for (OctNode<Cube*>* child : children) {
+        _findSphereLeaves(sphere, child, leaves);
+    }
+}
+
 void OSP::generateOSP(std::vector<Model*>& models) {
 
 
@@ -37,8 +67,12 @@ void OSP::generateOSP(std::vector<Model*>& models) {
         std::vector<Sphere>* spheres = model->getGeometry()->getSpheres();
         for (Sphere & sphere : *spheres) {
 
+            //Spheres only ever live in one node of the loose tree and never enter the static leaves
+            if (_looseOctTree != nullptr) {
+                _looseOctTree->insert(model, &sphere);
+            }
             //if geometry data is contained within the first octet then build it out
-            if (GeometryMath::sphereCubeDetection(&sphere, rootCube)) {
+            else if (GeometryMath::sphereCubeDetection(&sphere, rootCube)) {
 
                 node->addGeometry(model, &sphere);
             }
@@ -58,6 +92,12 @@ void OSP::updateOSP(std::vector<Model*>& models){
             std::vector<Sphere>* spheres = model->getGeometry()->getSpheres();
             for (Sphere& sphere : *spheres) {
 
+                //Loose tree relocates the sphere by walking a single path down the tree
+                if (_looseOctTree != nullptr) {
+                    _looseOctTree->update(model, &sphere);
+                    continue;
+                }
+
                 ////Early out test if the sphere is completely contained within this cube,
                 ////otherwise if the sphere is somewhat outside (protrudes) of it's native cube then update OSP
                 //std::set<Cube*>& cubes = _sphereCubeCache[&sphere];
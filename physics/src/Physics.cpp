@@ -3,7 +3,7 @@
 
 //Make OSP (Octal Space Partioner) a 2000 cubic block and ensure only 500 primitives at maximum
 //are within a subspace of the OSP
-Physics::Physics() : _octalSpacePartioner(2000, 500) {
+Physics::Physics(bool looseDynamic) : _octalSpacePartioner(2000, 500, looseDynamic) {
 
 }
 
@@ -11,9 +11,8 @@ Physics::~Physics() {
 
 }
 
-void Physics::run() {
+void Physics::run(MasterClock* clock) {
 
-    MasterClock* clock = MasterClock::instance();
     clock->subscribeKinematicsRate(std::bind(&Physics::_physicsProcess, this, std::placeholders::_1));
 }
 
@@ -43,6 +42,23 @@ void Physics::_physicsProcess(int milliseconds) {
         prevContactStates.push_back(model->getStateVector()->getContact());
     }
 
+    if (_octalSpacePartioner.getLooseOctTree() != nullptr) {
+        _looseDetection(newContactStates);
+    }
+    else {
+        _leafDetection(newContactStates);
+    }
+
+    int i = 0;
+    for(Model* model : _models){
+        if(prevContactStates[i++] && !newContactStates[model]){
+            model->getStateVector()->setContact(false);
+        }
+    }
+}
+
+void Physics::_leafDetection(std::map<Model*, bool>& newContactStates) {
+
     auto ospEndNodes = _octalSpacePartioner.getOSPLeaves();
 
     for (OctNode<Cube*> * subspaceNode : *ospEndNodes) {
@@ -128,11 +144,60 @@ void Physics::_physicsProcess(int milliseconds) {
         //Triangle on triangle detections...probably will NOT implement...maybe some day
 
     }
+}
 
-    int i = 0;
-    for(Model* model : _models){
-        if(prevContactStates[i++] && !newContactStates[model]){
-            model->getStateVector()->setContact(false);
+void Physics::_looseDetection(std::map<Model*, bool>& newContactStates) {
+
+    LooseOctTree* looseOctTree = _octalSpacePartioner.getLooseOctTree();
+
+    //Each moving sphere is stored once in the loose tree so walk the spheres directly
+    //and only pull in the static leaves and neighbor spheres that can touch them
+    for (Model* model : _models) {
+
+        //Like the leaf path a pair is tested when either of its models is active
+        bool modelActive = model->getStateVector()->getActive();
+
+        std::vector<Sphere>* spheres = model->getGeometry()->getSpheres();
+        for (Sphere& sphere : *spheres) {
+
+            //Sphere on sphere detections
+            std::unordered_map<Model*, std::set<Sphere*>> sphereMaps;
+            looseOctTree->querySpheres(&sphere, sphereMaps);
+            for (std::pair<Model* const, std::set<Sphere*>>& sphereMap : sphereMaps) {
+
+                //Only do detections for different models, do not detect an overlap for a model on itself...
+                if (sphereMap.first != model && (modelActive || sphereMap.first->getStateVector()->getActive())) {
+                    for (Sphere* otherSphere : sphereMap.second) {
+                        //If an overlap between a sphere and a sphere is detected then process the overlap resolution
+                        if (GeometryMath::sphereSphereDetection(sphere, *otherSphere)) {
+
+                            //GeometryMath::sphereSphereResolution(model, sphere, sphereMap.first, *otherSphere);
+                        }
+                    }
+                }
+            }
+
+            //Sphere on triangle detections
+            std::vector<OctNode<Cube*>*> leaves;
+            _octalSpacePartioner.getSphereLeaves(&sphere, leaves);
+
+            bool newContactState = false;
+            for (OctNode<Cube*>* subspaceNode : leaves) {
+                for (std::pair<Model* const, std::set<Triangle*>>& triangleMap : *subspaceNode->getTriangles()) {
+                    if (!modelActive && !triangleMap.first->getStateVector()->getActive()) {
+                        continue;
+                    }
+                    for (Triangle* triangle : triangleMap.second) {
+                        //If an overlap between a sphere and a triangle is detected then process the overlap resolution
+                        if (GeometryMath::sphereTriangleDetection(sphere, *triangle)) {
+
+                            GeometryMath::sphereTriangleResolution(model, sphere, triangleMap.first, *triangle);
+                            newContactState = true;
+                        }
+                    }
+                }
+            }
+            newContactStates[model] = newContactStates[model] || newContactState;
         }
     }
 }
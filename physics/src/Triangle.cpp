@@ -9,6 +9,8 @@ Triangle::~Triangle() {
 
 }
 
-Vector4x3 Triangle::getTrianglePoints(){
-    return _points;
+void Triangle::getTrianglePoints(Vector4x3 points){
+    points[0] = _points[0].toVector4();
+    points[1] = _points[1].toVector4();
+    points[2] = _points[2].toVector4();
 }
@@ -27,6 +27,8 @@ class Model;
 
 class AnimationShader : public StaticShader {
 
+    GLint _modelLocation;
+    GLint _textureLocation;
     GLint _bonesLocation;
 
 public:
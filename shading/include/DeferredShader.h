@@ -38,28 +38,15 @@ class DeferredShader : public Shader {
     GLuint _normalTextureLocation;
     GLuint _diffuseTextureLocation;
     GLuint _positionTextureLocation;
-    GLuint _cameraDepthTextureLocation;
-    GLuint _mapDepthTextureLocation;
+    GLuint _shadowCascadesLocation;
     GLuint _quadBufferContext;
     GLuint _textureBufferContext;
-    GLuint _lightLocation;
-    GLuint _lightViewLocation;
-    GLuint _lightMapViewLocation;
-    GLuint _viewsLocation;
-    GLuint _pointLightCountLocation;
-    GLuint _pointLightPositionsLocation;
-    GLuint _pointLightColorsLocation;
-    GLuint _pointLightRangesLocation;
     GLuint _pointLightDepthMapLocation;
-    GLuint _viewToModelSpaceMatrixLocation;
-    GLuint _farPlaneLocation;
     GLuint _ssaoTextureLocation;
     GLuint _environmentMapTextureLocation;
 
     GLuint _skyboxDayTextureLocation;
     GLuint _skyboxNightTextureLocation;
-    GLuint _inverseViewLocation;
-    GLuint _inverseProjectionLocation;
     Texture* _skyBoxDayTexture;
     Texture* _skyBoxNightTexture;
     GLuint   _vaoContext;
@@ -21,14 +21,16 @@
 
 #pragma once
 #include "Shader.h"
+#include "TextureBroker.h"
 
 class FontRenderer;
 
 class FontShader : public Shader {
-    GLint  _textureLocation;
-    GLuint _vaoContext;
+    GLint         _textureLocation;
+    GLuint        _vaoContext;
+    TextureHandle _fontTexture; //Glyph atlas, resolved once when the shader is built
 public:
     FontShader(std::string shaderName);
     virtual ~FontShader();
-    virtual void runShader(GLuint vao, std::string& s);
+    virtual void runShader(GLuint vao, GLint firstVertex, GLsizei vertexCount);
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+* InstanceCullShader is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+*  InstanceCullShader class. Compute pass that tests every instance's box against the camera frustum
+*  on the gpu, compacts the visible instance indices and counts them into the indirect draw commands.
+*/
+
+#pragma once
+#include "Shader.h"
+#include "Frustum.h"
+class InstanceBuffer;
+
+const GLuint CULL_TRANSFORMS_BINDING = 4; //Shader storage bindings after the light and draw constant buffers
+const GLuint CULL_INSTANCES_BINDING  = 5;
+const GLuint CULL_COMMANDS_BINDING   = 6;
+const GLuint CULL_GROUP_SIZE         = 64; //Must match local_size_x in instanceCullShader.comp
+
+class InstanceCullShader : public Shader {
+
+    GLint _boundsTransformLocation;
+    GLint _planesLocation;
+    GLint _instanceCountLocation;
+    GLint _commandCountLocation;
+public:
+    InstanceCullShader();
+    ~InstanceCullShader();
+    void runShader(InstanceBuffer* instanceBuffer, Matrix boundsTransform, const Frustum& frustum,
+                   GLuint instanceCount, GLuint commandCount);
+};
\ No newline at end of file
@@ -16,25 +16,45 @@
 */
 
 /**
-*  InstancedForwardShader class. Draws many instances using the static shader and adds offsets.
+*  InstancedForwardShader class. Draws many instances using the static shader and applies a world transform per instance.
+*  Instances are culled against the camera by a compute pass that feeds indirect draws, or on the cpu as a fallback
+*  and whenever the occlusion buffer holds occluders.
 */
 
 #pragma once
 #include "ForwardShader.h"
 #include "Vector4.h"
+#include "Frustum.h"
+#include "InstanceBuffer.h"
+#include "InstanceCullShader.h"
+#include "OcclusionBuffer.h"
 #include <vector>
 class ViewManager;
 class ShadowRenderer;
 class PointShadowMap;
 
+const bool INSTANCE_GPU_CULLING = true; //false culls on the cpu and uploads the visible indices every frame
+
 class InstancedForwardShader : public ForwardShader {
 
 protected:
-    GLint       _offsetsLocation;
+    GLint                 _instanceTransformsLocation;
+    std::vector<Matrix>   _instanceBoxes; //Scratch transforms mapping the [-1, 1] cube onto each instance's box
+    std::vector<uint32_t> _visibleMasks; //Scratch visibility bit per instance
+    std::vector<GLuint>   _visibleInstances; //Indices of the instances that survived culling
+    std::vector<DrawArraysIndirectCommand> _commands; //One draw per transparent stride
+    std::vector<int>      _commandStrides; //Texture stride each draw belongs to
+    InstanceCullShader    _cullShader;
+
+    GLsizei               _cullInstances(Model* model, const Frustum& frustum,
+                                         const OcclusionBuffer* occlusionBuffer); //Returns the number of visible instances, occlusionBuffer may be null
+#if defined(GPU_CULL_VERIFY)
+    void                  _verifyCulling(Model* model, const Frustum& frustum,
+                                         const OcclusionBuffer* occlusionBuffer); //Reports where the gpu and cpu culls disagree
+#endif
 public:
     InstancedForwardShader(std::string shaderName);
     virtual ~InstancedForwardShader();
     virtual void runShader(Model* model, ViewManager* viewManager, ShadowRenderer* shadowRenderer,
-        std::vector<Light*>& lights, PointShadowMap* pointShadowMap);
-    void setInstances(std::vector<Vector4> offsets);
+        std::vector<Light*>& lights, PointShadowMap* pointShadowMap, const OcclusionBuffer* occlusionBuffer);
 };
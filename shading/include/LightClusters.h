@@ -0,0 +1,75 @@
+/*
+* LightClusters is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  LightClusters class. Clustered point light assignment.  The view frustum is split into a grid
+*  of screen tiles and exponentially spaced depth slices, and every frame each point light's view
+*  space bounds are binned into the clusters they overlap on the cpu, four lights at a time.  The
+*  lights, one offset and count pair per cluster and the flat light index list are written to
+*  shader storage buffers so a pixel only loops over the lights in its own cluster.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include "SIMD.h"
+#include <vector>
+
+class StreamBuffer;
+class ViewManager;
+class Light;
+
+const GLuint POINT_LIGHTS_BINDING   = 0; //Shader storage binding points
+const GLuint LIGHT_CLUSTERS_BINDING = 1;
+const GLuint LIGHT_INDICES_BINDING  = 2;
+const int    CLUSTER_TILES_X        = 16;
+const int    CLUSTER_TILES_Y        = 9;
+const int    CLUSTER_SLICES         = 24;
+const int    CLUSTER_COUNT          = CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+
+struct PointLightData {
+    float positionRange[4]; //View space position with the range in w
+    float color[4];
+};
+
+struct LightCluster {
+    GLuint offset; //First entry of the cluster in the light index list
+    GLuint count;
+};
+
+class LightClusters {
+
+    StreamBuffer*               _storage; //Ring the three storage buffers are appended to every frame
+    GLint                       _storageAlignment; //GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+    float                       _sliceScale; //Depth slice is log(depth) * _sliceScale + _sliceBias
+    float                       _sliceBias;
+    std::vector<PointLightData> _lights;
+    std::vector<LightCluster>   _clusters;
+    std::vector<GLuint>         _indices;
+    //Light spheres and their projected bounds in structure of arrays order, padded to a multiple of four
+    std::vector<float>          _centerX, _centerY, _depth, _range; //View space center, depth is -z
+    std::vector<float>          _minX, _maxX, _minY, _maxY; //Normalized device coordinate bounds
+    std::vector<float>          _nearDepth, _farDepth; //Depth range clamped to the near plane
+
+    void                        _computeBounds(float scaleX, float scaleY, float nearPlane); //Fills the bounds four lights at a time
+    void                        _bind(GLuint binding, const void* data, size_t size);
+public:
+    LightClusters();
+    ~LightClusters();
+    void                        update(ViewManager* viewManager, std::vector<Light*>& lights);
+    float                       getSliceScale();
+    float                       getSliceBias();
+    int                         getLightCount();
+};
\ No newline at end of file
@@ -16,7 +16,7 @@
 */
 
 /**
-*  ShadowAnimatedPointShader class. Uses vertex, geometry and fragment shader to generate 
+*  ShadowAnimatedPointShader class. Uses vertex and fragment shader to generate one face of
 *  a texture cube map containing depth information around a single point in space
 */
 
@@ -31,5 +31,5 @@ class ShadowAnimatedPointShader : public ShadowPointShader {
 public:
     ShadowAnimatedPointShader(std::string shaderName);
     virtual      ~ShadowAnimatedPointShader();
-    void         runShader(Model* model, Light* light, std::vector<Matrix> lightTransforms);
+    void         runShader(Model* model, Light* light, Matrix& faceTransform); //Draws into the bound cube face
 };
\ No newline at end of file
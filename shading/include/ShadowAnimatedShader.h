@@ -31,5 +31,5 @@ class ShadowAnimatedShader : public ShadowStaticShader {
 public:
     ShadowAnimatedShader(std::string shaderName);
     virtual		 ~ShadowAnimatedShader();
-	void runShader(Model* model, Light* light);
+	void runShader(Model* model, MVP& lightMVP); //lightMVP supplies the light view and projection
 };
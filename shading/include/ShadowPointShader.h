@@ -16,7 +16,7 @@
 */
 
 /**
-*  ShadowPointShader class. Uses vertex, geometry and fragment shader to generate 
+*  ShadowPointShader class. Uses vertex and fragment shader to generate one face of
 *  a texture cube map containing depth information around a single point in space
 */
 
@@ -29,11 +29,11 @@ class ShadowPointShader : public Shader{
 protected:
     GLint       _viewLocation;
     GLint       _modelLocation;
-    GLint       _lightCubeTransformsLocation;
+    GLint       _faceTransformLocation;
     GLint       _lightPosLocation;
     GLint       _farPlaneLocation;
 public:
     ShadowPointShader(std::string shaderName);
     virtual      ~ShadowPointShader();
-    void         runShader(Model* model, Light* light, std::vector<Matrix> lightTransforms);
+    void         runShader(Model* model, Light* light, Matrix& faceTransform); //Draws into the bound cube face
 };
\ No newline at end of file
@@ -35,7 +35,7 @@ protected:
 public:
     ShadowStaticShader(std::string shaderName);
     virtual		 ~ShadowStaticShader();
-	void         runShader(Model* model, Light* light);
+	void         runShader(Model* model, MVP& lightMVP); //lightMVP supplies the light view and projection
     GLint        getViewLocation();
     GLint        getModelLocation();
     GLint        getProjectionLocation();
@@ -23,28 +23,21 @@
 
 #pragma once
 #include "Shader.h"
+#include "DrawList.h"
+#include "Material.h"
 
 class StaticShader : public Shader {
 
 protected:
-    GLint       _viewLocation;
-    GLint       _modelLocation;
-    GLint       _projectionLocation;
-    GLint       _normalLocation;
-    GLint       _textureLocation;
-    GLint       _tex0Location;
-    GLint       _tex1Location;
-    GLint       _tex2Location;
-    GLint       _tex3Location;
-    GLint       _alphatex0Location;
+    GLint       _samplerLocations[MATERIAL_SAMPLER_COUNT];
     GLint       _layeredSwitchLocation;
 public:
     StaticShader(std::string shaderName);
     virtual ~StaticShader();
-    virtual void runShader(Model* model);
-    GLint        getViewLocation();
-    GLint        getModelLocation();
-    GLint        getProjectionLocation();
-    GLint        getNormalLocation();
-    GLint        getTextureLocation();
+    virtual void runShader(Model* model); //Binds and draws the model right away
+    void         recordDraws(Model* model, DrawList* drawList, float depth); //Queues a draw per opaque texture stride
+    bool         isDrawn(Model* model, int stride); //Transparent strides are left for the forward pass
+    void         bindProgram();
+    void         bindMaterial(const Material* material); //Textures and uniforms of one texture stride
+    void         unbind();
 };
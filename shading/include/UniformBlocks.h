@@ -0,0 +1,77 @@
+/*
+* UniformBlocks is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  UniformBlocks class. Owns the std140 uniform buffers holding the constants every shader of a
+*  frame shares: frame constants, the camera's view constants and the directional lights.  Each
+*  block is written once per frame and stays bound to a fixed binding point, so draws only upload
+*  their model matrix.  Blocks are declared row_major in glsl so matrices are copied as is.
+*/
+#pragma once
+#include "GLIncludes.h"
+#include "Matrix.h"
+#include "ShadowRenderer.h"
+#include <vector>
+
+class ViewManager;
+class Light;
+class LightClusters;
+
+const GLuint FRAME_CONSTANTS_BINDING = 0;
+const GLuint VIEW_CONSTANTS_BINDING  = 1;
+const GLuint LIGHT_CONSTANTS_BINDING = 2;
+
+struct FrameConstants {
+    float time; //Seconds since the first frame
+    int   views; //ViewManager::ViewState used by the debug views
+    float padding[2];
+};
+
+struct ViewConstants {
+    float view[16];
+    float projection[16];
+    float normal[16]; //Normal matrix of the view
+    float inverseView[16]; //Camera view space back to world space
+    float inverseProjection[16];
+    float planes[4]; //Near and far plane distances
+};
+
+struct LightConstants {
+    float cascadeMatrices[SHADOW_CASCADES][16]; //Camera view space to each shadow cascade's clip space
+    float cascadeSplits[4]; //View depth where each shadow cascade ends
+    float light[4]; //Directional light look at vector
+    int   clusterDims[4]; //Tiles across, tiles up and depth slices of the point light clusters
+    float clusterDepth[4]; //Slice of a view space depth is log(depth) * x + y
+};
+
+class UniformBlocks {
+
+    GLuint         _buffers[3]; //Indexed by binding point
+    FrameConstants _frame;
+    ViewConstants  _view;
+    LightConstants _lights;
+    void           _upload(GLuint binding, const void* data, size_t size);
+
+public:
+    UniformBlocks();
+    ~UniformBlocks();
+    static void    bindProgram(GLuint program); //Points the program's blocks at the fixed binding points
+    void           updateFrame(float seconds, int views);
+    void           updateView(ViewManager* viewManager);
+    void           updateLights(ViewManager* viewManager, std::vector<Light*>& lights, LightClusters* clusters,
+                                ShadowRenderer* shadowRenderer);
+};
\ No newline at end of file
@@ -1,10 +1,9 @@
-#version 330
+#version 430
 
 uniform sampler2D diffuseTexture;   //Diffuse texture data array
 uniform sampler2D normalTexture;    //Normal texture data array
 uniform sampler2D positionTexture;  //Position texture data array
-uniform sampler2D cameraDepthTexture;   //depth texture data array with values 1.0 to 0.0, with 0.0 being closer
-uniform sampler2D mapDepthTexture;      //depth texture data array with values 1.0 to 0.0, with 0.0 being closer
+uniform sampler2DArray shadowCascades; //Depth of each sun shadow cascade, values 1.0 to 0.0 with 0.0 being closer
 uniform samplerCube depthMap;		//cube depth map for point light shadows
 uniform samplerCube skyboxDayTexture;   //skybox day
 uniform samplerCube skyboxNightTexture;	//skybox night
@@ -13,19 +12,59 @@ uniform sampler2D   ssaoTexture;      //depth texture data array with values 1.0
 
 in vec3 vsViewDirection;
 
-uniform mat4 lightViewMatrix;     	//Light perspective's view matrix
-uniform mat4 lightMapViewMatrix;    //Light perspective's view matrix
-uniform mat4 viewToModelMatrix;		//Inverse camera view space matrix
+layout(std140, row_major) uniform ViewConstants {
+	mat4 view;              // View/Camera transformation matrix
+	mat4 projection;        // Projection transformation matrix
+	mat4 normal;            // Normal matrix
+	mat4 inverseView;       // Camera view space back to world space
+	mat4 inverseProjection; // Clip space back to camera view space
+	vec4 planes;            // Near and far plane distances
+};
 
-uniform vec3 pointLightPositions[20];//max lights is 20 for now
-uniform vec3 pointLightColors[20]; //max lights is 20 for now
-uniform float pointLightRanges[20];//max lights is 20 for now
-uniform int  numPointLights;
+layout(std140, row_major) uniform LightConstants {
+	mat4  cascadeMatrices[3];     //Camera view space to each sun shadow cascade's clip space
+	vec4  cascadeSplits;          //View depth where each cascade ends
+	vec4  light;                  //Directional light look at vector
+	ivec4 clusterDims;            //Tiles across, tiles up and depth slices of the point light clusters
+	vec4  clusterDepth;           //Slice of a view space depth is log(depth) * x + y
+};
 
-uniform int views;   //views set to 0 is diffuse mapping, set to 1 is shadow mapping and set to 2 is normal mapping
+struct PointLight {
+	vec4 positionRange; //View space position with the range in w
+	vec4 color;
+};
+
+struct LightCluster {
+	uint offset; //First entry of the cluster in lightIndices
+	uint count;
+};
+
+layout(std430, binding = 0) readonly buffer PointLights {
+	PointLight pointLights[];
+};
+
+layout(std430, binding = 1) readonly buffer LightClusters {
+	LightCluster clusters[];
+};
+
+layout(std430, binding = 2) readonly buffer LightIndices {
+	uint lightIndices[];
+};
+
+//Cluster holding a view space position, matches the binning done by LightClusters on the cpu
+uint clusterIndex(vec3 viewPosition) {
+	vec4 clip = projection * vec4(viewPosition, 1.0);
+	vec2 ndc = clip.xy / clip.w;
+	ivec2 tile = clamp(ivec2((ndc * 0.5 + 0.5) * vec2(clusterDims.xy)), ivec2(0), clusterDims.xy - 1);
+	int slice = clamp(int(log(-viewPosition.z) * clusterDepth.x + clusterDepth.y), 0, clusterDims.z - 1);
+	return uint(tile.x + clusterDims.x * (tile.y + clusterDims.y * slice));
+}
+
+layout(std140) uniform FrameConstants {
+	float time;  //Seconds since the first frame
+	int   views; //views set to 0 is diffuse mapping, set to 1 is shadow mapping and set to 2 is normal mapping
+};
 
-uniform vec3 light;  
-uniform float farPlane;
 in vec2 textureCoordinateOut; // Passthrough
 
 vec2 poissonDisk[4] = vec2[](
@@ -37,6 +76,26 @@ vec2 poissonDisk[4] = vec2[](
 
 float ambient = 0.3;
 float shadowEffect = 0.6;
+
+//Sun shadow of a view space position, picks the cascade by view depth
+float cascadeShadow(vec3 viewPosition) {
+	float depth = -viewPosition.z;
+	if(depth >= cascadeSplits.z) {
+		return 1.0;
+	}
+	int cascade = depth < cascadeSplits.x ? 0 : (depth < cascadeSplits.y ? 1 : 2);
+	
+	//Convert from camera space vertex to the cascade's light clip space
+	vec4 shadowMapping = cascadeMatrices[cascade] * vec4(viewPosition, 1.0);
+	shadowMapping = shadowMapping/shadowMapping.w; 
+	vec3 shadowTextureCoordinates = shadowMapping.xyz * vec3(0.5,0.5,0.5) + vec3(0.5,0.5,0.5);
+	
+	const float bias = 0.005; //removes shadow acne by adding a small bias
+	if(texture(shadowCascades, vec3(shadowTextureCoordinates.xy, float(cascade))).x < shadowTextureCoordinates.z - bias){
+		return shadowEffect;
+	}
+	return 1.0;
+}
 out vec4 fragColor;
 
 void main(){
@@ -51,7 +110,7 @@ void main(){
 	float occlusion = texture(ssaoTexture, textureCoordinateOut.xy).r;
 	
 	if(position.x != 0.0 && position.y != 0.0 && position.z != 0.0){
-		gl_FragDepth = (length(position.xyz)/farPlane) / 2.0f;
+		gl_FragDepth = (length(position.xyz)/planes.y) / 2.0f;
 	}
 	else{
 		gl_FragDepth = 0.5f;
@@ -60,18 +119,9 @@ void main(){
 	//Directional light calculation
 	//NEED to invert light vector other a normal surface pointing up with a light pointing
 	//down would result in a negative dot product of the two vecs, inverting gives us positive numbers!
-	vec3 normalizedLight = normalize(-light);
+	vec3 normalizedLight = normalize(-light.xyz);
 	float illumination = dot(normalizedLight, normalizedNormal);
 	
-	//Convert from camera space vertex to light clip space vertex
-	vec4 shadowMapping = lightViewMatrix * vec4(position.xyz, 1.0);
-    shadowMapping = shadowMapping/shadowMapping.w; 
-    vec2 shadowTextureCoordinates = shadowMapping.xy * vec2(0.5,0.5) + vec2(0.5,0.5);
-	
-	vec4 shadowMappingMap = lightMapViewMatrix * vec4(position.xyz, 1.0);
-	shadowMappingMap = shadowMappingMap/shadowMappingMap.w; 
-	vec2 shadowTextureCoordinatesMap = shadowMappingMap.xy * vec2(0.5,0.5) + vec2(0.5,0.5);
-
 	if(views == 0){
 		if(position.x == 0.0 && position.y == 0.0 && position.z == 0.0){
 			vec4 dayColor = texture(skyboxDayTexture, vec3(vsViewDirection.x, -vsViewDirection.y, vsViewDirection.z));
@@ -86,23 +136,7 @@ void main(){
 			//illumination is from directional light but we don't want to illuminate when the sun is past the horizon
 			//aka night time
 			if(light.y <= 0.0) {
-				const float bias = 0.005; //removes shadow acne by adding a small bias
-				//Only shadow in textures space
-				if(shadowTextureCoordinates.x <= 1.0 && shadowTextureCoordinates.x >= 0.0 && shadowTextureCoordinates.y <= 1.0 && shadowTextureCoordinates.y >= 0.0){
-					
-					if ( texture( cameraDepthTexture, shadowTextureCoordinates).x < (shadowMapping.z * 0.5 + 0.5) - bias){
-						directionalShadow = shadowEffect;
-					}	
-				}
-				else if(shadowTextureCoordinatesMap.x <= 1.0 && shadowTextureCoordinatesMap.x >= 0.0 && shadowTextureCoordinatesMap.y <= 1.0 && shadowTextureCoordinatesMap.y >= 0.0){
-					vec4 shadowMappingMap = lightMapViewMatrix * vec4(position.xyz, 1.0);
-					shadowMappingMap = shadowMappingMap/shadowMappingMap.w; 
-					vec2 shadowTextureCoordinatesMap = shadowMappingMap.xy * vec2(0.5,0.5) + vec2(0.5,0.5);
-					
-					if ( texture( mapDepthTexture, shadowTextureCoordinatesMap).x < (shadowMappingMap.z * 0.5 + 0.5) - bias){
-						directionalShadow = shadowEffect;
-					}	
-				}
+				directionalShadow = cascadeShadow(position.xyz);
 				
 			}
 			else {
@@ -110,20 +144,23 @@ void main(){
 			}
 			
 			//Point lights always emit light versus directional sun shadows
-			float numLights = numPointLights;
+			LightCluster cluster = clusters[clusterIndex(position.xyz)];
+			float numLights = float(cluster.count);
 			float totalPointLightEffect = 0.0;
-			for(int i = 0; i < numPointLights; i++){
-				vec3 pointLightDir = position.xyz - pointLightPositions[i].xyz;
+			//Only the lights binned into this pixel's cluster
+			for(uint lightIndex = 0u; lightIndex < cluster.count; lightIndex++){
+				uint i = lightIndices[cluster.offset + lightIndex];
+				vec3 pointLightDir = position.xyz - pointLights[i].positionRange.xyz;
 				float distanceFromLight = length(pointLightDir);
 				float bias = 0.1; 
-				if(distanceFromLight < pointLightRanges[i]){
+				if(distanceFromLight < pointLights[i].positionRange.w){
 					vec3 pointLightDirNorm = normalize(-pointLightDir);
-					pointLighting += (dot(pointLightDirNorm, normalizedNormal)) * (1.0 - (distanceFromLight/(pointLightRanges[i]))) * pointLightColors[i];
-					totalPointLightEffect += dot(pointLightDirNorm, normalizedNormal) * (1.0 - (distanceFromLight/(pointLightRanges[i])));
+					pointLighting += (dot(pointLightDirNorm, normalizedNormal)) * (1.0 - (distanceFromLight/(pointLights[i].positionRange.w))) * pointLights[i].color.rgb;
+					totalPointLightEffect += dot(pointLightDirNorm, normalizedNormal) * (1.0 - (distanceFromLight/(pointLights[i].positionRange.w)));
 					
-					vec3 cubeMapTexCoords = (viewToModelMatrix * vec4(position.xyz,1.0)).xyz - (viewToModelMatrix * vec4(pointLightPositions[i].xyz, 1.0)).xyz;
+					vec3 cubeMapTexCoords = (inverseView * vec4(position.xyz,1.0)).xyz - (inverseView * vec4(pointLights[i].positionRange.xyz, 1.0)).xyz;
 					float distance = length(cubeMapTexCoords);
-					float cubeDepth = texture(depthMap, normalize(cubeMapTexCoords.xyz)).x*pointLightRanges[i];
+					float cubeDepth = texture(depthMap, normalize(cubeMapTexCoords.xyz)).x*pointLights[i].positionRange.w;
 					
 					if(cubeDepth + bias < distance){
 						//pointShadow -= ((1.0 - pointLightShadowEffect)/numLights)*(1.0 - (distance/cubeDepth));
@@ -165,11 +202,11 @@ void main(){
 		fragColor = vec4(occlusion, occlusion, occlusion, 1.0); 
 	}
 	else if(views == 5){
-		float depth = texture(mapDepthTexture, textureCoordinateOut).x;
+		float depth = texture(shadowCascades, vec3(textureCoordinateOut, 2.0)).x;
 		fragColor = vec4(depth, depth, depth, 1.0);
 	}
 	else if(views == 6){
-		vec3 cubeMapTexCoords = (viewToModelMatrix * vec4(position.xyz,1.0)).xyz - (viewToModelMatrix * vec4(pointLightPositions[0].xyz, 1.0)).xyz;
+		vec3 cubeMapTexCoords = (inverseView * vec4(position.xyz,1.0)).xyz - (inverseView * vec4(pointLights[0].positionRange.xyz, 1.0)).xyz;
 		float cubeDepth = texture(depthMap, normalize(cubeMapTexCoords.xyz)).x;
 		fragColor = vec4(vec3(cubeDepth), 1.0);
 	}
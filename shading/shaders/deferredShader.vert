@@ -4,8 +4,14 @@ layout(location = 0) in vec3 vertexIn;
 layout(location = 1) in vec2 textureCoordinateIn;
 out vec2 textureCoordinateOut; // Passthrough
 out vec3 vsViewDirection;
-uniform mat4 inverseView;		 // View/Camera transformation matrix
-uniform mat4 inverseProjection; // Projection transformation matrix
+layout(std140, row_major) uniform ViewConstants {
+	mat4 view;              // View/Camera transformation matrix
+	mat4 projection;        // Projection transformation matrix
+	mat4 normal;            // Normal matrix
+	mat4 inverseView;       // Camera view space back to world space
+	mat4 inverseProjection; // Clip space back to camera view space
+	vec4 planes;            // Near and far plane distances
+};
 
 void main(){
 
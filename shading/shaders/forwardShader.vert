@@ -9,9 +9,14 @@ out vec2 textureCoordinateOut; // Passthrough
 out vec4 positionOut;          // Passthrough for deferred shadow rendering
 
 uniform mat4 model;		 // Model and World transformation matrix
-uniform mat4 view;		 // View/Camera transformation matrix
-uniform mat4 projection; // Projection transformation matrix
-uniform mat4 normal;     // Normal matrix
+layout(std140, row_major) uniform ViewConstants {
+	mat4 view;              // View/Camera transformation matrix
+	mat4 projection;        // Projection transformation matrix
+	mat4 normal;            // Normal matrix
+	mat4 inverseView;       // Camera view space back to world space
+	mat4 inverseProjection; // Clip space back to camera view space
+	vec4 planes;            // Near and far plane distances
+};
 
 void main(){
 
@@ -9,11 +9,18 @@ out vec2 textureCoordinateOut; // Passthrough
 out vec4 positionOut;          // Passthrough for deferred shadow rendering
 
 uniform mat4 model;		 // Model and World transformation matrix
-uniform mat4 view;		 // View/Camera transformation matrix
-uniform mat4 projection; // Projection transformation matrix
-uniform mat4 normal;     // Normal matrix
+layout(std140, row_major) uniform ViewConstants {
+	mat4 view;              // View/Camera transformation matrix
+	mat4 projection;        // Projection transformation matrix
+	mat4 normal;            // Normal matrix
+	mat4 inverseView;       // Camera view space back to world space
+	mat4 inverseProjection; // Clip space back to camera view space
+	vec4 planes;            // Near and far plane distances
+};
 
-uniform vec3 offsets[300];
+uniform samplerBuffer instanceTransforms; // Row major 4x4 world transform per instance, one row per texel
+
+layout(location = 3) in uint instanceIndexIn; // Index of the visible instance being drawn
 
 void main(){
 
@@ -23,13 +30,19 @@ void main(){
 	// The order in which transformation matrices affect the vertex
 	// is in the order from right to left
 	vec4 vertexWorldSpace = model * vec4(vertexIn.xyz, 1.0);
-	//offset draw array instance
-	vec4 vertexOffset = vec4(vertexWorldSpace.x + offsets[gl_InstanceID].x, vertexWorldSpace.y + offsets[gl_InstanceID].y, vertexWorldSpace.z + offsets[gl_InstanceID].z, 1.0);
+	//Rows are stored as texels so building the matrix from them gives the transpose
+	int row = int(instanceIndexIn) * 4;
+	mat4 instanceTransform = transpose(mat4(texelFetch(instanceTransforms, row),
+	                                        texelFetch(instanceTransforms, row + 1),
+	                                        texelFetch(instanceTransforms, row + 2),
+	                                        texelFetch(instanceTransforms, row + 3)));
+	//Place this instance in the world
+	vec4 vertexOffset = instanceTransform * vertexWorldSpace;
 	vec4 transformedVert = projection * view * vertexOffset; 
 	
 	positionOut = view * model * vertexOffset; //store only in model space so deferred shadow rendering is done properly
 
-	normalOut = vec3((normal * vec4(normalIn, 0.0)).xyz); //Transform normal coordinate in with the normal matrix
+	normalOut = vec3((normal * instanceTransform * vec4(normalIn, 0.0)).xyz); //Transform normal coordinate in with the normal matrix
 	
 	textureCoordinateOut = textureCoordinateIn; //Passthrough
 	
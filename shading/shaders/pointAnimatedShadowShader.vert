@@ -8,6 +8,9 @@ layout(location = 4) in vec4 weights2;              // Second 4 bone weights
 
 uniform mat4 view;		 // View transformation matrix
 uniform mat4 model;		 // Model and World transformation matrix
+uniform mat4 shadowMatrix; // Projection and view of the cube face being drawn
+
+out vec4 FragPos; // World position for the light distance in the fragment shader
 
 uniform mat4 bones[150]; // 150 maximum bones for an animation
 
@@ -21,6 +24,7 @@ void main(){
 	// is in the order from right to left
 	vec4 transformedVert = model * animationTransform * vec4(vertexIn.xyz, 1.0); 
 	
-	//Pass the transformed vertex to the fragment shader
-	gl_Position = transformedVert; 
+	//Pass the world position to the fragment shader and project into the face
+	FragPos = transformedVert;
+	gl_Position = shadowMatrix * transformedVert; 
 }
\ No newline at end of file
@@ -4,6 +4,9 @@ layout(location = 0) in vec3 vertexIn;			   // Each vertex supplied
 
 uniform mat4 view;		 // View transformation matrix
 uniform mat4 model;		 // Model and World transformation matrix
+uniform mat4 shadowMatrix; // Projection and view of the cube face being drawn
+
+out vec4 FragPos; // World position for the light distance in the fragment shader
 
 void main(){
 	// The vertex is first transformed by the model and world, then 
@@ -12,6 +15,7 @@ void main(){
 	// is in the order from right to left
 	vec4 transformedVert = model * vec4(vertexIn.xyz, 1.0); 
 	
-	//Pass the transformed vertex to the fragment shader
-	gl_Position = transformedVert; 
+	//Pass the world position to the fragment shader and project into the face
+	FragPos = transformedVert;
+	gl_Position = shadowMatrix * transformedVert; 
 }
\ No newline at end of file
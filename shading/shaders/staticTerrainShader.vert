@@ -1,19 +1,29 @@
-#version 330
+#version 430
 
 layout(location = 0) in vec3 vertexIn; // Each vertex supplied
 layout(location = 1) in vec3 normalIn; // Each normal supplied
+layout(location = 4) in uint drawIndex;  // Index of the draw, offset by the base instance of each indirect command
 
 out vec3 normalOut;
 out vec3 texOut;
 out vec3 positionOut;
 out vec2 texCoordOut;
 
-uniform mat4 model;      // Model and World transformation matrix
-uniform mat4 view;       // View/Camera transformation matrix
-uniform mat4 projection; // Projection transformation matrix
-uniform mat4 normal;     // Normal matrix
+layout(std430, binding = 3, row_major) readonly buffer DrawConstants {
+	mat4 drawModels[]; // Model and World transformation matrix of every draw in the multi draw
+};
+layout(std140, row_major) uniform ViewConstants {
+	mat4 view;              // View/Camera transformation matrix
+	mat4 projection;        // Projection transformation matrix
+	mat4 normal;            // Normal matrix
+	mat4 inverseView;       // Camera view space back to world space
+	mat4 inverseProjection; // Clip space back to camera view space
+	vec4 planes;            // Near and far plane distances
+};
 
 void main(){
+	mat4 model = drawModels[drawIndex];
+
     vec4 posWorld = vec4(vertexIn.xyz, 1.0);
 
     positionOut = vec3(view * model * vec4(vertexIn.xyz, 1.0));
@@ -5,6 +5,12 @@ AnimationShader::AnimationShader(std::string shaderName) : StaticShader(shaderNa
 	//Grab uniforms needed in a staticshader
 
     //glUniform mat4 combined model and world matrix
+    _modelLocation = glGetUniformLocation(_shaderContext, "model");
+
+    //glUniform texture map sampler location
+    _textureLocation = glGetUniformLocation(_shaderContext, "textureMap");
+
+    //glUniform mat4 bone transforms
     _bonesLocation = glGetUniformLocation(_shaderContext, "bones");
 }
 
@@ -26,15 +32,6 @@ void AnimationShader::runShader(Model* modelIn) {
     //glUniform mat4 combined model and world matrix, GL_TRUE is telling GL we are passing in the matrix as row major
     glUniformMatrix4fv(_modelLocation, 1, GL_TRUE, mvp->getModelBuffer());
 
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_viewLocation, 1, GL_TRUE, mvp->getViewBuffer());
-
-    //glUniform mat4 projection matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_projectionLocation, 1, GL_TRUE, mvp->getProjectionBuffer());
-
-    //glUniform mat4 normal matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_normalLocation, 1, GL_TRUE, mvp->getNormalBuffer());
-
     //Bone uniforms
     auto bones = model->getBones();
     float* bonesArray = new float[ 16 * bones->size() ]; //4x4 times number of bones
@@ -49,12 +46,14 @@ void AnimationShader::runShader(Model* modelIn) {
     delete [] bonesArray;
 
     //Grab strides of vertex sets that have a single texture associated with them
-    auto textureStrides = model->getTextureStrides();
+    auto& textureStrides = model->getTextureStrides();
     unsigned int strideLocation = 0;
-    for(auto textureStride : textureStrides) {
+    for (int stride = 0; stride < static_cast<int>(textureStrides.size()); stride++) {
+
+        auto& textureStride = textureStrides[stride];
 
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, model->getTexture(textureStride.first)->getContext()); //grab first texture of model and return context
+        glBindTexture(GL_TEXTURE_2D, model->getStrideTexture(stride)->getContext()); //grab first texture of model and return context
         //glUniform texture
         //The second parameter has to be equal to GL_TEXTURE(X) so X must be 0 because we activated texture GL_TEXTURE0 two calls before
         glUniform1i(_textureLocation, 0);
@@ -62,22 +62,9 @@ DeferredShader::DeferredShader(std::string shaderName) : Shader(shaderName) {
     _diffuseTextureLocation = glGetUniformLocation(_shaderContext, "diffuseTexture");
     _normalTextureLocation = glGetUniformLocation(_shaderContext, "normalTexture");
     _positionTextureLocation = glGetUniformLocation(_shaderContext, "positionTexture");
-    _cameraDepthTextureLocation = glGetUniformLocation(_shaderContext, "cameraDepthTexture");
-    _mapDepthTextureLocation = glGetUniformLocation(_shaderContext, "mapDepthTexture");
-    _lightLocation = glGetUniformLocation(_shaderContext, "light");
-    _lightViewLocation = glGetUniformLocation(_shaderContext, "lightViewMatrix");
-    _lightMapViewLocation = glGetUniformLocation(_shaderContext, "lightMapViewMatrix");
-    _viewsLocation = glGetUniformLocation(_shaderContext, "views");
-    _pointLightCountLocation = glGetUniformLocation(_shaderContext, "numPointLights");
-    _pointLightColorsLocation = glGetUniformLocation(_shaderContext, "pointLightColors");
-    _pointLightRangesLocation = glGetUniformLocation(_shaderContext, "pointLightRanges");
-    _pointLightPositionsLocation = glGetUniformLocation(_shaderContext, "pointLightPositions");
+    _shadowCascadesLocation = glGetUniformLocation(_shaderContext, "shadowCascades");
     _pointLightDepthMapLocation = glGetUniformLocation(_shaderContext, "depthMap");
-    _viewToModelSpaceMatrixLocation = glGetUniformLocation(_shaderContext, "viewToModelMatrix");
-    _farPlaneLocation = glGetUniformLocation(_shaderContext, "farPlane");
 
-    _inverseViewLocation = glGetUniformLocation(_shaderContext, "inverseView");
-    _inverseProjectionLocation = glGetUniformLocation(_shaderContext, "inverseProjection");
     _skyboxDayTextureLocation = glGetUniformLocation(_shaderContext, "skyboxDayTexture");
     _skyboxNightTextureLocation = glGetUniformLocation(_shaderContext, "skyboxNightTexture");
     _ssaoTextureLocation = glGetUniformLocation(_shaderContext, "ssaoTexture");
@@ -111,80 +98,7 @@ void DeferredShader::runShader(ShadowRenderer* shadowRenderer,
 
     glBindVertexArray(_vaoContext);
 
-    //Get light view matrix "look at" vector which is located in the third column
-    //of the inner rotation matrix at index 2,6,10
-    auto viewMatrix = lights[0]->getLightMVP().getViewBuffer();
-    glUniform3f(_lightLocation, viewMatrix[2], viewMatrix[6], viewMatrix[10]);
-
-    //Get point light positions
-    //TODO add max point light constant
-    unsigned int pointLights = 0;
-    for (auto& light : lights) {
-        if (light->getType() == LightType::POINT) {
-            pointLights++;
-        }
-    }
-    float* lightPosArray = new float[3 * pointLights];
-    float* lightColorsArray = new float[3 * pointLights];
-    float* lightRangesArray = new float[pointLights];
-    int lightArrayIndex = 0;
-    int lightRangeIndex = 0;
-    for (auto& light : lights) {
-        //If point light then add to uniforms
-        if (light->getType() == LightType::POINT) {
-            //Point lights need to remain stationary so move lights with camera space changes
-            auto pos = viewManager->getView() * light->getPosition();
-            float* posBuff = pos.getFlatBuffer();
-            float* colorBuff = light->getColor().getFlatBuffer();
-            for (int i = 0; i < 3; i++) {
-                lightPosArray[lightArrayIndex] = posBuff[i];
-                lightColorsArray[lightArrayIndex] = colorBuff[i];
-                lightArrayIndex++;
-            }
-            lightRangesArray[lightRangeIndex++] = light->getRange();
-        }
-    }
-    glUniform1i(_pointLightCountLocation, static_cast<GLsizei>(pointLights));
-    glUniform3fv(_pointLightPositionsLocation, static_cast<GLsizei>(pointLights), lightPosArray);
-    glUniform3fv(_pointLightColorsLocation, static_cast<GLsizei>(pointLights), lightColorsArray);
-    glUniform1fv(_pointLightRangesLocation, static_cast<GLsizei>(pointLights), lightRangesArray);
-    delete [] lightPosArray;  delete [] lightColorsArray; delete[] lightRangesArray;
-
-    //Change of basis from camera view position back to world position
-    MVP lightMVP = lights[0]->getLightMVP();
-    Matrix cameraToLightSpace = lightMVP.getProjectionMatrix() *
-        lightMVP.getViewMatrix() *
-        viewManager->getView().inverse();
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_lightViewLocation, 1, GL_TRUE, cameraToLightSpace.getFlatBuffer());
-
-    //Change of basis from camera view position back to world position
-    MVP lightMapMVP = lights[1]->getLightMVP();
-    Matrix cameraToLightMapSpace = lightMapMVP.getProjectionMatrix() *
-        lightMapMVP.getViewMatrix() *
-        viewManager->getView().inverse();
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_lightMapViewLocation, 1, GL_TRUE, cameraToLightMapSpace.getFlatBuffer());
-
-    //Change of basis from camera view position back to world position
-    Matrix viewToModelSpace = viewManager->getView().inverse();
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_viewToModelSpaceMatrixLocation, 1, GL_TRUE, viewToModelSpace.getFlatBuffer());
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_inverseViewLocation, 1, GL_TRUE, viewManager->getView().inverse().getFlatBuffer());
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_inverseProjectionLocation, 1, GL_TRUE, viewManager->getProjection().inverse().getFlatBuffer());
-
-    glUniform1i(_viewsLocation, static_cast<GLint>(viewManager->getViewState()));
-
-    auto projMatrix = viewManager->getProjection().getFlatBuffer();
-    float nearVal = (2.0f*projMatrix[11]) / (2.0f*projMatrix[10] - 2.0f);
-    float farVal = ((projMatrix[10] - 1.0f)*nearVal) / (projMatrix[10] + 1.0f);
-    glUniform1f(_farPlaneLocation, farVal);
+    //Lights, view and frame constants come from the uniform blocks written once per frame
 
     auto textures = mrtFBO.getTextureContexts();
 
@@ -192,8 +106,7 @@ void DeferredShader::runShader(ShadowRenderer* shadowRenderer,
     glUniform1i(_diffuseTextureLocation, 0);
     glUniform1i(_normalTextureLocation, 1);
     glUniform1i(_positionTextureLocation, 2);
-    glUniform1i(_cameraDepthTextureLocation, 3);
-    glUniform1i(_mapDepthTextureLocation, 4);
+    glUniform1i(_shadowCascadesLocation, 3);
     glUniform1i(_pointLightDepthMapLocation, 5);
     glUniform1i(_skyboxDayTextureLocation, 6);
     glUniform1i(_skyboxNightTextureLocation, 7);
@@ -212,14 +125,9 @@ void DeferredShader::runShader(ShadowRenderer* shadowRenderer,
     glActiveTexture(GL_TEXTURE2);
     glBindTexture(GL_TEXTURE_2D, textures[2]);
 
-    //Depth texture
+    //Sun shadow cascades
     glActiveTexture(GL_TEXTURE3);
-    /*glBindTexture(GL_TEXTURE_2D, shadowRenderer->getAnimatedDepthTexture());*/
-    glBindTexture(GL_TEXTURE_2D, shadowRenderer->getStaticDepthTexture());
-
-    //Depth texture
-    glActiveTexture(GL_TEXTURE4);
-    glBindTexture(GL_TEXTURE_2D, shadowRenderer->getMapDepthTexture());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, shadowRenderer->getCascadeTexture());
 
     //Depth cube texture map for point lights
     glActiveTexture(GL_TEXTURE5);
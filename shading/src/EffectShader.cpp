@@ -162,7 +162,7 @@ void EffectShader::runShader(Effect* effectObject, float seconds) {
         auto projection = cameraMVP.getProjectionMatrix();
         glUniformMatrix4fv(_projectionLocation, 1, GL_TRUE, projection.getFlatBuffer());
 
-        auto normalMatrix = modelView.inverse().transpose();
+        auto normalMatrix = modelView.normalMatrix();
         //glUniform mat4 normal matrix, GL_TRUE is telling GL we are passing in the matrix as row major
         glUniformMatrix4fv(_normalLocation, 1, GL_TRUE, normalMatrix.getFlatBuffer());
 
@@ -58,15 +58,18 @@ void EnvironmentShader::runShader(Model* model, std::vector<Matrix> viewTransfor
     glUniformMatrix4fv(_cubeTransformsLocation, 6, GL_TRUE, lightCubeTransforms);
     delete[] lightCubeTransforms;
 
-    auto textureStrides = model->getTextureStrides();
-    unsigned int strideLocation = 0;
-    for(auto textureStride : textureStrides) {
+    //The model's vertices start at its base vertex in the shared buffers
+    auto& textureStrides = model->getTextureStrides();
+    unsigned int strideLocation = vao->getBaseVertex();
+    for (int stride = 0; stride < static_cast<int>(textureStrides.size()); stride++) {
 
-        //If the texture has layered encoded into the string then it is indeed layered
-        if (textureStride.first.substr(0, 7) == "Layered") {
+        auto& textureStride = textureStrides[stride];
 
-            LayeredTexture* layeredTexture = model->getLayeredTexture(textureStride.first);
-            auto textures = layeredTexture->getTextures();
+        //Layered strides sample several textures blended by the alpha map
+        if (model->isLayeredStride(stride)) {
+
+            LayeredTexture* layeredTexture = model->getStrideLayeredTexture(stride);
+            auto& textures = layeredTexture->getTextures();
 
             //We have a layered texture
             glUniform1i(_layeredSwitchLocation, 1);
@@ -114,12 +117,12 @@ void EnvironmentShader::runShader(Model* model, std::vector<Matrix> viewTransfor
         else {
             //If triangle's textures supports transparency then do NOT draw
             //Transparent objects will be rendered after the deferred lighting pass
-            if (!model->getTexture(textureStride.first)->getTransparency()) {
+            if (!model->getStrideTexture(stride)->getTransparency()) {
                 //Not layered texture
                 glUniform1i(_layeredSwitchLocation, 0);
 
                 glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, model->getTexture(textureStride.first)->getContext()); //grab first texture of model and return context
+                glBindTexture(GL_TEXTURE_2D, model->getStrideTexture(stride)->getContext()); //grab first texture of model and return context
                 //glUniform texture
                 //The second parameter has to be equal to GL_TEXTURE(X) so X must be 0 because we activated texture GL_TEXTURE0 two calls before
                 glUniform1i(_textureLocation, 0);
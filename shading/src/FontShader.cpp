@@ -5,16 +5,18 @@
 FontShader::FontShader(std::string shaderName) : Shader(shaderName)
 {
     _textureLocation = glGetUniformLocation(_shaderContext, "tex");
+
+    //Loaded once here so drawing text never looks the texture up by name
+    _fontTexture = TextureBroker::instance()->addTexture("../assets/textures/font/ubuntu_mono_regular_0.png");
 }
 
 FontShader::~FontShader()
 {
 }
 
-void FontShader::runShader(GLuint vao, std::string& s)
+void FontShader::runShader(GLuint vao, GLint firstVertex, GLsizei vertexCount)
 {
-    TextureBroker* pTb = TextureBroker::instance();
-    Texture* tex = pTb->getTexture("../assets/textures/font/ubuntu_mono_regular_0.png");
+    Texture* tex = TextureBroker::instance()->getTexture(_fontTexture);
 
     //glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
@@ -34,7 +36,7 @@ void FontShader::runShader(GLuint vao, std::string& s)
     glCheck();
 
     glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, 6 * static_cast<GLsizei>(s.size()));
+    glDrawArrays(GL_TRIANGLES, firstVertex, vertexCount);
     glCheck();
 
     glDisable(GL_BLEND);
@@ -0,0 +1,43 @@
+#include "InstanceCullShader.h"
+#include "InstanceBuffer.h"
+#include <algorithm>
+
+InstanceCullShader::InstanceCullShader() : Shader("instanceCullShader") {
+
+    _boundsTransformLocation = glGetUniformLocation(_shaderContext, "boundsTransform");
+    _planesLocation = glGetUniformLocation(_shaderContext, "planes");
+    _instanceCountLocation = glGetUniformLocation(_shaderContext, "instanceCount");
+    _commandCountLocation = glGetUniformLocation(_shaderContext, "commandCount");
+}
+
+InstanceCullShader::~InstanceCullShader() {
+
+}
+
+void InstanceCullShader::runShader(InstanceBuffer* instanceBuffer, Matrix boundsTransform, const Frustum& frustum,
+                                   GLuint instanceCount, GLuint commandCount) {
+
+    glUseProgram(_shaderContext);
+
+    //Planes are packed back to back in the order of FrustumPlane
+    float planes[FRUSTUM_PLANES * 4];
+    for (int plane = 0; plane < FRUSTUM_PLANES; plane++) {
+        const float* values = frustum.getPlane(static_cast<FrustumPlane>(plane));
+        std::copy(values, values + 4, &planes[plane * 4]);
+    }
+    glUniform4fv(_planesLocation, FRUSTUM_PLANES, planes);
+    glUniformMatrix4fv(_boundsTransformLocation, 1, GL_TRUE, boundsTransform.getFlatBuffer());
+    glUniform1ui(_instanceCountLocation, instanceCount);
+    glUniform1ui(_commandCountLocation, commandCount);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_TRANSFORMS_BINDING, instanceBuffer->getTransformBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_INSTANCES_BINDING, instanceBuffer->getCulledBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CULL_COMMANDS_BINDING, instanceBuffer->getCommandBuffer());
+
+    glDispatchCompute((instanceCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+    //The indices are read as a vertex attribute and the counts as indirect draw parameters
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    glUseProgram(0);
+}
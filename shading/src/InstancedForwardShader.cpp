@@ -6,156 +6,191 @@
 #include "ViewManager.h"
 #include "ShadowRenderer.h"
 #include "PointShadowMap.h"
+#include "BatchMath.h"
+#include <algorithm>
+#include <iterator>
+#include <iostream>
 
-InstancedForwardShader::InstancedForwardShader(std::string shaderName) : ForwardShader(shaderName, "forwardShader") {
+InstancedForwardShader::InstancedForwardShader(std::string shaderName) : ForwardShader(shaderName, "forwardShader"),
+    _cullShader() {
 
-    _offsetsLocation = glGetUniformLocation(_shaderContext, "offsets");
+    _instanceTransformsLocation = glGetUniformLocation(_shaderContext, "instanceTransforms");
 }
 InstancedForwardShader::~InstancedForwardShader() {
 
 }
 
 void InstancedForwardShader::runShader(Model* model, ViewManager* viewManager, ShadowRenderer* shadowRenderer,
-        std::vector<Light*>& lights, PointShadowMap* pointShadowMap) {
+        std::vector<Light*>& lights, PointShadowMap* pointShadowMap, const OcclusionBuffer* occlusionBuffer) {
+
+    //Do not support animated models with transparency for now
+    if (model->getClassType() == ModelClass::AnimatedModelType) {
+        return;
+    }
+
+    //One draw per transparent stride, the model's vertices start at its base vertex in the shared buffers
+    VAO* vao = model->getVAO();
+    auto& textureStrides = model->getTextureStrides();
+    unsigned int strideLocation = vao->getBaseVertex();
+    _commands.clear();
+    _commandStrides.clear();
+    for (int stride = 0; stride < static_cast<int>(textureStrides.size()); stride++) {
+
+        //Do not support layered textures and only transparent objects are rendered here
+        if (!model->isLayeredStride(stride) && model->getStrideTexture(stride)->getTransparency()) {
+            DrawArraysIndirectCommand command = { static_cast<GLuint>(textureStrides[stride].second), 0, strideLocation, 0 };
+            _commands.push_back(command);
+            _commandStrides.push_back(stride);
+        }
+        strideLocation += textureStrides[stride].second;
+    }
+    if (_commands.empty()) {
+        return;
+    }
+
+    //Send the transforms that changed since the last frame, both culls read them from the gpu copy
+    InstanceBuffer* instanceBuffer = model->getInstanceBuffer();
+    std::vector<Matrix>& transforms = model->getInstanceTransforms();
+    instanceBuffer->uploadTransforms(transforms);
+
+    //Only the instances inside the camera frustum get drawn.  The occlusion buffer lives on the cpu so
+    //while it holds occluders the cpu cull runs instead to drop the instances they hide as well
+    Frustum frustum(viewManager->getProjection() * viewManager->getView());
+    const bool gpuCull = INSTANCE_GPU_CULLING && (occlusionBuffer == nullptr || !occlusionBuffer->hasOccluders());
+    if (gpuCull) {
+        //The visible count is written straight into the draws so nothing waits on the gpu here
+        instanceBuffer->prepareCulled(transforms.size(), _commands);
+        _cullShader.runShader(instanceBuffer, model->getBoundsTransform(), frustum,
+                              static_cast<GLuint>(transforms.size()), static_cast<GLuint>(_commands.size()));
+#if defined(GPU_CULL_VERIFY)
+        _verifyCulling(model, frustum, occlusionBuffer);
+#endif
+    }
+    else {
+        GLsizei visibleInstances = _cullInstances(model, frustum, occlusionBuffer);
+        if (visibleInstances == 0) {
+            return;
+        }
+        //The base instance offsets the visible index attribute to this frame's slice of the stream buffer
+        GLuint baseInstance = instanceBuffer->uploadVisible(_visibleInstances);
+        for (DrawArraysIndirectCommand& command : _commands) {
+            command.instanceCount = visibleInstances;
+            command.baseInstance = baseInstance;
+        }
+    }
 
     //LOAD IN SHADER
     glUseProgram(_shaderContext); //use context for loaded shader
 
     //LOAD IN VAO
-    VAO* vao = model->getVAO();
     glBindVertexArray(vao->getVAOContext());
 
     MVP* mvp = model->getMVP();
     //glUniform mat4 combined model and world matrix, GL_TRUE is telling GL we are passing in the matrix as row major
     glUniformMatrix4fv(_modelLocation, 1, GL_TRUE, mvp->getModelBuffer());
 
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_viewLocation, 1, GL_TRUE, mvp->getViewBuffer());
-
-    //glUniform mat4 projection matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_projectionLocation, 1, GL_TRUE, mvp->getProjectionBuffer());
+    //View, projection, normal and light constants come from the uniform blocks written once per frame
 
-    //glUniform mat4 normal matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_normalLocation, 1, GL_TRUE, mvp->getNormalBuffer());
+    //glUniform texture
+    //The second parameter has to be equal to GL_TEXTURE(X) so X must be 0 because we activated texture GL_TEXTURE0 two calls before
+    glUniform1i(_textureLocation, 0);
+    glUniform1i(_shadowCascadesLocation, 1);
+    glUniform1i(_pointLightDepthMapLocation, 3);
+    glUniform1i(_instanceTransformsLocation, 4);
 
-    auto projMatrix = viewManager->getProjection().getFlatBuffer();
-    float nearVal = (2.0f*projMatrix[11]) / (2.0f*projMatrix[10] - 2.0f);
-    float farVal = ((projMatrix[10] - 1.0f)*nearVal) / (projMatrix[10] + 1.0f);
-    glUniform1f(_farPlaneLocation, farVal);
+    //Sun shadow cascades
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, shadowRenderer->getCascadeTexture());
 
+    //Depth cube texture map for point lights
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, pointShadowMap->getCubeMapTexture());
 
-    //Get light view matrix "look at" vector which is located in the third column
-    //of the inner rotation matrix at index 2,6,10
-    auto viewMatrix = lights[0]->getLightMVP().getViewBuffer();
-    glUniform3f(_lightLocation, viewMatrix[2], viewMatrix[6], viewMatrix[10]);
+    //Instance transforms read with texelFetch
+    glActiveTexture(GL_TEXTURE4);
+    glBindTexture(GL_TEXTURE_BUFFER, instanceBuffer->getTransformTexture());
 
-    //Get point light positions
-    //TODO add max point light constant
-    unsigned int pointLights = 0;
-    for (auto& light : lights) {
-        if (light->getType() == LightType::POINT) {
-            pointLights++;
-        }
-    }
-    float* lightPosArray = new float[3 * pointLights];
-    float* lightColorsArray = new float[3 * pointLights];
-    float* lightRangesArray = new float[pointLights];
-    int lightArrayIndex = 0;
-    int lightRangeIndex = 0;
-    for (auto& light : lights) {
-        //If point light then add to uniforms
-        if (light->getType() == LightType::POINT) {
-            //Point lights need to remain stationary so move lights with camera space changes
-            auto pos = viewManager->getView() * light->getPosition();
-            float* posBuff = pos.getFlatBuffer();
-            float* colorBuff = light->getColor().getFlatBuffer();
-            for (int i = 0; i < 3; i++) {
-                lightPosArray[lightArrayIndex] = posBuff[i];
-                lightColorsArray[lightArrayIndex] = colorBuff[i];
-                lightArrayIndex++;
-            }
-            lightRangesArray[lightRangeIndex++] = light->getRange();
-        }
+    if (gpuCull) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, instanceBuffer->getCommandBuffer());
     }
-    glUniform1i(_pointLightCountLocation, static_cast<GLsizei>(pointLights));
-    glUniform3fv(_pointLightPositionsLocation, static_cast<GLsizei>(pointLights), lightPosArray);
-    glUniform3fv(_pointLightColorsLocation, static_cast<GLsizei>(pointLights), lightColorsArray);
-    glUniform1fv(_pointLightRangesLocation, static_cast<GLsizei>(pointLights), lightRangesArray);
-    delete[] lightPosArray;  delete[] lightColorsArray; delete[] lightRangesArray;
-
-    //instance array offsets
-    glUniform3fv(_offsetsLocation, static_cast<GLsizei>(300), model->getInstanceOffsets());
-
-    //Change of basis from camera view position back to world position
-    MVP lightMVP = lights[0]->getLightMVP();
-    Matrix cameraToLightSpace = lightMVP.getProjectionMatrix() *
-        lightMVP.getViewMatrix() *
-        viewManager->getView().inverse();
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_lightViewLocation, 1, GL_TRUE, cameraToLightSpace.getFlatBuffer());
-
-    //Change of basis from camera view position back to world position
-    MVP lightMapMVP = lights[1]->getLightMVP();
-    Matrix cameraToLightMapSpace = lightMapMVP.getProjectionMatrix() *
-        lightMapMVP.getViewMatrix() *
-        viewManager->getView().inverse();
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_lightMapViewLocation, 1, GL_TRUE, cameraToLightMapSpace.getFlatBuffer());
 
-    //Change of basis from camera view position back to world position
-    Matrix viewToModelSpace = viewManager->getView().inverse();
+    for (size_t i = 0; i < _commands.size(); i++) {
 
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_viewToModelSpaceMatrixLocation, 1, GL_TRUE, viewToModelSpace.getFlatBuffer());
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, model->getStrideTexture(_commandStrides[i])->getContext()); //grab first texture of model and return context
 
-    glUniform1i(_viewsLocation, static_cast<GLint>(viewManager->getViewState()));
-
-
-    auto textureStrides = model->getTextureStrides();
-    unsigned int strideLocation = 0;
-    for (auto textureStride : textureStrides) {
-
-        //Do not support layered textures or animated models with transparency for now
-        if (textureStride.first.substr(0, 7) != "Layered" && model->getClassType() != ModelClass::AnimatedModelType) {
-
-            //If triangle's textures supports transparency then DO DRAW
-            //Only transparent objects are rendered here
-            if (model->getTexture(textureStride.first)->getTransparency()) {
-
-                //glUniform texture
-                //The second parameter has to be equal to GL_TEXTURE(X) so X must be 0 because we activated texture GL_TEXTURE0 two calls before
-                glUniform1i(_textureLocation, 0);
-                glUniform1i(_cameraDepthTextureLocation, 1);
-                glUniform1i(_mapDepthTextureLocation, 2);
-                glUniform1i(_pointLightDepthMapLocation, 3);
-
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, model->getTexture(textureStride.first)->getContext()); //grab first texture of model and return context
+        if (gpuCull) {
+            //Vertex range and visible instance count come from the command the cull filled in
+            glDrawArraysIndirect(GL_TRIANGLES, reinterpret_cast<const void*>(i * sizeof(DrawArraysIndirectCommand)));
+        }
+        else {
+            const DrawArraysIndirectCommand& command = _commands[i];
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, command.first, command.count,
+                                              command.instanceCount, command.baseInstance);
+        }
+    }
 
-                                                                                                    //Depth texture
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, shadowRenderer->getAnimatedDepthTexture());
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE4);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0); //Unbind texture
+    glUseProgram(0);//end using this shader
+}
 
-                //Depth texture
-                glActiveTexture(GL_TEXTURE2);
-                glBindTexture(GL_TEXTURE_2D, shadowRenderer->getMapDepthTexture());
+GLsizei InstancedForwardShader::_cullInstances(Model* model, const Frustum& frustum, const OcclusionBuffer* occlusionBuffer) {
 
-                //Depth cube texture map for point lights
-                glActiveTexture(GL_TEXTURE3);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, pointShadowMap->getCubeMapTexture());
+    std::vector<Matrix>& transforms = model->getInstanceTransforms();
+    size_t instances = transforms.size();
 
-                //Draw triangles using the bound buffer vertices at starting index 0 and number of triangles
-                //glDrawArrays(GL_TRIANGLES, strideLocation, (GLsizei)textureStride.second);
+    //Each instance's box is its transform applied to the model's world space box
+    _instanceBoxes.resize(instances);
+    _visibleMasks.resize(Frustum::maskWords(instances));
+    BatchMath::multiply(transforms.data(), model->getBoundsTransform(), _instanceBoxes.data(), instances);
+    frustum.testOBBs(_instanceBoxes.data(), instances, _visibleMasks.data());
+    if (occlusionBuffer != nullptr) {
+        occlusionBuffer->testOBBs(_instanceBoxes.data(), instances, _visibleMasks.data());
+    }
 
-                glDrawArraysInstanced(GL_TRIANGLES, strideLocation, (GLsizei)textureStride.second, 110);
-            }
+    //Compact the visible indices to the front so gl_InstanceID walks only those
+    _visibleInstances.clear();
+    for (size_t i = 0; i < instances; i++) {
+        if (_visibleMasks[i / 32] & (1u << (i % 32))) {
+            _visibleInstances.push_back(static_cast<GLuint>(i));
         }
-        strideLocation += textureStride.second;
     }
+    return static_cast<GLsizei>(_visibleInstances.size());
+}
 
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0); //Unbind texture
-    glUseProgram(0);//end using this shader
+#if defined(GPU_CULL_VERIFY)
+void InstancedForwardShader::_verifyCulling(Model* model, const Frustum& frustum, const OcclusionBuffer* occlusionBuffer) {
+
+    //Reading back stalls until the cull finishes so this only runs in verification builds
+    InstanceBuffer* instanceBuffer = model->getInstanceBuffer();
+    DrawArraysIndirectCommand command;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, instanceBuffer->getCommandBuffer());
+    glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(DrawArraysIndirectCommand), &command);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    std::vector<GLuint> gpuVisible(command.instanceCount);
+    if (command.instanceCount > 0) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, instanceBuffer->getCulledBuffer());
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, gpuVisible.size() * sizeof(GLuint), gpuVisible.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    //Threads append in any order while the cpu cull keeps instance order
+    std::sort(gpuVisible.begin(), gpuVisible.end());
+    _cullInstances(model, frustum, occlusionBuffer);
+
+    std::vector<GLuint> differences;
+    std::set_symmetric_difference(gpuVisible.begin(), gpuVisible.end(),
+                                  _visibleInstances.begin(), _visibleInstances.end(),
+                                  std::back_inserter(differences));
+    if (!differences.empty()) {
+        std::cout << "Gpu cull kept " << gpuVisible.size() << " instances and cpu cull kept "
+                  << _visibleInstances.size() << ", " << differences.size() << " differ" << std::endl;
+    }
 }
+#endif
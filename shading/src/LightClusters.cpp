@@ -0,0 +1,248 @@
+#include "LightClusters.h"
+#include "StreamBuffer.h"
+#include "ViewManager.h"
+#include "Light.h"
+#include <algorithm>
+#include <cmath>
+
+//std430 packs the light as two vec4s and the cluster as a uvec2
+static_assert(sizeof(PointLightData) == 32, "PointLightData must match its std430 struct");
+static_assert(sizeof(LightCluster) == 8, "LightCluster must match its std430 struct");
+
+LightClusters::LightClusters() :
+    _storage(new StreamBuffer(GL_SHADER_STORAGE_BUFFER, 256 * 1024)),
+    _storageAlignment(0),
+    _sliceScale(0.0f),
+    _sliceBias(0.0f),
+    _clusters(CLUSTER_COUNT) {
+
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &_storageAlignment);
+    _storageAlignment = std::max(_storageAlignment, 16);
+}
+
+LightClusters::~LightClusters() {
+    delete _storage;
+}
+
+void LightClusters::update(ViewManager* viewManager, std::vector<Light*>& lights) {
+
+    Matrix view = viewManager->getView();
+    Matrix projection = viewManager->getProjection();
+
+    //Same near and far extraction as the view constants
+    float* projMatrix = projection.getFlatBuffer();
+    float nearPlane = (2.0f*projMatrix[11]) / (2.0f*projMatrix[10] - 2.0f);
+    float farPlane = ((projMatrix[10] - 1.0f)*nearPlane) / (projMatrix[10] + 1.0f);
+
+    //Exponential slices keep clusters roughly cubic along the view direction
+    _sliceScale = CLUSTER_SLICES / std::log(farPlane / nearPlane);
+    _sliceBias = -std::log(nearPlane) * _sliceScale;
+
+    //Gather the point lights into view space
+    _lights.clear();
+    _centerX.clear();
+    _centerY.clear();
+    _depth.clear();
+    _range.clear();
+    for (auto& light : lights) {
+        if (light->getType() == LightType::POINT) {
+            Vector4 position = view * light->getPosition();
+            Vector4 color = light->getColor();
+            float* posBuff = position.getFlatBuffer();
+            float* colorBuff = color.getFlatBuffer();
+
+            PointLightData data;
+            for (int i = 0; i < 3; i++) {
+                data.positionRange[i] = posBuff[i];
+                data.color[i] = colorBuff[i];
+            }
+            data.positionRange[3] = light->getRange();
+            data.color[3] = 1.0f;
+            _lights.push_back(data);
+
+            _centerX.push_back(posBuff[0]);
+            _centerY.push_back(posBuff[1]);
+            _depth.push_back(-posBuff[2]);
+            _range.push_back(light->getRange());
+        }
+    }
+
+    //Pad to whole vectors with lights that sit behind the camera and never touch a cluster
+    size_t lightCount = _lights.size();
+    size_t paddedCount = (lightCount + 3) & ~static_cast<size_t>(3);
+    _centerX.resize(paddedCount, 0.0f);
+    _centerY.resize(paddedCount, 0.0f);
+    _depth.resize(paddedCount, -farPlane);
+    _range.resize(paddedCount, 0.0f);
+    _minX.resize(paddedCount);
+    _maxX.resize(paddedCount);
+    _minY.resize(paddedCount);
+    _maxY.resize(paddedCount);
+    _nearDepth.resize(paddedCount);
+    _farDepth.resize(paddedCount);
+
+    _computeBounds(projMatrix[0], projMatrix[5], nearPlane);
+
+    //Turn the bounds into tile and slice ranges, counting the lights of every cluster
+    std::vector<int> ranges(lightCount * 6);
+    for (auto& cluster : _clusters) {
+        cluster.count = 0;
+    }
+    for (size_t light = 0; light < lightCount; light++) {
+        int* range = &ranges[light * 6];
+        if (_farDepth[light] < nearPlane || _nearDepth[light] > farPlane ||
+            _maxX[light] < -1.0f || _minX[light] > 1.0f || _maxY[light] < -1.0f || _minY[light] > 1.0f) {
+            range[0] = 1; //Empty range, the light is outside of the frustum
+            range[1] = 0;
+            continue;
+        }
+        range[0] = std::max(static_cast<int>((_minX[light] * 0.5f + 0.5f) * CLUSTER_TILES_X), 0);
+        range[1] = std::min(static_cast<int>((_maxX[light] * 0.5f + 0.5f) * CLUSTER_TILES_X), CLUSTER_TILES_X - 1);
+        range[2] = std::max(static_cast<int>((_minY[light] * 0.5f + 0.5f) * CLUSTER_TILES_Y), 0);
+        range[3] = std::min(static_cast<int>((_maxY[light] * 0.5f + 0.5f) * CLUSTER_TILES_Y), CLUSTER_TILES_Y - 1);
+        range[4] = std::max(static_cast<int>(std::log(_nearDepth[light]) * _sliceScale + _sliceBias), 0);
+        range[5] = std::min(static_cast<int>(std::log(std::min(_farDepth[light], farPlane)) * _sliceScale + _sliceBias),
+                            CLUSTER_SLICES - 1);
+
+        for (int slice = range[4]; slice <= range[5]; slice++) {
+            for (int y = range[2]; y <= range[3]; y++) {
+                for (int x = range[0]; x <= range[1]; x++) {
+                    _clusters[x + CLUSTER_TILES_X * (y + CLUSTER_TILES_Y * slice)].count++;
+                }
+            }
+        }
+    }
+
+    //Prefix sum the counts into offsets then fill the index list in light order
+    GLuint total = 0;
+    for (auto& cluster : _clusters) {
+        cluster.offset = total;
+        total += cluster.count;
+        cluster.count = 0;
+    }
+    _indices.resize(total);
+    for (size_t light = 0; light < lightCount; light++) {
+        int* range = &ranges[light * 6];
+        if (range[0] > range[1]) {
+            continue;
+        }
+        for (int slice = range[4]; slice <= range[5]; slice++) {
+            for (int y = range[2]; y <= range[3]; y++) {
+                for (int x = range[0]; x <= range[1]; x++) {
+                    LightCluster& cluster = _clusters[x + CLUSTER_TILES_X * (y + CLUSTER_TILES_Y * slice)];
+                    _indices[cluster.offset + cluster.count++] = static_cast<GLuint>(light);
+                }
+            }
+        }
+    }
+
+    _bind(POINT_LIGHTS_BINDING, _lights.data(), _lights.size() * sizeof(PointLightData));
+    _bind(LIGHT_CLUSTERS_BINDING, _clusters.data(), _clusters.size() * sizeof(LightCluster));
+    _bind(LIGHT_INDICES_BINDING, _indices.data(), _indices.size() * sizeof(GLuint));
+}
+
+void LightClusters::_computeBounds(float scaleX, float scaleY, float nearPlane) {
+
+    //The sphere's view space box is projected at its nearest and farthest depth, x / depth is
+    //monotonic in depth so the extremes of those two cover the whole box
+    size_t count = _centerX.size();
+
+#if defined(MATH_SSE)
+    __m128 near4 = _mm_set1_ps(nearPlane);
+    __m128 scaleX4 = _mm_set1_ps(scaleX);
+    __m128 scaleY4 = _mm_set1_ps(scaleY);
+
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 centerX = _mm_loadu_ps(&_centerX[i]);
+        __m128 centerY = _mm_loadu_ps(&_centerY[i]);
+        __m128 depth = _mm_loadu_ps(&_depth[i]);
+        __m128 range = _mm_loadu_ps(&_range[i]);
+
+        __m128 nearDepth = _mm_max_ps(_mm_sub_ps(depth, range), near4);
+        __m128 farDepth = _mm_max_ps(_mm_add_ps(depth, range), near4);
+        __m128 inverseNear = _mm_div_ps(_mm_set1_ps(1.0f), nearDepth);
+        __m128 inverseFar = _mm_div_ps(_mm_set1_ps(1.0f), farDepth);
+
+        __m128 left = _mm_sub_ps(centerX, range);
+        __m128 right = _mm_add_ps(centerX, range);
+        __m128 bottom = _mm_sub_ps(centerY, range);
+        __m128 top = _mm_add_ps(centerY, range);
+
+        _mm_storeu_ps(&_minX[i], _mm_mul_ps(scaleX4, _mm_min_ps(_mm_mul_ps(left, inverseNear), _mm_mul_ps(left, inverseFar))));
+        _mm_storeu_ps(&_maxX[i], _mm_mul_ps(scaleX4, _mm_max_ps(_mm_mul_ps(right, inverseNear), _mm_mul_ps(right, inverseFar))));
+        _mm_storeu_ps(&_minY[i], _mm_mul_ps(scaleY4, _mm_min_ps(_mm_mul_ps(bottom, inverseNear), _mm_mul_ps(bottom, inverseFar))));
+        _mm_storeu_ps(&_maxY[i], _mm_mul_ps(scaleY4, _mm_max_ps(_mm_mul_ps(top, inverseNear), _mm_mul_ps(top, inverseFar))));
+        _mm_storeu_ps(&_nearDepth[i], nearDepth);
+        _mm_storeu_ps(&_farDepth[i], _mm_add_ps(depth, range));
+    }
+#elif defined(MATH_NEON)
+    float32x4_t near4 = vdupq_n_f32(nearPlane);
+
+    for (size_t i = 0; i < count; i += 4) {
+        float32x4_t centerX = vld1q_f32(&_centerX[i]);
+        float32x4_t centerY = vld1q_f32(&_centerY[i]);
+        float32x4_t depth = vld1q_f32(&_depth[i]);
+        float32x4_t range = vld1q_f32(&_range[i]);
+
+        float32x4_t nearDepth = vmaxq_f32(vsubq_f32(depth, range), near4);
+        float32x4_t farDepth = vmaxq_f32(vaddq_f32(depth, range), near4);
+        float32x4_t inverseNear = vdivq_f32(vdupq_n_f32(1.0f), nearDepth);
+        float32x4_t inverseFar = vdivq_f32(vdupq_n_f32(1.0f), farDepth);
+
+        float32x4_t left = vsubq_f32(centerX, range);
+        float32x4_t right = vaddq_f32(centerX, range);
+        float32x4_t bottom = vsubq_f32(centerY, range);
+        float32x4_t top = vaddq_f32(centerY, range);
+
+        vst1q_f32(&_minX[i], vmulq_n_f32(vminq_f32(vmulq_f32(left, inverseNear), vmulq_f32(left, inverseFar)), scaleX));
+        vst1q_f32(&_maxX[i], vmulq_n_f32(vmaxq_f32(vmulq_f32(right, inverseNear), vmulq_f32(right, inverseFar)), scaleX));
+        vst1q_f32(&_minY[i], vmulq_n_f32(vminq_f32(vmulq_f32(bottom, inverseNear), vmulq_f32(bottom, inverseFar)), scaleY));
+        vst1q_f32(&_maxY[i], vmulq_n_f32(vmaxq_f32(vmulq_f32(top, inverseNear), vmulq_f32(top, inverseFar)), scaleY));
+        vst1q_f32(&_nearDepth[i], nearDepth);
+        vst1q_f32(&_farDepth[i], vaddq_f32(depth, range));
+    }
+#else
+    for (size_t i = 0; i < count; i++) {
+        float nearDepth = std::max(_depth[i] - _range[i], nearPlane);
+        float farDepth = std::max(_depth[i] + _range[i], nearPlane);
+        float inverseNear = 1.0f / nearDepth;
+        float inverseFar = 1.0f / farDepth;
+
+        float left = _centerX[i] - _range[i];
+        float right = _centerX[i] + _range[i];
+        float bottom = _centerY[i] - _range[i];
+        float top = _centerY[i] + _range[i];
+
+        _minX[i] = scaleX * std::min(left * inverseNear, left * inverseFar);
+        _maxX[i] = scaleX * std::max(right * inverseNear, right * inverseFar);
+        _minY[i] = scaleY * std::min(bottom * inverseNear, bottom * inverseFar);
+        _maxY[i] = scaleY * std::max(top * inverseNear, top * inverseFar);
+        _nearDepth[i] = nearDepth;
+        _farDepth[i] = _depth[i] + _range[i];
+    }
+#endif
+}
+
+void LightClusters::_bind(GLuint binding, const void* data, size_t size) {
+
+    //Empty ranges can not be bound so an empty list still gets one zeroed element
+    static const GLuint empty[8] = {};
+    if (size == 0) {
+        data = empty;
+        size = sizeof(empty);
+    }
+    size_t offset = _storage->write(data, size, _storageAlignment);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, _storage->getContext(), offset, size);
+}
+
+float LightClusters::getSliceScale() {
+    return _sliceScale;
+}
+
+float LightClusters::getSliceBias() {
+    return _sliceBias;
+}
+
+int LightClusters::getLightCount() {
+    return static_cast<int>(_lights.size());
+}
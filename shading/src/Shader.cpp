@@ -1,6 +1,7 @@
 #include "Shader.h"
 #include "Model.h"
 #include "Light.h"
+#include "UniformBlocks.h"
 #include <iostream>
 #include <fstream>
 
@@ -102,6 +103,7 @@ void Shader::_link(unsigned int vertexSH, unsigned int fragmentSH, unsigned int
 
     // Exit if the program couldn't be linked correctly
     if (successfully_linked) {
+        UniformBlocks::bindProgram(_shaderContext);
         if (g_VerboseShaders) {
             printf("Shader #%d linked   (Shader* this = %p)\n", _shaderContext, this);
         }
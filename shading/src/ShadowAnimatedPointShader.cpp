@@ -9,7 +9,7 @@ ShadowAnimatedPointShader::~ShadowAnimatedPointShader() {
 
 }
 
-void ShadowAnimatedPointShader::runShader(Model* model, Light* light, std::vector<Matrix> lightTransforms) {
+void ShadowAnimatedPointShader::runShader(Model* model, Light* light, Matrix& faceTransform) {
 
     AnimatedModel* animationModel = static_cast<AnimatedModel*>(model);
 
@@ -29,18 +29,8 @@ void ShadowAnimatedPointShader::runShader(Model* model, Light* light, std::vecto
     //glUniform mat4 combined model and world matrix, GL_TRUE is telling GL we are passing in the matrix as row major
     glUniformMatrix4fv(_viewLocation, 1, GL_TRUE, modelMVP->getViewBuffer());
 
-    float* lightCubeTransforms = new float[6*16];
-    int index = 0;
-    for (Matrix lightTransform : lightTransforms) {
-        float* mat = lightTransform.getFlatBuffer();
-        for (int i = 0; i < 16; ++i) {
-            lightCubeTransforms[index++] = mat[i];
-        }
-    }
-    //glUniform mat4 light cube map transforms, GL_TRUE is telling GL we are passing in the matrix as row major
-    //6 faces and each transform is 16 floats in a 4x4 matrix
-    glUniformMatrix4fv(_lightCubeTransformsLocation, 6, GL_TRUE, lightCubeTransforms);
-    delete[] lightCubeTransforms;
+    //glUniform mat4 transform of the cube face being drawn, GL_TRUE is telling GL we are passing in the matrix as row major
+    glUniformMatrix4fv(_faceTransformLocation, 1, GL_TRUE, faceTransform.getFlatBuffer());
 
     //Set light position for point light
     auto lightPos = light->getPosition();
@@ -10,14 +10,13 @@ ShadowAnimatedShader::~ShadowAnimatedShader(){
 
 }
 
-void ShadowAnimatedShader::runShader(Model* model, Light* light) {
+void ShadowAnimatedShader::runShader(Model* model, MVP& lightMVP) {
 
 	AnimatedModel* animationModel = static_cast<AnimatedModel*>(model);
 
 	//Load in vbo buffers
     VAO* vao = model->getVAO();
     MVP* modelMVP = animationModel->getMVP();
-	MVP lightMVP = light->getLightMVP();
 
     //Use one single shadow shader and replace the vbo buffer from each model
     glUseProgram(_shaderContext); //use context for loaded shader
@@ -4,7 +4,7 @@ ShadowPointShader::ShadowPointShader(std::string shaderName) : Shader(shaderName
 
     _modelLocation = glGetUniformLocation(_shaderContext, "model");
     _viewLocation = glGetUniformLocation(_shaderContext, "view");
-    _lightCubeTransformsLocation = glGetUniformLocation(_shaderContext, "shadowMatrices");
+    _faceTransformLocation = glGetUniformLocation(_shaderContext, "shadowMatrix");
     _lightPosLocation = glGetUniformLocation(_shaderContext, "lightPos");
     _farPlaneLocation = glGetUniformLocation(_shaderContext, "farPlane");
 }
@@ -13,7 +13,7 @@ ShadowPointShader::~ShadowPointShader() {
 
 }
 
-void ShadowPointShader::runShader(Model* model, Light* light, std::vector<Matrix> lightTransforms) {
+void ShadowPointShader::runShader(Model* model, Light* light, Matrix& faceTransform) {
 
     //Load in vbo buffers
     VAO* vao = model->getVAO();
@@ -31,18 +31,8 @@ void ShadowPointShader::runShader(Model* model, Light* light, std::vector<Matrix
     //glUniform mat4 combined model and world matrix, GL_TRUE is telling GL we are passing in the matrix as row major
     glUniformMatrix4fv(_viewLocation, 1, GL_TRUE, modelMVP->getViewBuffer());
 
-    float* lightCubeTransforms = new float[6*16];
-    int index = 0;
-    for (Matrix lightTransform : lightTransforms) {
-        float* mat = lightTransform.getFlatBuffer();
-        for (int i = 0; i < 16; ++i) {
-            lightCubeTransforms[index++] = mat[i];
-        }
-    }
-    //glUniform mat4 light cube map transforms, GL_TRUE is telling GL we are passing in the matrix as row major
-    //6 faces and each transform is 16 floats in a 4x4 matrix
-    glUniformMatrix4fv(_lightCubeTransformsLocation, 6, GL_TRUE, lightCubeTransforms);
-    delete[] lightCubeTransforms;
+    //glUniform mat4 transform of the cube face being drawn, GL_TRUE is telling GL we are passing in the matrix as row major
+    glUniformMatrix4fv(_faceTransformLocation, 1, GL_TRUE, faceTransform.getFlatBuffer());
 
     //Set light position for point light
     auto lightPos = light->getPosition();
@@ -61,7 +51,10 @@ void ShadowPointShader::runShader(Model* model, Light* light, std::vector<Matrix
         verticesSize += textureStride.second;
     }
 
-    glDrawElements(GL_TRIANGLES, verticesSize, GL_UNSIGNED_INT, static_cast<void*>(0));
+    //The model's indices start partway into the shared index buffer and are relative to its base vertex
+    glDrawElementsBaseVertex(GL_TRIANGLES, verticesSize, GL_UNSIGNED_INT,
+                             reinterpret_cast<void*>(static_cast<uintptr_t>(vao->getFirstIndex()) * sizeof(GLuint)),
+                             vao->getBaseVertex());
 
     glBindVertexArray(0);
     glUseProgram(0);//end using this shader
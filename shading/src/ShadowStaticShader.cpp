@@ -18,12 +18,11 @@ ShadowStaticShader::~ShadowStaticShader(){
 
 }
 
-void ShadowStaticShader::runShader(Model* model, Light* light) {
+void ShadowStaticShader::runShader(Model* model, MVP& lightMVP) {
 
 	//Load in vbo buffers
     VAO* vao = model->getVAO();
     MVP* modelMVP = model->getMVP();
-	MVP lightMVP = light->getLightMVP();
 
 	//Use one single shadow shader and replace the vbo buffer from each model
     glUseProgram(_shaderContext); //use context for loaded shader
@@ -45,7 +44,10 @@ void ShadowStaticShader::runShader(Model* model, Light* light) {
         verticesSize += textureStride.second;
     }
 
-    glDrawElements(GL_TRIANGLES, verticesSize, GL_UNSIGNED_INT, (void*)0);
+    //The model's indices start partway into the shared index buffer and are relative to its base vertex
+    glDrawElementsBaseVertex(GL_TRIANGLES, verticesSize, GL_UNSIGNED_INT,
+                             reinterpret_cast<void*>(static_cast<uintptr_t>(vao->getFirstIndex()) * sizeof(GLuint)),
+                             vao->getBaseVertex());
 
     glBindVertexArray(0);
     glUseProgram(0);//end using this shader
@@ -5,27 +5,13 @@ StaticShader::StaticShader(std::string shaderName) : Shader(shaderName) {
 
 	//Grab uniforms needed in a staticshader
 
-    //glUniform mat4 combined model and world matrix
-    _modelLocation = glGetUniformLocation(_shaderContext, "model");
-
-    //glUniform mat4 view matrix
-    _viewLocation = glGetUniformLocation(_shaderContext, "view");
-
-    //glUniform mat4 projection matrix
-    _projectionLocation = glGetUniformLocation(_shaderContext, "projection");
-
-    //glUniform mat4 normal matrix
-    _normalLocation = glGetUniformLocation(_shaderContext, "normal");
-
-    //glUniform texture map sampler location
-    _textureLocation = glGetUniformLocation(_shaderContext, "textureMap");
-
-    //glUniform texture map sampler location
-    _tex0Location = glGetUniformLocation(_shaderContext, "tex0");
-    _tex1Location = glGetUniformLocation(_shaderContext, "tex1");
-    _tex2Location = glGetUniformLocation(_shaderContext, "tex2");
-    _tex3Location = glGetUniformLocation(_shaderContext, "tex3");
-    _alphatex0Location = glGetUniformLocation(_shaderContext, "alphatex0");
+    //glUniform sampler locations of every texture a material can bind, indexed by MaterialSampler
+    _samplerLocations[static_cast<int>(MaterialSampler::TextureMap)] = glGetUniformLocation(_shaderContext, "textureMap");
+    _samplerLocations[static_cast<int>(MaterialSampler::Tex0)] = glGetUniformLocation(_shaderContext, "tex0");
+    _samplerLocations[static_cast<int>(MaterialSampler::Tex1)] = glGetUniformLocation(_shaderContext, "tex1");
+    _samplerLocations[static_cast<int>(MaterialSampler::Tex2)] = glGetUniformLocation(_shaderContext, "tex2");
+    _samplerLocations[static_cast<int>(MaterialSampler::Tex3)] = glGetUniformLocation(_shaderContext, "tex3");
+    _samplerLocations[static_cast<int>(MaterialSampler::AlphaTex0)] = glGetUniformLocation(_shaderContext, "alphatex0");
 
     _layeredSwitchLocation = glGetUniformLocation(_shaderContext, "isLayeredTexture");
 }
@@ -36,140 +22,53 @@ StaticShader::~StaticShader() {
 
 void StaticShader::runShader(Model* model) {
 
-    //LOAD IN SHADER
-    glUseProgram(_shaderContext); //use context for loaded shader
-
-    VAO* vao = model->getVAO();
-
-    glBindVertexArray(vao->getVAOContext());
-
-    MVP* mvp = model->getMVP();
-    //glUniform mat4 combined model and world matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_modelLocation, 1, GL_TRUE, mvp->getModelBuffer());
-
-    //glUniform mat4 view matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_viewLocation, 1, GL_TRUE, mvp->getViewBuffer());
-
-    //glUniform mat4 projection matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_projectionLocation, 1, GL_TRUE, mvp->getProjectionBuffer());
-
-    //glUniform mat4 normal matrix, GL_TRUE is telling GL we are passing in the matrix as row major
-    glUniformMatrix4fv(_normalLocation, 1, GL_TRUE, mvp->getNormalBuffer());
-
-    auto textureStrides = model->getTextureStrides();
-    unsigned int strideLocation = 0;
-    for(auto textureStride : textureStrides) {
-
-        //If the texture has layered encoded into the string then it is indeed layered
-        if (textureStride.first.substr(0, 7) == "Layered") {
-
-            LayeredTexture* layeredTexture = model->getLayeredTexture(textureStride.first);
-            auto textures = layeredTexture->getTextures();
-
-            //We have a layered texture
-            glUniform1i(_layeredSwitchLocation, 1);
-
-            if (textures.size() > 4) {
-
-                glUniform1i(_tex0Location, 1);
-                glUniform1i(_tex1Location, 2);
-                glUniform1i(_tex2Location, 3);
-                glUniform1i(_tex3Location, 4);
-                glUniform1i(_alphatex0Location, 5);
-
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, textures[0]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE2);
-                glBindTexture(GL_TEXTURE_2D, textures[1]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE3);
-                glBindTexture(GL_TEXTURE_2D, textures[2]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE4);
-                glBindTexture(GL_TEXTURE_2D, textures[3]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE5);
-                glBindTexture(GL_TEXTURE_2D, textures[7]->getContext()); //grab first texture of model and return context
-            }
-            else {
-
-                glUniform1i(_tex0Location, 1);
-                glUniform1i(_tex1Location, 2);
-                glUniform1i(_tex2Location, 3);
-                glUniform1i(_alphatex0Location, 5);
-
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, textures[0]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE2);
-                glBindTexture(GL_TEXTURE_2D, textures[1]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE3);
-                glBindTexture(GL_TEXTURE_2D, textures[2]->getContext()); //grab first texture of model and return context
-                glActiveTexture(GL_TEXTURE5);
-                glBindTexture(GL_TEXTURE_2D, textures[3]->getContext()); //grab first texture of model and return context
-            }
-
+    //Goes through the same multi draw path as the draws the scene records
+    DrawList drawList;
+    recordDraws(model, &drawList, 0.0f);
+    drawList.submit();
+}
 
-            glDrawElements(GL_TRIANGLES, (GLsizei)textureStride.second, GL_UNSIGNED_INT, (void*)strideLocation);
-            strideLocation += textureStride.second;
-        }
-        else {
-            //If triangle's textures supports transparency then do NOT draw
-            //Transparent objects will be rendered after the deferred lighting pass
-            if (!model->getTexture(textureStride.first)->getTransparency()) {
-                //Not layered texture
-                glUniform1i(_layeredSwitchLocation, 0);
-
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, model->getTexture(textureStride.first)->getContext()); //grab first texture of model and return context
-                //glUniform texture
-                //The second parameter has to be equal to GL_TEXTURE(X) so X must be 0 because we activated texture GL_TEXTURE0 two calls before
-                glUniform1i(_textureLocation, 0);
-
-                if (_tex0Location != -1 && model->getTexture("../assets/textures/landscape/dirt.jpg") != nullptr) {
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, model->getTexture("../assets/textures/landscape/dirt.jpg")->getContext());
-                    glUniform1i(_tex0Location, 0);
-                }
-                if (_tex1Location != -1 && model->getTexture("../assets/textures/landscape/grass.jpg") != nullptr) {
-                    glActiveTexture(GL_TEXTURE1);
-                    glBindTexture(GL_TEXTURE_2D, model->getTexture("../assets/textures/landscape/grass.jpg")->getContext());
-                    glUniform1i(_tex1Location, 1);
-                }
-                if (_tex2Location != -1 && model->getTexture("../assets/textures/landscape/rocks.jpg") != nullptr) {
-                    glActiveTexture(GL_TEXTURE2);
-                    glBindTexture(GL_TEXTURE_2D, model->getTexture("../assets/textures/landscape/rocks.jpg")->getContext());
-                    glUniform1i(_tex2Location, 2);
-                }
-                if (_tex3Location != -1 && model->getTexture("../assets/textures/landscape/snow.jpg") != nullptr) {
-                    glActiveTexture(GL_TEXTURE3);
-                    glBindTexture(GL_TEXTURE_2D, model->getTexture("../assets/textures/landscape/snow.jpg")->getContext());
-                    glUniform1i(_tex3Location, 3);
-                }
-
-                glDrawElements(GL_TRIANGLES, (GLsizei)textureStride.second, GL_UNSIGNED_INT, (void*)strideLocation);
-            }
-            strideLocation += textureStride.second;
+void StaticShader::recordDraws(Model* model, DrawList* drawList, float depth) {
+
+    VAO* modelVAO = model->getVAO();
+    GLuint vao = modelVAO->getVAOContext();
+    auto& textureStrides = model->getTextureStrides();
+    GLuint strideLocation = modelVAO->getFirstIndex();
+    for (int stride = 0; stride < static_cast<int>(textureStrides.size()); stride++) {
+
+        if (isDrawn(model, stride)) {
+            DrawCommand command;
+            command.shader = this;
+            command.model = model;
+            command.vao = vao;
+            command.material = model->getStrideMaterial(stride);
+            command.first = strideLocation;
+            command.baseVertex = modelVAO->getBaseVertex();
+            command.count = static_cast<GLsizei>(textureStrides[stride].second);
+            drawList->add(DrawList::makeKey(DrawPass::Opaque, _shaderContext, command.material->getId(), vao, depth), command);
         }
+        strideLocation += textureStrides[stride].second;
     }
-    glBindVertexArray(0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindTexture(GL_TEXTURE_2D, 0); //Unbind texture
-    glUseProgram(0);//end using this shader
 }
 
-GLint StaticShader::getViewLocation() {
-    return _viewLocation;
-}
+bool StaticShader::isDrawn(Model* model, int stride) {
 
-GLint StaticShader::getModelLocation() {
-    return _modelLocation;
+    //If triangle's textures supports transparency then do NOT draw
+    //Transparent objects will be rendered after the deferred lighting pass
+    return !model->getStrideMaterial(stride)->isTransparent();
 }
 
-GLint StaticShader::getProjectionLocation() {
-    return _projectionLocation;
+void StaticShader::bindProgram() {
+    glUseProgram(_shaderContext); //use context for loaded shader
 }
 
-GLint StaticShader::getNormalLocation() {
-    return _normalLocation;
+void StaticShader::bindMaterial(const Material* material) {
+    material->bind(_samplerLocations, _layeredSwitchLocation);
 }
 
-GLint StaticShader::getTextureLocation() {
-    return _textureLocation;
+void StaticShader::unbind() {
+    glBindVertexArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0); //Unbind texture
+    glUseProgram(0);//end using this shader
 }
@@ -0,0 +1,111 @@
+#include "UniformBlocks.h"
+#include "ViewManager.h"
+#include "Light.h"
+#include "LightClusters.h"
+#include <string.h>
+
+//std140 places vec4 and mat4 members on 16 byte boundaries and rounds blocks up to 16 bytes
+static_assert(sizeof(FrameConstants) == 16, "FrameConstants must match its std140 block");
+static_assert(sizeof(ViewConstants) == 5 * 64 + 16, "ViewConstants must match its std140 block");
+static_assert(sizeof(LightConstants) == SHADOW_CASCADES * 64 + 4 * 16, "LightConstants must match its std140 block");
+
+UniformBlocks::UniformBlocks() {
+
+    memset(&_frame, 0, sizeof(_frame));
+    memset(&_view, 0, sizeof(_view));
+    memset(&_lights, 0, sizeof(_lights));
+    _lights.clusterDims[0] = CLUSTER_TILES_X;
+    _lights.clusterDims[1] = CLUSTER_TILES_Y;
+    _lights.clusterDims[2] = CLUSTER_SLICES;
+
+    glGenBuffers(3, _buffers);
+    _upload(FRAME_CONSTANTS_BINDING, &_frame, sizeof(_frame));
+    _upload(VIEW_CONSTANTS_BINDING, &_view, sizeof(_view));
+    _upload(LIGHT_CONSTANTS_BINDING, &_lights, sizeof(_lights));
+
+    //Nothing else binds uniform buffers so the blocks stay on their binding points
+    for (GLuint binding = 0; binding < 3; binding++) {
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, _buffers[binding]);
+    }
+}
+
+UniformBlocks::~UniformBlocks() {
+    glDeleteBuffers(3, _buffers);
+}
+
+void UniformBlocks::bindProgram(GLuint program) {
+
+    const char* blockNames[] = { "FrameConstants", "ViewConstants", "LightConstants" };
+    const GLuint bindings[] = { FRAME_CONSTANTS_BINDING, VIEW_CONSTANTS_BINDING, LIGHT_CONSTANTS_BINDING };
+
+    for (int block = 0; block < 3; block++) {
+        GLuint blockIndex = glGetUniformBlockIndex(program, blockNames[block]);
+        if (blockIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program, blockIndex, bindings[block]);
+        }
+    }
+}
+
+void UniformBlocks::_upload(GLuint binding, const void* data, size_t size) {
+
+    //Orphan the old storage so a block still read by last frame's draws never stalls the write
+    glBindBuffer(GL_UNIFORM_BUFFER, _buffers[binding]);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBlocks::updateFrame(float seconds, int views) {
+
+    _frame.time = seconds;
+    _frame.views = views;
+    _upload(FRAME_CONSTANTS_BINDING, &_frame, sizeof(_frame));
+}
+
+void UniformBlocks::updateView(ViewManager* viewManager) {
+
+    Matrix view = viewManager->getView();
+    Matrix projection = viewManager->getProjection();
+
+    memcpy(_view.view, view.getFlatBuffer(), sizeof(_view.view));
+    memcpy(_view.projection, projection.getFlatBuffer(), sizeof(_view.projection));
+    memcpy(_view.normal, view.normalMatrix().getFlatBuffer(), sizeof(_view.normal));
+    memcpy(_view.inverseView, view.inverse().getFlatBuffer(), sizeof(_view.inverseView));
+    memcpy(_view.inverseProjection, projection.inverse().getFlatBuffer(), sizeof(_view.inverseProjection));
+
+    float* projMatrix = projection.getFlatBuffer();
+    float nearVal = (2.0f*projMatrix[11]) / (2.0f*projMatrix[10] - 2.0f);
+    float farVal = ((projMatrix[10] - 1.0f)*nearVal) / (projMatrix[10] + 1.0f);
+    _view.planes[0] = nearVal;
+    _view.planes[1] = farVal;
+
+    _upload(VIEW_CONSTANTS_BINDING, &_view, sizeof(_view));
+}
+
+void UniformBlocks::updateLights(ViewManager* viewManager, std::vector<Light*>& lights, LightClusters* clusters,
+                                 ShadowRenderer* shadowRenderer) {
+
+    Matrix viewToModelSpace = viewManager->getView().inverse();
+
+    //Get light view matrix "look at" vector which is located in the third column
+    //of the inner rotation matrix at index 2,6,10
+    MVP lightMVP = lights[0]->getLightMVP();
+    float* lightView = lightMVP.getViewBuffer();
+    _lights.light[0] = lightView[2];
+    _lights.light[1] = lightView[6];
+    _lights.light[2] = lightView[10];
+    _lights.light[3] = 0.0f;
+
+    //Change of basis from camera view position back to world position and into each cascade's clip space
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        Matrix cameraToCascade = shadowRenderer->getCascadeMatrix(cascade) * viewToModelSpace;
+        memcpy(_lights.cascadeMatrices[cascade], cameraToCascade.getFlatBuffer(), sizeof(_lights.cascadeMatrices[cascade]));
+        _lights.cascadeSplits[cascade] = shadowRenderer->getCascadeSplit(cascade);
+    }
+
+    //Point lights themselves live in the cluster storage buffers
+    _lights.clusterDepth[0] = clusters->getSliceScale();
+    _lights.clusterDepth[1] = clusters->getSliceBias();
+
+    _upload(LIGHT_CONSTANTS_BINDING, &_lights, sizeof(_lights));
+}
@@ -0,0 +1,43 @@
+/*
+* TestCheck is part of the ReBoot distribution (https://github.com/octopusprime314/ReBoot.git).
+* Copyright (c) 2017 Peter Morley.
+*
+* ReBoot is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, version 3.
+*
+* ReBoot is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+* General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+*  TestCheck. Minimal checks for the GL free tests.  A failed check prints its file, line and
+*  expression and keeps going so one run reports every failure, main returns testResult() for ctest.
+*/
+
+#pragma once
+#include <cstdio>
+
+static int testFailures = 0;
+
+#define TEST_CHECK(condition)                                                         \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);     \
+            testFailures++;                                                           \
+        }                                                                             \
+    } while (0)
+
+static inline int testResult() {
+    if (testFailures == 0) {
+        printf("All checks passed\n");
+        return 0;
+    }
+    printf("%d checks failed\n", testFailures);
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "Frustum.h"
+#include "Vector4.h"
+#include "TestCheck.h"
+#include <random>
+#include <vector>
+
+//Not a multiple of 4 or 32 so the batched tests run their scalar tails and a partial mask word
+const size_t FRUSTUM_TEST_COUNT = 1027;
+
+static bool _bit(const std::vector<uint32_t>& masks, size_t i) {
+    return ((masks[i / 32] >> (i % 32)) & 1u) != 0;
+}
+
+int main() {
+
+    std::mt19937 generator(0xf257);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> size(0.1f, 8.0f);
+
+    Matrix projection = Matrix::cameraProjection(60.0f, 1.78f, 0.1f, 100.0f);
+    Matrix view = Matrix::rotationAroundY(30.0f) * Matrix::translation(0.0f, -2.0f, 5.0f);
+    Frustum frustum(projection * view);
+
+    //Known cases against the clip space cube
+    Frustum clipSpace;
+    TEST_CHECK(clipSpace.sphereVisible(Vector4(0.0f, 0.0f, 0.0f, 1.0f), 0.5f));
+    TEST_CHECK(!clipSpace.sphereVisible(Vector4(3.0f, 0.0f, 0.0f, 1.0f), 0.5f));
+    TEST_CHECK(clipSpace.sphereVisible(Vector4(1.4f, 0.0f, 0.0f, 1.0f), 0.5f));
+    TEST_CHECK(!clipSpace.aabbVisible(Vector4(0.0f, -3.0f, 0.0f, 1.0f), Vector4(1.0f, 1.0f, 1.0f, 0.0f)));
+    TEST_CHECK(clipSpace.obbVisible(Matrix::rotationAroundZ(45.0f) * Matrix::scale(0.5f)));
+
+    std::vector<Vector4> centers(FRUSTUM_TEST_COUNT);
+    std::vector<Vector4> halfExtents(FRUSTUM_TEST_COUNT);
+    std::vector<float>   radii(FRUSTUM_TEST_COUNT);
+    std::vector<Matrix>  transforms(FRUSTUM_TEST_COUNT);
+    for (size_t i = 0; i < FRUSTUM_TEST_COUNT; i++) {
+        centers[i] = Vector4(position(generator), position(generator), position(generator), 1.0f);
+        halfExtents[i] = Vector4(size(generator), size(generator), size(generator), 0.0f);
+        radii[i] = size(generator);
+        transforms[i] = Matrix::translation(centers[i].getx(), centers[i].gety(), centers[i].getz()) *
+                        Matrix::rotationAroundX(angle(generator)) * Matrix::rotationAroundY(angle(generator)) *
+                        Matrix::scale(halfExtents[i].getx(), halfExtents[i].gety(), halfExtents[i].getz());
+    }
+
+    //Stale bits must be cleared, the batched tests overwrite every mask word they cover
+    size_t words = Frustum::maskWords(FRUSTUM_TEST_COUNT);
+    TEST_CHECK(words == (FRUSTUM_TEST_COUNT + 31) / 32);
+    std::vector<uint32_t> sphereMasks(words, 0xFFFFFFFFu);
+    std::vector<uint32_t> aabbMasks(words, 0xFFFFFFFFu);
+    std::vector<uint32_t> obbMasks(words, 0xFFFFFFFFu);
+    frustum.testSpheres(centers.data(), radii.data(), FRUSTUM_TEST_COUNT, sphereMasks.data());
+    frustum.testAABBs(centers.data(), halfExtents.data(), FRUSTUM_TEST_COUNT, aabbMasks.data());
+    frustum.testOBBs(transforms.data(), FRUSTUM_TEST_COUNT, obbMasks.data());
+
+    size_t visible = 0;
+    for (size_t i = 0; i < FRUSTUM_TEST_COUNT; i++) {
+        TEST_CHECK(_bit(sphereMasks, i) == frustum.sphereVisible(centers[i], radii[i]));
+        TEST_CHECK(_bit(aabbMasks, i) == frustum.aabbVisible(centers[i], halfExtents[i]));
+        TEST_CHECK(_bit(obbMasks, i) == frustum.obbVisible(transforms[i]));
+        visible += _bit(obbMasks, i) ? 1 : 0;
+    }
+    TEST_CHECK((sphereMasks.back() >> (FRUSTUM_TEST_COUNT % 32)) == 0u);
+
+    //Both outcomes have to show up for the comparison to mean anything
+    TEST_CHECK(visible > 0 && visible < FRUSTUM_TEST_COUNT);
+
+    return testResult();
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "LooseOctTree.h"
+#include "GeometryMath.h"
+#include "TestCheck.h"
+#include <random>
+#include <vector>
+#include <cstdint>
+
+const float LOOSE_TEST_VOLUME  = 2000.0f; //Same volume as the physics OSP
+const int   LOOSE_TEST_DEPTH   = 8;
+const int   LOOSE_TEST_MODELS  = 16;
+const int   LOOSE_TEST_SPHERES = 600;
+
+//The tree never dereferences models, it only groups spheres by them
+static Model* _fakeModel(int index) {
+    return reinterpret_cast<Model*>(static_cast<uintptr_t>(0x1000 + index * 16));
+}
+
+static bool _contains(std::unordered_map<Model*, std::set<Sphere*>>& overlaps, Model* model, Sphere* sphere) {
+    auto spheres = overlaps.find(model);
+    return spheres != overlaps.end() && spheres->second.count(sphere) != 0;
+}
+
+//Every pair that really overlaps must come back from the query, nothing removed may
+static void _checkQueries(LooseOctTree& tree, std::vector<Sphere>& spheres, std::vector<bool>& inserted,
+                          size_t& candidates) {
+
+    for (size_t i = 0; i < spheres.size(); i++) {
+        if (!inserted[i]) {
+            continue;
+        }
+        std::unordered_map<Model*, std::set<Sphere*>> overlaps;
+        tree.querySpheres(&spheres[i], overlaps);
+        TEST_CHECK(!_contains(overlaps, _fakeModel(static_cast<int>(i) % LOOSE_TEST_MODELS), &spheres[i]));
+
+        for (size_t j = 0; j < spheres.size(); j++) {
+            Model* model = _fakeModel(static_cast<int>(j) % LOOSE_TEST_MODELS);
+            if (!inserted[j]) {
+                TEST_CHECK(!_contains(overlaps, model, &spheres[j]));
+            }
+            else if (i != j && GeometryMath::sphereSphereDetection(spheres[i], spheres[j])) {
+                TEST_CHECK(_contains(overlaps, model, &spheres[j]));
+            }
+        }
+        for (auto& sphereMap : overlaps) {
+            candidates += sphereMap.second.size();
+        }
+    }
+}
+
+int main() {
+
+    std::mt19937 generator(0x100e);
+    std::uniform_real_distribution<float> position(-1100.0f, 1100.0f); //Some centers fall outside of the volume
+    std::uniform_real_distribution<float> radius(0.5f, 1.0f);
+    std::uniform_real_distribution<float> move(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    //Mostly small spheres with a few large ones that stop high up in the tree
+    std::vector<Sphere> spheres;
+    spheres.reserve(LOOSE_TEST_SPHERES);
+    for (int i = 0; i < LOOSE_TEST_SPHERES; i++) {
+        float scale = unit(generator) < 0.05f ? 200.0f : 20.0f;
+        spheres.push_back(Sphere(radius(generator) * scale,
+                                 Vector4(position(generator), position(generator), position(generator), 1.0f)));
+    }
+
+    //Spheres centered outside of the volume live in the root and still find each other when they are
+    //past even the root's loose bounds
+    {
+        LooseOctTree outside(LOOSE_TEST_VOLUME, LOOSE_TEST_DEPTH);
+        Sphere farA(10.0f, Vector4(2500.0f, 0.0f, 0.0f, 1.0f));
+        Sphere farB(10.0f, Vector4(2515.0f, 0.0f, 0.0f, 1.0f));
+        Sphere inside(10.0f, Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+        outside.insert(_fakeModel(0), &farA);
+        outside.insert(_fakeModel(1), &farB);
+        outside.insert(_fakeModel(2), &inside);
+        std::unordered_map<Model*, std::set<Sphere*>> overlaps;
+        outside.querySpheres(&farA, overlaps);
+        TEST_CHECK(_contains(overlaps, _fakeModel(1), &farB));
+        TEST_CHECK(!_contains(overlaps, _fakeModel(2), &inside));
+    }
+
+    LooseOctTree tree(LOOSE_TEST_VOLUME, LOOSE_TEST_DEPTH);
+    std::vector<bool> inserted(spheres.size(), true);
+    for (size_t i = 0; i < spheres.size(); i++) {
+        tree.insert(_fakeModel(static_cast<int>(i) % LOOSE_TEST_MODELS), &spheres[i]);
+    }
+    size_t candidates = 0;
+    _checkQueries(tree, spheres, inserted, candidates);
+
+    //The loose bounds have to prune, otherwise every query returns every sphere
+    TEST_CHECK(candidates < spheres.size() * spheres.size() / 4);
+
+    //Move every sphere, some far enough to change nodes or leave the volume, and drop a few
+    for (int pass = 0; pass < 3; pass++) {
+        for (size_t i = 0; i < spheres.size(); i++) {
+            Model* model = _fakeModel(static_cast<int>(i) % LOOSE_TEST_MODELS);
+            if (inserted[i] && unit(generator) < 0.05f) {
+                tree.remove(model, &spheres[i]);
+                inserted[i] = false;
+                continue;
+            }
+            float distance = unit(generator) < 0.1f ? 10.0f : 1.0f;
+            spheres[i].offsetPosition(Vector4(move(generator) * distance, move(generator) * distance,
+                                              move(generator) * distance, 0.0f));
+            if (inserted[i]) {
+                tree.update(model, &spheres[i]);
+            }
+        }
+        candidates = 0;
+        _checkQueries(tree, spheres, inserted, candidates);
+    }
+
+    return testResult();
+}
\ No newline at end of file
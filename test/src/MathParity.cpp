@@ -0,0 +1,255 @@
+#include "Matrix.h"
+#include "Vector4.h"
+#include "BatchMath.h"
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+//Inputs for the single element operators
+const size_t PARITY_POOL_SIZE = 256;
+
+//Past BATCH_THREAD_COUNT so the threaded and streaming BatchMath paths run too
+const size_t PARITY_BATCH_SIZE = 70000;
+
+struct ParityResult {
+    std::string        name;
+    std::vector<float> values; //Raw outputs, compared bit for bit
+};
+
+static const char* _mathPath() {
+#if defined(MATH_SSE)
+    return "sse";
+#elif defined(MATH_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+static void _printUsage() {
+    printf("MathParity --write file | --check file\n");
+    printf("  --write  save this build's results, run from a MATH_SCALAR build\n");
+    printf("  --check  compare this build's results against a saved file bit for bit\n");
+}
+
+static void _addMatrices(std::vector<ParityResult>& results, const char* name, const std::vector<Matrix>& matrices) {
+    ParityResult result = { name, std::vector<float>() };
+    for (const Matrix& matrix : matrices) {
+        result.values.insert(result.values.end(), matrix.getFlatBuffer(), matrix.getFlatBuffer() + 16);
+    }
+    results.push_back(result);
+}
+
+static void _addVectors(std::vector<ParityResult>& results, const char* name, const std::vector<Vector4>& vectors) {
+    ParityResult result = { name, std::vector<float>() };
+    for (const Vector4& vector : vectors) {
+        result.values.insert(result.values.end(), vector.getFlatBuffer(), vector.getFlatBuffer() + 4);
+    }
+    results.push_back(result);
+}
+
+static std::vector<ParityResult> _computeResults() {
+
+    std::mt19937 generator(0x5eed);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<Matrix>  generalMatrices(PARITY_POOL_SIZE);
+    std::vector<Matrix>  rigidMatrices(PARITY_POOL_SIZE);
+    std::vector<Matrix>  affineMatrices(PARITY_POOL_SIZE);
+    std::vector<Vector4> vectors(PARITY_POOL_SIZE);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        Matrix rotation = Matrix::rotationAroundX(angle(generator)) *
+                          Matrix::rotationAroundY(angle(generator)) *
+                          Matrix::rotationAroundZ(angle(generator));
+        rigidMatrices[i] = Matrix::translation(position(generator), position(generator), position(generator)) * rotation;
+        affineMatrices[i] = rigidMatrices[i] * Matrix::scale(1.0f + unit(generator), 1.0f + unit(generator), 1.0f);
+
+        //A perspective camera times an affine transform fills every element
+        generalMatrices[i] = Matrix::cameraProjection(30.0f + 60.0f * unit(generator), 1.0f + unit(generator), 0.1f, 500.0f) *
+                             affineMatrices[i];
+        vectors[i] = Vector4(position(generator), position(generator), position(generator), unit(generator));
+    }
+
+    std::vector<ParityResult> results;
+    std::vector<Matrix>  matrixOut(PARITY_POOL_SIZE);
+    std::vector<Vector4> vectorOut(PARITY_POOL_SIZE);
+    size_t last = PARITY_POOL_SIZE - 1;
+
+    //Matrix
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = generalMatrices[i] * generalMatrices[(i + 1) & last];
+    }
+    _addMatrices(results, "matrix/multiplyGeneral", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = rigidMatrices[i] * affineMatrices[(i + 1) & last];
+    }
+    _addMatrices(results, "matrix/multiplyAffine", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = generalMatrices[i].transpose();
+    }
+    _addMatrices(results, "matrix/transpose", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = generalMatrices[i].inverse();
+    }
+    _addMatrices(results, "matrix/inverseGeneral", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = affineMatrices[i].inverseAffine();
+    }
+    _addMatrices(results, "matrix/inverseAffine", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = rigidMatrices[i].inverseRigid();
+    }
+    _addMatrices(results, "matrix/inverseRigid", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        matrixOut[i] = affineMatrices[i].normalMatrix();
+    }
+    _addMatrices(results, "matrix/normalMatrix", matrixOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        vectorOut[i] = generalMatrices[i] * vectors[(i + 1) & last];
+    }
+    _addVectors(results, "matrix/multiplyVector", vectorOut);
+
+    //Vector4
+    ParityResult scalars = { "vector/dotProductMagnitude", std::vector<float>() };
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        scalars.values.push_back(vectors[i].dotProduct(vectors[(i + 1) & last]));
+        scalars.values.push_back(vectors[i].getMagnitude());
+    }
+    results.push_back(scalars);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        vectorOut[i] = vectors[i].crossProduct(vectors[(i + 1) & last]);
+    }
+    _addVectors(results, "vector/crossProduct", vectorOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        vectorOut[i] = vectors[i];
+        vectorOut[i].normalize();
+    }
+    _addVectors(results, "vector/normalize", vectorOut);
+    for (size_t i = 0; i < PARITY_POOL_SIZE; i++) {
+        vectorOut[i] = (vectors[i] + vectors[(i + 1) & last]) * 0.5f - vectors[(i + 2) & last] / 3.0f;
+    }
+    _addVectors(results, "vector/arithmetic", vectorOut);
+
+    //BatchMath
+    std::vector<Vector4> batchIn(PARITY_BATCH_SIZE);
+    std::vector<Vector4> batchOut(PARITY_BATCH_SIZE);
+    std::vector<Matrix>  batchMatricesIn(PARITY_BATCH_SIZE);
+    std::vector<Matrix>  batchMatricesOut(PARITY_BATCH_SIZE);
+    for (size_t i = 0; i < PARITY_BATCH_SIZE; i++) {
+        batchIn[i] = vectors[i & last];
+        batchMatricesIn[i] = generalMatrices[i & last];
+    }
+    BatchMath::transform(generalMatrices[0], batchIn.data(), batchOut.data(), PARITY_BATCH_SIZE);
+    _addVectors(results, "batch/transform", batchOut);
+    BatchMath::transformPoints(generalMatrices[1], batchIn.data(), batchOut.data(), PARITY_BATCH_SIZE);
+    _addVectors(results, "batch/transformPoints", batchOut);
+    BatchMath::transformDirections(generalMatrices[2], batchIn.data(), batchOut.data(), PARITY_BATCH_SIZE);
+    _addVectors(results, "batch/transformDirections", batchOut);
+    BatchMath::multiply(batchMatricesIn.data(), batchMatricesIn.data(), batchMatricesOut.data(), PARITY_BATCH_SIZE);
+    _addMatrices(results, "batch/multiplyEach", batchMatricesOut);
+    BatchMath::multiply(affineMatrices[0], batchMatricesIn.data(), batchMatricesOut.data(), PARITY_BATCH_SIZE);
+    _addMatrices(results, "batch/multiplyLeft", batchMatricesOut);
+    BatchMath::multiply(batchMatricesIn.data(), affineMatrices[1], batchMatricesOut.data(), PARITY_BATCH_SIZE);
+    _addMatrices(results, "batch/multiplyRight", batchMatricesOut);
+
+    return results;
+}
+
+static bool _write(const char* fileName, const std::vector<ParityResult>& results) {
+
+    FILE* file = fopen(fileName, "wb");
+    if (file == nullptr) {
+        printf("Could not open %s\n", fileName);
+        return false;
+    }
+    for (const ParityResult& result : results) {
+        uint64_t nameLength = result.name.size();
+        uint64_t count = result.values.size();
+        fwrite(&nameLength, sizeof(nameLength), 1, file);
+        fwrite(result.name.data(), 1, result.name.size(), file);
+        fwrite(&count, sizeof(count), 1, file);
+        fwrite(result.values.data(), sizeof(float), result.values.size(), file);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool _read(const char* fileName, std::vector<ParityResult>& results) {
+
+    FILE* file = fopen(fileName, "rb");
+    if (file == nullptr) {
+        printf("Could not open %s\n", fileName);
+        return false;
+    }
+    uint64_t nameLength = 0;
+    while (fread(&nameLength, sizeof(nameLength), 1, file) == 1) {
+        ParityResult result;
+        uint64_t count = 0;
+        result.name.resize(static_cast<size_t>(nameLength));
+        if (fread(&result.name[0], 1, result.name.size(), file) != result.name.size() ||
+            fread(&count, sizeof(count), 1, file) != 1) {
+            break;
+        }
+        result.values.resize(static_cast<size_t>(count));
+        if (fread(result.values.data(), sizeof(float), result.values.size(), file) != result.values.size()) {
+            break;
+        }
+        results.push_back(result);
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv) {
+
+    if (argc != 3 || (strcmp(argv[1], "--write") != 0 && strcmp(argv[1], "--check") != 0)) {
+        _printUsage();
+        return 1;
+    }
+
+    printf("Math path: %s\n", _mathPath());
+    std::vector<ParityResult> results = _computeResults();
+    if (strcmp(argv[1], "--write") == 0) {
+        return _write(argv[2], results) ? 0 : 1;
+    }
+
+    std::vector<ParityResult> reference;
+    if (!_read(argv[2], reference)) {
+        return 1;
+    }
+    if (reference.size() != results.size()) {
+        printf("%s holds %zu results, this build computed %zu\n", argv[2], reference.size(), results.size());
+        return 1;
+    }
+
+    int failures = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        const ParityResult& result = results[i];
+        const ParityResult& expected = reference[i];
+        bool same = result.name == expected.name && result.values.size() == expected.values.size() &&
+                    memcmp(result.values.data(), expected.values.data(), result.values.size() * sizeof(float)) == 0;
+        if (same) {
+            printf("%-30s matches\n", result.name.c_str());
+            continue;
+        }
+        failures++;
+        size_t first = 0;
+        while (first < result.values.size() && first < expected.values.size() &&
+               memcmp(&result.values[first], &expected.values[first], sizeof(float)) == 0) {
+            first++;
+        }
+        if (first < result.values.size() && first < expected.values.size()) {
+            printf("%-30s differs at value %zu, %.9g against %.9g\n", result.name.c_str(), first,
+                   result.values[first], expected.values[first]);
+        }
+        else {
+            printf("%-30s does not line up with %s in the reference\n", result.name.c_str(), expected.name.c_str());
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+#include "Matrix.h"
+#include "TestCheck.h"
+#include <random>
+#include <math.h>
+
+const int   INVERSE_TEST_COUNT     = 256;
+const float INVERSE_TEST_TOLERANCE = 1e-4f; //Relative, the fast paths round differently than the cofactor expansion
+
+static bool _nearEqual(Matrix a, Matrix b) {
+    const float* x = a.getFlatBuffer();
+    const float* y = b.getFlatBuffer();
+    for (int i = 0; i < 16; i++) {
+        float scale = 1.0f + fmaxf(fabsf(x[i]), fabsf(y[i]));
+        if (fabsf(x[i] - y[i]) > INVERSE_TEST_TOLERANCE * scale) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//The same values tagged General always take the full cofactor expansion
+static Matrix _generalInverse(Matrix matrix) {
+    return Matrix(matrix.getFlatBuffer(), MatrixType::General).inverse();
+}
+
+int main() {
+
+    std::mt19937 generator(0x1a7e);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    Matrix identity;
+
+    for (int i = 0; i < INVERSE_TEST_COUNT; i++) {
+        Matrix rotation = Matrix::rotationAroundX(angle(generator)) *
+                          Matrix::rotationAroundY(angle(generator)) *
+                          Matrix::rotationAroundZ(angle(generator));
+        Matrix rigid = Matrix::translation(position(generator), position(generator), position(generator)) * rotation;
+        Matrix affine = rigid * Matrix::scale(scale(generator), scale(generator), scale(generator));
+
+        //Products keep the larger type of their factors
+        TEST_CHECK(rotation.getType() == MatrixType::Orthonormal);
+        TEST_CHECK(rigid.getType() == MatrixType::Rigid);
+        TEST_CHECK(affine.getType() == MatrixType::Affine);
+
+        //Each fast path undoes its matrix and agrees with the general inverse
+        TEST_CHECK(_nearEqual(rotation * rotation.inverseOrthonormal(), identity));
+        TEST_CHECK(_nearEqual(rotation.inverseOrthonormal(), _generalInverse(rotation)));
+        TEST_CHECK(_nearEqual(rigid * rigid.inverseRigid(), identity));
+        TEST_CHECK(_nearEqual(rigid.inverseRigid(), _generalInverse(rigid)));
+        TEST_CHECK(_nearEqual(affine * affine.inverseAffine(), identity));
+        TEST_CHECK(_nearEqual(affine.inverseAffine(), _generalInverse(affine)));
+
+        //inverse picks the path from the type and the result keeps it
+        TEST_CHECK(_nearEqual(rigid.inverse(), rigid.inverseRigid()));
+        TEST_CHECK(_nearEqual(affine.inverse(), affine.inverseAffine()));
+        TEST_CHECK(rigid.inverse().getType() == MatrixType::Rigid);
+        TEST_CHECK(affine.inverse().getType() == MatrixType::Affine);
+
+        //A bottom row other than 0 0 0 1 takes the full expansion, no translation keeps it well conditioned
+        Matrix general = rotation * Matrix::scale(scale(generator), scale(generator), scale(generator));
+        general.getFlatBuffer()[12] = 0.01f * position(generator);
+        general.getFlatBuffer()[13] = 0.01f * position(generator);
+        general.setType(MatrixType::General);
+        TEST_CHECK(_nearEqual(general * general.inverse(), identity));
+
+        //The affine path also inverts any 3x3 with a 0 0 0 1 bottom row
+        TEST_CHECK(_nearEqual(Matrix(affine.getFlatBuffer(), MatrixType::General).inverseAffine(), _generalInverse(affine)));
+
+        //Normals take the inverse transpose, a rotation is its own
+        TEST_CHECK(_nearEqual(affine.normalMatrix(), _generalInverse(affine).transpose()));
+        TEST_CHECK(_nearEqual(rotation.normalMatrix(), rotation));
+    }
+
+    return testResult();
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "OcclusionBuffer.h"
+#include "Frustum.h"
+#include "TestCheck.h"
+#include <vector>
+
+//A wall facing the camera, the boxes are placed around it in pixels so the edge cases land exactly
+const float WALL_DISTANCE = 10.0f;
+const float WALL_HALF_WIDTH = 5.0f;
+const float WALL_BOTTOM = -5.0f;
+const float WALL_EDGE_ROW = 133.7f; //Pixel row of the wall's top edge, past the row's center
+const float BOX_DISTANCE = 20.0f;
+
+//Height at a view depth that projects onto a pixel row
+static float _heightAtRow(float row, float distance, float yScale) {
+    return (row / (0.5f * static_cast<float>(OCCLUSION_HEIGHT)) - 1.0f) / yScale * distance;
+}
+
+static Matrix _box(float x, float y, float z, float halfSize) {
+    return Matrix::translation(x, y, z) * Matrix::scale(halfSize);
+}
+
+int main() {
+
+    Matrix projection = Matrix::cameraProjection(45.0f, 1.78f, 0.1f, 200.0f);
+    float yScale = projection.getFlatBuffer()[5];
+    float wallTop = _heightAtRow(WALL_EDGE_ROW, WALL_DISTANCE, yScale);
+
+    OcclusionBuffer occlusionBuffer;
+    occlusionBuffer.clear(projection, Matrix());
+    TEST_CHECK(!occlusionBuffer.isOccluded(_box(0.0f, 0.0f, -BOX_DISTANCE, 1.0f)));
+
+    std::vector<Vector4> wall = { Vector4(-WALL_HALF_WIDTH, WALL_BOTTOM, -WALL_DISTANCE, 1.0f),
+                                  Vector4(WALL_HALF_WIDTH, WALL_BOTTOM, -WALL_DISTANCE, 1.0f),
+                                  Vector4(WALL_HALF_WIDTH, wallTop, -WALL_DISTANCE, 1.0f),
+                                  Vector4(-WALL_HALF_WIDTH, wallTop, -WALL_DISTANCE, 1.0f) };
+    std::vector<int> indices = { 0, 1, 2, 0, 2, 3 };
+    occlusionBuffer.rasterize(Matrix(), wall, indices);
+    TEST_CHECK(occlusionBuffer.hasOccluders());
+
+    //The row the top edge crosses is only partly covered so it must stay empty
+    const float* depth = occlusionBuffer.getDepth();
+    int edgeRow = static_cast<int>(WALL_EDGE_ROW);
+    int centerColumn = OCCLUSION_WIDTH / 2;
+    TEST_CHECK(depth[(edgeRow - 1) * OCCLUSION_WIDTH + centerColumn] > 0.0f);
+    TEST_CHECK(depth[edgeRow * OCCLUSION_WIDTH + centerColumn] == 0.0f);
+
+    //Covered pixels hold the wall's depth, never nearer
+    TEST_CHECK(depth[(edgeRow - 1) * OCCLUSION_WIDTH + centerColumn] <= 1.0f / WALL_DISTANCE);
+
+    //The box's top reaches a tenth of a pixel over the wall's edge at its nearest corner
+    float peekTop = _heightAtRow(WALL_EDGE_ROW + 0.1f, BOX_DISTANCE - 1.0f, yScale);
+
+    std::vector<Matrix> boxes = { _box(0.0f, 0.0f, -BOX_DISTANCE, 1.0f),       //Behind the wall
+                                  _box(0.0f, peekTop - 1.0f, -BOX_DISTANCE, 1.0f), //Peeking over the top edge
+                                  _box(0.0f, 0.0f, -WALL_DISTANCE * 0.5f, 1.0f), //In front of the wall
+                                  _box(12.0f, 0.0f, -BOX_DISTANCE, 1.0f),      //Beside the wall
+                                  _box(0.0f, 0.0f, 0.0f, 1.0f),                //Around the camera
+                                  _box(-2.0f, -2.0f, -BOX_DISTANCE, 0.5f) };   //Behind the wall, past the lane group
+    bool expected[] = { true, false, false, false, false, true };
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+        TEST_CHECK(occlusionBuffer.isOccluded(boxes[i]) == expected[i]);
+    }
+
+    //The batched test only clears bits, and agrees with the single box test
+    std::vector<uint32_t> masks(Frustum::maskWords(boxes.size()), 0xFFFFFFFFu);
+    occlusionBuffer.testOBBs(boxes.data(), boxes.size(), masks.data());
+    for (size_t i = 0; i < boxes.size(); i++) {
+        bool visible = (masks[i / 32] >> (i % 32)) & 1u;
+        TEST_CHECK(visible == !expected[i]);
+    }
+    masks.assign(masks.size(), 0u);
+    occlusionBuffer.testOBBs(boxes.data(), boxes.size(), masks.data());
+    TEST_CHECK(masks[0] == 0u);
+
+    return testResult();
+}
\ No newline at end of file
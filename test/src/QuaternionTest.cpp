@@ -0,0 +1,110 @@
+#include "Quaternion.h"
+#include "DualQuaternion.h"
+#include "TestCheck.h"
+#include <random>
+#include <math.h>
+
+const int   QUATERNION_TEST_COUNT     = 256;
+const float QUATERNION_TEST_TOLERANCE = 1e-4f; //Relative to the larger of the two values
+
+static bool _nearEqual(float a, float b) {
+    return fabsf(a - b) <= QUATERNION_TEST_TOLERANCE * (1.0f + fmaxf(fabsf(a), fabsf(b)));
+}
+
+static bool _nearEqual(Matrix a, Matrix b) {
+    for (int i = 0; i < 16; i++) {
+        if (!_nearEqual(a.getFlatBuffer()[i], b.getFlatBuffer()[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _nearEqual(Vector4 a, Vector4 b) {
+    for (int i = 0; i < 4; i++) {
+        if (!_nearEqual(a.getFlatBuffer()[i], b.getFlatBuffer()[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//q and -q are the same rotation so quaternions are compared through their matrices
+static bool _sameRotation(const Quaternion& a, const Quaternion& b) {
+    return _nearEqual(a.toMatrix(), b.toMatrix());
+}
+
+int main() {
+
+    std::mt19937 generator(0x9a7e);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    //Axis angle rotations turn the same way as the matrix builders
+    for (float degrees = -170.0f; degrees <= 170.0f; degrees += 34.0f) {
+        TEST_CHECK(_nearEqual(Quaternion::fromAxisAngle(Vector4(1.0f, 0.0f, 0.0f, 0.0f), degrees).toMatrix(),
+                              Matrix::rotationAroundX(degrees)));
+        TEST_CHECK(_nearEqual(Quaternion::fromAxisAngle(Vector4(0.0f, 1.0f, 0.0f, 0.0f), degrees).toMatrix(),
+                              Matrix::rotationAroundY(degrees)));
+        TEST_CHECK(_nearEqual(Quaternion::fromAxisAngle(Vector4(0.0f, 0.0f, 1.0f, 0.0f), degrees).toMatrix(),
+                              Matrix::rotationAroundZ(degrees)));
+    }
+
+    //Blends follow the arc between two rotations about one axis
+    Vector4 axis(1.0f, 2.0f, 3.0f, 0.0f);
+    Quaternion start = Quaternion::fromAxisAngle(axis, 10.0f);
+    Quaternion end = Quaternion::fromAxisAngle(axis, 130.0f);
+    TEST_CHECK(_sameRotation(Quaternion::slerp(start, end, 0.0f), start));
+    TEST_CHECK(_sameRotation(Quaternion::slerp(start, end, 1.0f), end));
+    TEST_CHECK(_sameRotation(Quaternion::slerp(start, end, 0.25f), Quaternion::fromAxisAngle(axis, 40.0f)));
+    TEST_CHECK(_sameRotation(Quaternion::nlerp(start, end, 0.5f), Quaternion::fromAxisAngle(axis, 70.0f)));
+    TEST_CHECK(_sameRotation(Quaternion::slerp(start, -end, 0.5f), Quaternion::fromAxisAngle(axis, 70.0f)));
+
+    for (int i = 0; i < QUATERNION_TEST_COUNT; i++) {
+        Matrix rotationA = Matrix::rotationAroundX(angle(generator)) *
+                           Matrix::rotationAroundY(angle(generator)) *
+                           Matrix::rotationAroundZ(angle(generator));
+        Matrix rotationB = Matrix::rotationAroundZ(angle(generator)) * Matrix::rotationAroundX(angle(generator));
+        Matrix translationA = Matrix::translation(position(generator), position(generator), position(generator));
+        Matrix translationB = Matrix::translation(position(generator), position(generator), position(generator));
+        Vector4 point(position(generator), position(generator), position(generator), 1.0f);
+
+        //Quaternion
+        Quaternion a(rotationA);
+        Quaternion b(rotationB);
+        TEST_CHECK(_nearEqual(a.getMagnitude(), 1.0f));
+        TEST_CHECK(_nearEqual(a.toMatrix(), rotationA));
+        TEST_CHECK(_nearEqual((a * b).toMatrix(), rotationA * rotationB));
+        TEST_CHECK(_nearEqual(a.rotate(point), rotationA * point));
+        TEST_CHECK(_sameRotation(a * a.conjugate(), Quaternion()));
+        TEST_CHECK(a.toMatrix().getType() == MatrixType::Orthonormal);
+
+        Quaternion scaled = a * (1.0f + unit(generator));
+        scaled.normalize();
+        TEST_CHECK(_sameRotation(scaled, a));
+
+        //DualQuaternion
+        Matrix rigidA = translationA * rotationA;
+        Matrix rigidB = translationB * rotationB;
+        DualQuaternion dualA(rigidA);
+        DualQuaternion dualB(rigidB);
+        TEST_CHECK(_nearEqual(dualA.toMatrix(), rigidA));
+        TEST_CHECK(dualA.toMatrix().getType() == MatrixType::Rigid);
+        TEST_CHECK(_nearEqual(dualA.transform(point), rigidA * point));
+        TEST_CHECK(_nearEqual(dualA.getTranslation(), translationA * Vector4(0.0f, 0.0f, 0.0f, 1.0f)));
+        TEST_CHECK(_sameRotation(dualA.getRotation(), a));
+        TEST_CHECK(_nearEqual((dualA * dualB).toMatrix(), rigidA * rigidB));
+        TEST_CHECK(_nearEqual((dualA * dualA.conjugate()).toMatrix(), Matrix()));
+
+        DualQuaternion built(a, translationA * Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+        TEST_CHECK(_nearEqual(built.toMatrix(), rigidA));
+
+        //Blending the same transform, or its negated twin, changes nothing
+        DualQuaternion negated(-dualA.getReal(), -dualA.getDual());
+        TEST_CHECK(_nearEqual(DualQuaternion::nlerp(dualA, dualA, 0.5f).toMatrix(), rigidA));
+        TEST_CHECK(_nearEqual(DualQuaternion::nlerp(dualA, negated, 0.5f).toMatrix(), rigidA));
+    }
+
+    return testResult();
+}
\ No newline at end of file